@@ -24,6 +24,7 @@
 #include "dingosdk/document.h"
 #include "dingosdk/metric.h"
 #include "dingosdk/status.h"
+#include "dingosdk/trace.h"
 #include "dingosdk/vector.h"
 
 namespace dingodb {
@@ -49,6 +50,21 @@ class Version;
 void ShowSdkVersion();
 std::vector<std::pair<std::string, std::string>> GetSdkVersion();
 
+/// @brief Bound the sdk calls issued by current thread in the scope, e.g. RawKV, Transaction, VectorClient and
+/// DocumentClient. Timeout of each rpc is clipped to the remaining time and retries stop when it runs out, the call
+/// return Status::TimedOut then. Nested scope can only shorten the deadline.
+class ScopedDeadline {
+ public:
+  explicit ScopedDeadline(int64_t timeout_ms);
+  ~ScopedDeadline();
+
+  ScopedDeadline(const ScopedDeadline&) = delete;
+  const ScopedDeadline& operator=(const ScopedDeadline&) = delete;
+
+ private:
+  int64_t prev_deadline_ms_;
+};
+
 /// @brief Callers must keep client valid in it's lifetime in order to interact with the cluster,
 class Client {
  public:
@@ -140,6 +156,23 @@ class Client {
 
   Status TransferLeaderRegion(int64_t region_id, int64_t leader_store_id, bool is_force);
 
+  // Load all regions between [start_key, end_key) into region cache before requests hit them,
+  // the range is reloaded in background when flag meta_cache_refresh_interval_ms > 0
+  Status WarmupRange(const std::string& start_key, const std::string& end_key);
+
+  // Load vector or document index into index cache and warmup regions of all its partitions
+  Status WarmupIndex(int64_t index_id);
+
+  // Save cached region routes to file, which can be loaded by LoadRegionCache for fast startup
+  Status SaveRegionCache(const std::string& path);
+
+  // Load region routes saved by SaveRegionCache, loaded routes are hints and will be refreshed when stale
+  Status LoadRegionCache(const std::string& path);
+
+  // Snapshot of in-process instrumentation: store rpc latency by method and store, retries by error, in-flight rpc,
+  // region cache and hedge counters. Dumped to log periodically when flag client_metrics_dump_interval_ms > 0
+  Status GetMetrics(ClientMetrics& metrics);
+
  private:
   friend class RawKV;
   friend class TestBase;
@@ -163,6 +196,50 @@ struct KeyOpState {
   bool state;
 };
 
+struct RawKVScanOptions {
+  // only read keys, value of out kvs is empty
+  bool key_only{false};
+};
+
+struct RawKVIteratorOptions {
+  // max bytes of kvs held by iterator, the batch being consumed plus the one prefetched,
+  // next batch is only prefetched when current batch use no more than half of it. 0 means no limit
+  int64_t buffer_bytes{64 * 1024 * 1024};
+  // only read keys, Value() is empty
+  bool key_only{false};
+};
+
+// Forward cursor over a key range of raw kv, batches are fetched region by region and the next batch is prefetched
+// while current one is consumed. Not thread safe.
+class RawKVIterator {
+ public:
+  RawKVIterator(const RawKVIterator&) = delete;
+  const RawKVIterator& operator=(const RawKVIterator&) = delete;
+
+  ~RawKVIterator();
+
+  // false when reach end of range or fail, check GetStatus() then
+  bool Valid() const;
+
+  // may block when next batch is not fetched yet
+  void Next();
+
+  const std::string& Key() const;
+
+  const std::string& Value() const;
+
+  Status GetStatus() const;
+
+ private:
+  friend class RawKV;
+
+  // own
+  class Data;
+  Data* data_;
+
+  explicit RawKVIterator(Data* data);
+};
+
 class RawKV {
  public:
   RawKV(const RawKV&) = delete;
@@ -205,6 +282,34 @@ class RawKV {
   // limit: 0 means no limit, will scan all key in [start_key, end_key)
   Status Scan(const std::string& start_key, const std::string& end_key, uint64_t limit, std::vector<KVPair>& out_kvs);
 
+  Status Scan(const std::string& start_key, const std::string& end_key, uint64_t limit, const RawKVScanOptions& options,
+              std::vector<KVPair>& out_kvs);
+
+  // count key in [start_key, end_key), regions are scanned key only and in parallel
+  Status CountRange(const std::string& start_key, const std::string& end_key, int64_t& out_count);
+
+  // iterate kvs in [start_key, end_key) without loading all of them, return when first batch is fetched
+  Status NewIterator(const std::string& start_key, const std::string& end_key, const RawKVIteratorOptions& options,
+                     RawKVIterator** out_iterator);
+
+  // Async variants of above, they return at once and call cb when done, see StatusCallback.
+  // Inputs are taken by value, move them in to avoid copy. Output buffers are owned by caller and must stay valid
+  // until cb is called. RawKV can be deleted before cb, client can not.
+  void AsyncGet(std::string key, std::string& out_value, StatusCallback cb);
+
+  void AsyncBatchGet(std::vector<std::string> keys, std::vector<KVPair>& out_kvs, StatusCallback cb);
+
+  void AsyncPut(std::string key, std::string value, StatusCallback cb);
+
+  void AsyncBatchPut(std::vector<KVPair> kvs, StatusCallback cb);
+
+  void AsyncDelete(std::string key, StatusCallback cb);
+
+  void AsyncBatchDelete(std::vector<std::string> keys, StatusCallback cb);
+
+  void AsyncScan(std::string start_key, std::string end_key, uint64_t limit, std::vector<KVPair>& out_kvs,
+                 StatusCallback cb);
+
  private:
   friend class Client;
 
@@ -260,6 +365,16 @@ class Transaction {
 
   Status Rollback();
 
+  // Async variants of above, same rules as RawKV async api, and transaction must stay valid until cb.
+  // NOTE: commit and rollback phases are chained on rpc callbacks, cb may run in sdk rpc or txn thread.
+  void AsyncGet(std::string key, std::string& value, StatusCallback cb);
+
+  void AsyncBatchGet(std::vector<std::string> keys, std::vector<KVPair>& kvs, StatusCallback cb);
+
+  void AsyncCommit(StatusCallback cb);
+
+  void AsyncRollback(StatusCallback cb);
+
   bool IsOnePc() const;
 
   bool IsAsyncCommit() const;
@@ -0,0 +1,257 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_CORO_H_
+#define DINGODB_SDK_CORO_H_
+
+// C++20 co_await facade over the async api, header only, link target sdk_coro to use it. e.g.
+//   auto [status, value] = co_await coro::Get(raw_kv, key);
+//   Status status = co_await coro::Commit(txn);
+//
+// The coroutine is resumed in the sdk thread which complete the call(bthread worker when build with brpc), or at
+// once when the call complete before suspend. So never block after co_await, hop to your own executor if needed.
+// Awaiter and output live in the coroutine frame, no extra allocation is made beyond what the async api does.
+
+#if __cplusplus < 202002L && (!defined(_MSVC_LANG) || _MSVC_LANG < 202002L)
+#error "dingosdk/coro.h requires C++20"
+#endif
+
+#include <atomic>
+#include <coroutine>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "dingosdk/client.h"
+#include "dingosdk/document.h"
+#include "dingosdk/status.h"
+#include "dingosdk/vector.h"
+
+namespace dingodb {
+namespace sdk {
+namespace coro {
+
+template <class T>
+struct Result {
+  Status status;
+  T value;
+};
+
+// Start is called once as start(out, cb) with out of type T&, or start(cb) when T is void.
+template <class T, class Start>
+class Awaiter {
+ public:
+  explicit Awaiter(Start start) : start_(std::move(start)) {}
+
+  Awaiter(const Awaiter&) = delete;
+  Awaiter& operator=(const Awaiter&) = delete;
+
+  bool await_ready() const noexcept { return false; }
+
+  bool await_suspend(std::coroutine_handle<> handle) {
+    handle_ = handle;
+    // callback only capture this, so it fit in small buffer of std::function and never allocate
+    StatusCallback cb = [this](Status status) {
+      result_.status = std::move(status);
+      // the side which come second resume, so a call complete before suspend does not resume twice
+      if (done_.exchange(true, std::memory_order_acq_rel)) {
+        handle_.resume();
+      }
+    };
+
+    if constexpr (std::is_void_v<T>) {
+      start_(std::move(cb));
+    } else {
+      start_(result_.value, std::move(cb));
+    }
+
+    return !done_.exchange(true, std::memory_order_acq_rel);
+  }
+
+  auto await_resume() {
+    if constexpr (std::is_void_v<T>) {
+      return std::move(result_.status);
+    } else {
+      return std::move(result_);
+    }
+  }
+
+ private:
+  struct VoidResult {
+    Status status;
+  };
+
+  Start start_;
+  std::conditional_t<std::is_void_v<T>, VoidResult, Result<T>> result_;
+  std::coroutine_handle<> handle_;
+  std::atomic<bool> done_{false};
+};
+
+// await any async call, e.g. co_await coro::Await([&](StatusCallback cb) { client.AsyncXxx(..., std::move(cb)); })
+// gcc 12 destroy a lambda written inside co_await twice, declare it before co_await when it capture by value.
+template <class Start>
+Awaiter<void, Start> Await(Start start) {
+  return Awaiter<void, Start>(std::move(start));
+}
+
+// await any async call with output, e.g. co_await coro::Await<int64_t>([&](int64_t& out, StatusCallback cb) { ... })
+template <class T, class Start>
+Awaiter<T, Start> Await(Start start) {
+  return Awaiter<T, Start>(std::move(start));
+}
+
+// RawKV
+
+inline auto Get(RawKV& raw_kv, std::string key) {
+  return Await<std::string>([&raw_kv, key = std::move(key)](std::string& out, StatusCallback cb) mutable {
+    raw_kv.AsyncGet(std::move(key), out, std::move(cb));
+  });
+}
+
+inline auto BatchGet(RawKV& raw_kv, std::vector<std::string> keys) {
+  return Await<std::vector<KVPair>>(
+      [&raw_kv, keys = std::move(keys)](std::vector<KVPair>& out, StatusCallback cb) mutable {
+        raw_kv.AsyncBatchGet(std::move(keys), out, std::move(cb));
+      });
+}
+
+inline auto Put(RawKV& raw_kv, std::string key, std::string value) {
+  return Await([&raw_kv, key = std::move(key), value = std::move(value)](StatusCallback cb) mutable {
+    raw_kv.AsyncPut(std::move(key), std::move(value), std::move(cb));
+  });
+}
+
+inline auto BatchPut(RawKV& raw_kv, std::vector<KVPair> kvs) {
+  return Await([&raw_kv, kvs = std::move(kvs)](StatusCallback cb) mutable {
+    raw_kv.AsyncBatchPut(std::move(kvs), std::move(cb));
+  });
+}
+
+inline auto Delete(RawKV& raw_kv, std::string key) {
+  return Await([&raw_kv, key = std::move(key)](StatusCallback cb) mutable {
+    raw_kv.AsyncDelete(std::move(key), std::move(cb));
+  });
+}
+
+inline auto BatchDelete(RawKV& raw_kv, std::vector<std::string> keys) {
+  return Await([&raw_kv, keys = std::move(keys)](StatusCallback cb) mutable {
+    raw_kv.AsyncBatchDelete(std::move(keys), std::move(cb));
+  });
+}
+
+inline auto Scan(RawKV& raw_kv, std::string start_key, std::string end_key, uint64_t limit) {
+  return Await<std::vector<KVPair>>([&raw_kv, start_key = std::move(start_key), end_key = std::move(end_key), limit](
+                                        std::vector<KVPair>& out, StatusCallback cb) mutable {
+    raw_kv.AsyncScan(std::move(start_key), std::move(end_key), limit, out, std::move(cb));
+  });
+}
+
+// Transaction
+
+inline auto Get(Transaction& txn, std::string key) {
+  return Await<std::string>([&txn, key = std::move(key)](std::string& out, StatusCallback cb) mutable {
+    txn.AsyncGet(std::move(key), out, std::move(cb));
+  });
+}
+
+inline auto BatchGet(Transaction& txn, std::vector<std::string> keys) {
+  return Await<std::vector<KVPair>>([&txn, keys = std::move(keys)](std::vector<KVPair>& out, StatusCallback cb) mutable {
+    txn.AsyncBatchGet(std::move(keys), out, std::move(cb));
+  });
+}
+
+inline auto Commit(Transaction& txn) {
+  return Await([&txn](StatusCallback cb) { txn.AsyncCommit(std::move(cb)); });
+}
+
+inline auto Rollback(Transaction& txn) {
+  return Await([&txn](StatusCallback cb) { txn.AsyncRollback(std::move(cb)); });
+}
+
+// VectorClient
+
+inline auto SearchByIndexId(VectorClient& client, int64_t index_id, SearchParam search_param,
+                            std::vector<VectorWithId> target_vectors) {
+  return Await<std::vector<SearchResult>>(
+      [&client, index_id, search_param = std::move(search_param), target_vectors = std::move(target_vectors)](
+          std::vector<SearchResult>& out, StatusCallback cb) mutable {
+        client.AsyncSearchByIndexId(index_id, std::move(search_param), std::move(target_vectors), out, std::move(cb));
+      });
+}
+
+// vectors get ids assigned, so it must stay valid until resumed
+inline auto AddByIndexId(VectorClient& client, int64_t index_id, std::vector<VectorWithId>& vectors) {
+  return Await([&client, index_id, &vectors](StatusCallback cb) {
+    client.AsyncAddByIndexId(index_id, vectors, std::move(cb));
+  });
+}
+
+inline auto UpsertByIndexId(VectorClient& client, int64_t index_id, std::vector<VectorWithId>& vectors) {
+  return Await([&client, index_id, &vectors](StatusCallback cb) {
+    client.AsyncUpsertByIndexId(index_id, vectors, std::move(cb));
+  });
+}
+
+inline auto DeleteByIndexId(VectorClient& client, int64_t index_id, std::vector<int64_t> vector_ids) {
+  return Await<std::vector<DeleteResult>>(
+      [&client, index_id, vector_ids = std::move(vector_ids)](std::vector<DeleteResult>& out,
+                                                              StatusCallback cb) mutable {
+        client.AsyncDeleteByIndexId(index_id, std::move(vector_ids), out, std::move(cb));
+      });
+}
+
+inline auto BatchQueryByIndexId(VectorClient& client, int64_t index_id, QueryParam query_param) {
+  return Await<QueryResult>(
+      [&client, index_id, query_param = std::move(query_param)](QueryResult& out, StatusCallback cb) mutable {
+        client.AsyncBatchQueryByIndexId(index_id, std::move(query_param), out, std::move(cb));
+      });
+}
+
+// DocumentClient
+
+// docs get ids assigned, so it must stay valid until resumed
+inline auto AddByIndexId(DocumentClient& client, int64_t index_id, std::vector<DocWithId>& docs) {
+  return Await([&client, index_id, &docs](StatusCallback cb) {
+    client.AsyncAddByIndexId(index_id, docs, std::move(cb));
+  });
+}
+
+inline auto SearchByIndexId(DocumentClient& client, int64_t index_id, DocSearchParam search_param) {
+  return Await<DocSearchResult>(
+      [&client, index_id, search_param = std::move(search_param)](DocSearchResult& out, StatusCallback cb) mutable {
+        client.AsyncSearchByIndexId(index_id, std::move(search_param), out, std::move(cb));
+      });
+}
+
+inline auto DeleteByIndexId(DocumentClient& client, int64_t index_id, std::vector<int64_t> doc_ids) {
+  return Await<std::vector<DocDeleteResult>>(
+      [&client, index_id, doc_ids = std::move(doc_ids)](std::vector<DocDeleteResult>& out, StatusCallback cb) mutable {
+        client.AsyncDeleteByIndexId(index_id, std::move(doc_ids), out, std::move(cb));
+      });
+}
+
+inline auto BatchQueryByIndexId(DocumentClient& client, int64_t index_id, DocQueryParam query_param) {
+  return Await<DocQueryResult>(
+      [&client, index_id, query_param = std::move(query_param)](DocQueryResult& out, StatusCallback cb) mutable {
+        client.AsyncBatchQueryByIndexId(index_id, std::move(query_param), out, std::move(cb));
+      });
+}
+
+}  // namespace coro
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_CORO_H_
@@ -244,6 +244,19 @@ class DocumentClient {
   Status BatchQueryByIndexName(int64_t schema_id, const std::string& index_name, const DocQueryParam& query_param,
                                DocQueryResult& out_result);
 
+  // Async variants, they return at once and call cb when done, see StatusCallback. Inputs are taken by value, move
+  // them in to avoid copy. Docs of add and output buffers are owned by caller and must stay valid until cb.
+  void AsyncAddByIndexId(int64_t index_id, std::vector<DocWithId>& docs, StatusCallback cb);
+
+  void AsyncSearchByIndexId(int64_t index_id, DocSearchParam search_param, DocSearchResult& out_result,
+                            StatusCallback cb);
+
+  void AsyncDeleteByIndexId(int64_t index_id, std::vector<int64_t> doc_ids, std::vector<DocDeleteResult>& out_result,
+                            StatusCallback cb);
+
+  void AsyncBatchQueryByIndexId(int64_t index_id, DocQueryParam query_param, DocQueryResult& out_result,
+                                StatusCallback cb);
+
   Status GetBorderByIndexId(int64_t index_id, bool is_max, int64_t& out_doc_id);
   Status GetBorderByIndexName(int64_t schema_id, const std::string& index_name, bool is_max, int64_t& out_doc_id);
 
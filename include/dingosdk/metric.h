@@ -17,7 +17,10 @@
 
 #include <cstdint>
 #include <iostream>
+#include <map>
 #include <sstream>
+#include <string>
+#include <vector>
 
 namespace dingodb {
 
@@ -86,6 +89,70 @@ struct StorePB {
   StoreInState in_state{kStoreOut};  // store in state
 };
 
+// latency distribution in microseconds, percentiles have relative error below 1/8
+struct LatencyMetrics {
+  int64_t count{0};
+  int64_t avg_us{0};
+  int64_t max_us{0};
+  int64_t p50_us{0};
+  int64_t p90_us{0};
+  int64_t p99_us{0};
+  int64_t p999_us{0};
+
+  std::string ToString() const {
+    std::ostringstream oss;
+    oss << "count: " << count << ", avg_us: " << avg_us << ", p50_us: " << p50_us << ", p90_us: " << p90_us
+        << ", p99_us: " << p99_us << ", p999_us: " << p999_us << ", max_us: " << max_us;
+    return oss.str();
+  }
+};
+
+// store rpc of one method sent to one store
+struct RpcLatencyMetrics {
+  std::string method;      // e.g. StoreService.KvGetRpc
+  std::string end_point;   // host:port of store
+  int64_t error_count{0};  // rpc fail, e.g. timeout or connection fail
+  LatencyMetrics latency;
+};
+
+// snapshot of sdk in-process instrumentation, see Client::GetMetrics
+struct ClientMetrics {
+  std::vector<RpcLatencyMetrics> rpcs;
+  // store rpc retried by controller, key is error name, e.g. ERAFT_NOTLEADER
+  std::map<std::string, int64_t> retry_counts;
+  int64_t inflight_rpc{0};
+
+  // region lookups of meta cache
+  int64_t meta_cache_hit{0};
+  int64_t meta_cache_miss{0};
+  // miss waited on other in-flight coordinator rpc
+  int64_t meta_cache_coalesced{0};
+  int64_t meta_cache_rpc{0};
+
+  // hedged replica read
+  int64_t hedge_requests{0};
+  int64_t hedged{0};
+  int64_t hedge_won{0};
+
+  std::string ToString() const {
+    std::ostringstream oss;
+    oss << "ClientMetrics: {inflight_rpc: " << inflight_rpc << ", meta_cache_hit: " << meta_cache_hit
+        << ", meta_cache_miss: " << meta_cache_miss << ", meta_cache_coalesced: " << meta_cache_coalesced
+        << ", meta_cache_rpc: " << meta_cache_rpc << ", hedge_requests: " << hedge_requests << ", hedged: " << hedged
+        << ", hedge_won: " << hedge_won << ", retry_counts: {";
+    for (const auto& [error, count] : retry_counts) {
+      oss << error << ": " << count << ", ";
+    }
+    oss << "}, rpcs: [";
+    for (const auto& rpc : rpcs) {
+      oss << "{method: " << rpc.method << ", end_point: " << rpc.end_point << ", error_count: " << rpc.error_count
+          << ", " << rpc.latency.ToString() << "}, ";
+    }
+    oss << "]}";
+    return oss.str();
+  }
+};
+
 }  // namespace sdk
 }  // namespace dingodb
 
@@ -14,6 +14,8 @@
 #define DINGODB_SDK_STATUS_H_
 
 #include <cstdint>
+#include <functional>
+#include <future>
 #include <memory>
 #include <string>
 #include <utility>
@@ -164,6 +166,20 @@ inline Status& Status::operator=(Status&& rhs) noexcept {
   return *this;
 }
 
+/// @brief Callback of async api, called once with the final status.
+/// It may run in sdk thread or before the async call return, never block in it.
+using StatusCallback = std::function<void(Status)>;
+
+/// @brief Adapt an async call to std::future, e.g.
+///   std::future<Status> f = AsyncToFuture([&](StatusCallback cb) { raw_kv->AsyncGet(key, value, std::move(cb)); });
+template <class AsyncCall>
+std::future<Status> AsyncToFuture(AsyncCall&& async_call) {
+  auto promise = std::make_shared<std::promise<Status>>();
+  std::future<Status> future = promise->get_future();
+  std::forward<AsyncCall>(async_call)([promise](Status status) { promise->set_value(std::move(status)); });
+  return future;
+}
+
 }  // namespace sdk
 }  // namespace dingodb
 
@@ -0,0 +1,54 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_TRACE_H_
+#define DINGODB_SDK_TRACE_H_
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace dingodb {
+namespace sdk {
+
+// One timed step of a sdk call, e.g. a task, a backoff, a region lookup or one rpc attempt.
+// Tracing is enabled by flag enable_trace, spans of a call whose root span is slower than flag trace_slow_threshold_ms
+// are exported to the sink and appended to flag trace_slow_file as one json line.
+struct TraceSpan {
+  uint64_t trace_id{0};
+  uint64_t span_id{0};
+  uint64_t parent_id{0};  // 0 for root span
+  std::string name;
+  int64_t start_us{0};  // wall clock
+  int64_t duration_us{0};
+  int64_t log_id{0};  // log id of rpc attempt, 0 for other span
+  int64_t region_id{0};
+  std::string end_point;
+  bool ok{true};
+  int32_t errcode{0};
+};
+
+// spans of one slow call, ordered by start time
+using TraceSink = std::function<void(const std::vector<TraceSpan>& spans)>;
+
+// replace the sink, empty sink means no callback
+void SetTraceSink(TraceSink sink);
+
+std::string TraceSpansToJson(const std::vector<TraceSpan>& spans);
+
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_TRACE_H_
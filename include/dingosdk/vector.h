@@ -611,6 +611,20 @@ class VectorClient {
   Status BatchQueryByIndexName(int64_t schema_id, const std::string& index_name, const QueryParam& query_param,
                                QueryResult& out_result);
 
+  // Async variants, they return at once and call cb when done, see StatusCallback. Inputs are taken by value, move
+  // them in to avoid copy. Vectors of add/upsert and output buffers are owned by caller and must stay valid until cb.
+  void AsyncAddByIndexId(int64_t index_id, std::vector<VectorWithId>& vectors, StatusCallback cb);
+
+  void AsyncUpsertByIndexId(int64_t index_id, std::vector<VectorWithId>& vectors, StatusCallback cb);
+
+  void AsyncSearchByIndexId(int64_t index_id, SearchParam search_param, std::vector<VectorWithId> target_vectors,
+                            std::vector<SearchResult>& out_result, StatusCallback cb);
+
+  void AsyncDeleteByIndexId(int64_t index_id, std::vector<int64_t> vector_ids, std::vector<DeleteResult>& out_result,
+                            StatusCallback cb);
+
+  void AsyncBatchQueryByIndexId(int64_t index_id, QueryParam query_param, QueryResult& out_result, StatusCallback cb);
+
   Status GetBorderByIndexId(int64_t index_id, bool is_max, int64_t& out_vector_id);
   Status GetBorderByIndexName(int64_t schema_id, const std::string& index_name, bool is_max, int64_t& out_vector_id);
 
@@ -149,6 +149,10 @@ void DefineClientBindings(pybind11::module& m) {
       .def_readwrite("key", &KeyOpState::key)
       .def_readwrite("state", &KeyOpState::state);
 
+  py::class_<RawKVScanOptions>(m, "RawKVScanOptions")
+      .def(py::init<>())
+      .def_readwrite("key_only", &RawKVScanOptions::key_only);
+
   py::class_<RawKV>(m, "RawKV")
       .def("Get",
            [](RawKV& rawkv, const std::string& key) {
@@ -206,6 +210,18 @@ void DefineClientBindings(pybind11::module& m) {
         std::vector<KVPair> out_kvs;
         Status status = rawkv.Scan(start_key, end_key, limit, out_kvs);
         return std::make_tuple(status, out_kvs);
+      })
+      .def("Scan",
+           [](RawKV& rawkv, const std::string& start_key, const std::string& end_key, uint64_t limit,
+              const RawKVScanOptions& options) {
+             std::vector<KVPair> out_kvs;
+             Status status = rawkv.Scan(start_key, end_key, limit, options, out_kvs);
+             return std::make_tuple(status, out_kvs);
+           })
+      .def("CountRange", [](RawKV& rawkv, const std::string& start_key, const std::string& end_key) {
+        int64_t out_count = 0;
+        Status status = rawkv.CountRange(start_key, end_key, out_count);
+        return std::make_tuple(status, out_count);
       });
 
   py::enum_<TransactionKind>(m, "TransactionKind")
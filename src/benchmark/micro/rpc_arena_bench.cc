@@ -0,0 +1,110 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Micro benchmark for protobuf arena in UnaryRpc, no cluster needed.
+// Parse a serialized VectorSearchResponse into VectorSearchRpc repeatedly,
+// and report heap allocations and time per rpc with and without arena.
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+
+#include "fmt/core.h"
+#include "gflags/gflags.h"
+#include "proto/common.pb.h"
+#include "proto/index.pb.h"
+#include "sdk/common/param_config.h"
+#include "sdk/rpc/index_service_rpc.h"
+
+DEFINE_int64(rpc_count, 10000, "rpc count of each round");
+DEFINE_int64(topn, 200, "vector with distance count in response");
+DEFINE_int64(dimension, 128, "vector dimension");
+
+static std::atomic<int64_t> g_alloc_count{0};
+
+void* operator new(size_t size) {
+  g_alloc_count.fetch_add(1, std::memory_order_relaxed);
+  void* ptr = std::malloc(size);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+
+static std::string BuildResponse() {
+  dingodb::pb::index::VectorSearchResponse response;
+  auto* batch_result = response.add_batch_results();
+  for (int64_t i = 0; i < FLAGS_topn; ++i) {
+    auto* vector_with_distance = batch_result->add_vector_with_distances();
+    vector_with_distance->set_distance(i * 0.1);
+    auto* vector_with_id = vector_with_distance->mutable_vector_with_id();
+    vector_with_id->set_id(i);
+    auto* vector = vector_with_id->mutable_vector();
+    vector->set_dimension(FLAGS_dimension);
+    for (int64_t d = 0; d < FLAGS_dimension; ++d) {
+      vector->add_float_values(d * 0.01);
+    }
+  }
+
+  return response.SerializeAsString();
+}
+
+static void RunRound(const std::string& name, bool enable_arena, const std::string& data) {
+  FLAGS_rpc_enable_arena = enable_arena;
+
+  int64_t start_alloc = g_alloc_count.load();
+  auto start = std::chrono::steady_clock::now();
+  for (int64_t i = 0; i < FLAGS_rpc_count; ++i) {
+    dingodb::sdk::VectorSearchRpc rpc;
+    rpc.MutableRequest()->add_vector_with_ids()->set_id(i);
+    // first try and one retry, as StoreRpcController does on not leader
+    rpc.MutableResponse()->ParseFromString(data);
+    rpc.MutableResponse()->Clear();
+    rpc.MutableResponse()->ParseFromString(data);
+    // as OnRpcDone does
+    rpc.UpdateArenaSizeHint();
+  }
+  auto elapse_us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+  int64_t alloc_count = g_alloc_count.load() - start_alloc;
+
+  std::cout << fmt::format("{:<8} allocs/rpc: {:>10.1f} time/rpc: {:>10.2f}us", name,
+                           static_cast<double>(alloc_count) / FLAGS_rpc_count,
+                           static_cast<double>(elapse_us.count()) / FLAGS_rpc_count)
+            << '\n';
+}
+
+int main(int argc, char* argv[]) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+
+  std::string data = BuildResponse();
+  std::cout << fmt::format("response size: {} bytes, topn: {}, dimension: {}", data.size(), FLAGS_topn,
+                           FLAGS_dimension)
+            << '\n';
+
+  // warm up malloc and caches, and learn the arena size hint so arena round start with the learned block size
+  RunRound("warmup", true, data);
+
+  RunRound("heap", false, data);
+  RunRound("arena", true, data);
+
+  return 0;
+}
@@ -0,0 +1,132 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Micro benchmark for client cpu of rpc done path, no cluster needed.
+// "legacy" replay the bookkeeping UnaryRpc::OnRpcDone did before: wall clock, method name and trace string built
+// for every rpc. "current" run the real OnRpcDone and RpcMetrics::OnRpcDone of a fast rpc, legacy round skip the
+// metrics, so the gap is a lower bound.
+// Report heap allocations and time per rpc.
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+
+#include "butil/endpoint.h"
+#include "fmt/core.h"
+#include "gflags/gflags.h"
+#include "proto/store.pb.h"
+#include "sdk/common/common.h"
+#include "sdk/common/param_config.h"
+#include "sdk/rpc/brpc/unary_rpc.h"
+#include "sdk/rpc/rpc_metrics.h"
+#include "sdk/rpc/store_rpc.h"
+
+DEFINE_int64(rpc_count, 1000000, "rpc count of each round");
+
+static std::atomic<int64_t> g_alloc_count{0};
+
+void* operator new(size_t size) {
+  g_alloc_count.fetch_add(1, std::memory_order_relaxed);
+  void* ptr = std::malloc(size);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+
+namespace dingodb {
+namespace sdk {
+
+// expose the done path of UnaryRpc without sending anything
+class BenchKvGetRpc final : public UnaryRpc<pb::store::KvGetRequest, pb::store::KvGetResponse, pb::store::StoreService,
+                                            pb::store::StoreService_Stub> {
+ public:
+  BenchKvGetRpc() : UnaryRpc("") {}
+
+  const char* Method() const override { return KvGetRpc::ConstMethod(); }
+
+  void Send(pb::store::StoreService_Stub& stub, google::protobuf::Closure* done) override {}
+
+  void Done() {
+    start_time = MonotonicUs();
+    brpc_ctx.cb = [] {};
+    OnRpcDone();
+  }
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+
+static int64_t WallClockUs() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+static void LegacyRpcDone(const butil::EndPoint& remote_side, uint64_t log_id, const dingodb::sdk::Status& status,
+                          int64_t start_time) {
+  int64_t end_time = WallClockUs();
+  std::string str = fmt::format("request_id: {}, status: {}", log_id, status.ToString());
+  std::string method = fmt::format("{}.{}Rpc", dingodb::pb::store::StoreService::descriptor()->name(), "KvGet");
+  std::string endpoint = butil::endpoint2str(remote_side).c_str();
+  if (FLAGS_enable_trace_rpc_performance && end_time - start_time > FLAGS_rpc_elapse_time_threshold_us) {
+    std::cout << method << endpoint << str << '\n';
+  }
+}
+
+static void RunRound(const std::string& name, bool legacy) {
+  dingodb::sdk::BenchKvGetRpc rpc;
+  dingodb::sdk::RpcMetrics metrics;
+  dingodb::sdk::EndPoint end_point("127.0.0.1", 20001);
+  butil::EndPoint remote_side;
+  butil::str2endpoint("127.0.0.1:20001", &remote_side);
+
+  int64_t start_alloc = g_alloc_count.load();
+  auto start = std::chrono::steady_clock::now();
+  for (int64_t i = 0; i < FLAGS_rpc_count; ++i) {
+    if (legacy) {
+      LegacyRpcDone(remote_side, rpc.LogId(), rpc.GetStatus(), WallClockUs());
+    } else {
+      metrics.OnRpcStart();
+      rpc.Done();
+      metrics.OnRpcDone(rpc.Method(), end_point, rpc.GetElapseTimeUs(), true);
+    }
+  }
+  auto elapse_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+  int64_t alloc_count = g_alloc_count.load() - start_alloc;
+
+  std::cout << fmt::format("{:<8} allocs/rpc: {:>8.2f} time/rpc: {:>10.1f}ns", name,
+                           static_cast<double>(alloc_count) / FLAGS_rpc_count,
+                           static_cast<double>(elapse_ns.count()) / FLAGS_rpc_count)
+            << '\n';
+}
+
+int main(int argc, char* argv[]) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+
+  // warm up method name and metrics entry
+  RunRound("warmup", false);
+
+  RunRound("legacy", true);
+  RunRound("current", false);
+
+  return 0;
+}
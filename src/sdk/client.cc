@@ -32,13 +32,17 @@
 #include "glog/logging.h"
 #include "proto/common.pb.h"
 #include "proto/coordinator.pb.h"
+#include "proto/meta.pb.h"
 #include "sdk/client_internal_data.h"
 #include "sdk/client_stub.h"
+#include "sdk/common/deadline.h"
 #include "sdk/common/helper.h"
 #include "sdk/common/param_config.h"
 #include "sdk/document/document_index.h"
 #include "sdk/document/document_index_cache.h"
 #include "sdk/document/document_index_creator_internal_data.h"
+#include "sdk/meta_cache.h"
+#include "sdk/rawkv/raw_kv_auto_batcher.h"
 #include "sdk/rawkv/raw_kv_batch_compare_and_set_task.h"
 #include "sdk/rawkv/raw_kv_batch_delete_task.h"
 #include "sdk/rawkv/raw_kv_batch_get_task.h"
@@ -49,6 +53,7 @@
 #include "sdk/rawkv/raw_kv_delete_task.h"
 #include "sdk/rawkv/raw_kv_get_task.h"
 #include "sdk/rawkv/raw_kv_internal_data.h"
+#include "sdk/rawkv/raw_kv_iterator.h"
 #include "sdk/rawkv/raw_kv_put_if_absent_task.h"
 #include "sdk/rawkv/raw_kv_put_task.h"
 #include "sdk/rawkv/raw_kv_scan_task.h"
@@ -59,6 +64,7 @@
 #include "sdk/transaction/txn_internal_data.h"
 #include "sdk/transaction/txn_manager.h"
 #include "sdk/utils/async_util.h"
+#include "sdk/utils/callback.h"
 #include "sdk/utils/net_util.h"
 #include "sdk/vector/diskann/vector_diskann_status_by_index_task.h"
 #include "sdk/vector/vector_index.h"
@@ -459,11 +465,90 @@ Status Client::TransferLeaderRegion(int64_t region_id, int64_t leader_store_id,
   return status;
 }
 
+Status Client::WarmupRange(const std::string& start_key, const std::string& end_key) {
+  Status status = data_->stub->GetMetaCache()->WarmupRange(start_key, end_key);
+  if (!status.IsOK()) {
+    DINGO_LOG(ERROR) << fmt::format("warmup range fail, error: {} {}", status.Errno(), status.ToString());
+  }
+
+  return status;
+}
+
+Status Client::WarmupIndex(int64_t index_id) {
+  // load through index cache, so the first vector or document call find its index there
+  std::vector<pb::common::Range> ranges;
+  std::shared_ptr<VectorIndex> vector_index;
+  Status status = data_->stub->GetVectorIndexCache()->GetVectorIndexById(index_id, vector_index);
+  if (!status.IsOK()) {
+    DINGO_LOG(ERROR) << fmt::format("get index {} fail, error: {} {}", index_id, status.Errno(), status.ToString());
+    return status;
+  }
+
+  if (vector_index->GetIndexDefWithId().index_definition().index_parameter().index_type() ==
+      pb::common::IndexType::INDEX_TYPE_DOCUMENT) {
+    data_->stub->GetVectorIndexCache()->RemoveVectorIndexById(index_id);
+
+    std::shared_ptr<DocumentIndex> doc_index;
+    status = data_->stub->GetDocumentIndexCache()->GetDocumentIndexById(index_id, doc_index);
+    if (!status.IsOK()) {
+      DINGO_LOG(ERROR) << fmt::format("get index {} fail, error: {} {}", index_id, status.Errno(), status.ToString());
+      return status;
+    }
+    for (int64_t part_id : doc_index->GetPartitionIds()) {
+      ranges.push_back(doc_index->GetPartitionRange(part_id));
+    }
+  } else {
+    for (int64_t part_id : vector_index->GetPartitionIds()) {
+      ranges.push_back(vector_index->GetPartitionRange(part_id));
+    }
+  }
+
+  for (const auto& range : ranges) {
+    status = data_->stub->GetMetaCache()->WarmupRange(range.start_key(), range.end_key());
+    if (!status.IsOK()) {
+      DINGO_LOG(ERROR) << fmt::format("warmup index {} range [{}, {}) fail, error: {} {}", index_id,
+                                      StringToHex(range.start_key()), StringToHex(range.end_key()), status.Errno(),
+                                      status.ToString());
+      return status;
+    }
+  }
+
+  return Status::OK();
+}
+
+Status Client::SaveRegionCache(const std::string& path) {
+  Status status = data_->stub->GetMetaCache()->SaveToFile(path);
+  if (!status.IsOK()) {
+    DINGO_LOG(ERROR) << fmt::format("save region cache fail, error: {} {}", status.Errno(), status.ToString());
+  }
+
+  return status;
+}
+
+Status Client::LoadRegionCache(const std::string& path) {
+  Status status = data_->stub->GetMetaCache()->LoadFromFile(path);
+  if (!status.IsOK()) {
+    DINGO_LOG(ERROR) << fmt::format("load region cache fail, error: {} {}", status.Errno(), status.ToString());
+  }
+
+  return status;
+}
+
+Status Client::GetMetrics(ClientMetrics& metrics) {
+  data_->stub->GetMetrics(metrics);
+  return Status::OK();
+}
+
 RawKV::RawKV(Data* data) : data_(data) {}
 
 RawKV::~RawKV() { delete data_; }
 
 Status RawKV::Get(const std::string& key, std::string& out_value) {
+  // batch run under deadline of the leader caller, so call with its own deadline bypass it
+  if (FLAGS_enable_auto_batch && GetCurrentDeadlineMs() == kNoDeadline) {
+    return data_->stub.GetRawKvAutoBatcher()->Get(key, out_value);
+  }
+
   RawKvGetTask task(data_->stub, key, out_value);
   return task.Run();
 }
@@ -474,6 +559,10 @@ Status RawKV::BatchGet(const std::vector<std::string>& keys, std::vector<KVPair>
 }
 
 Status RawKV::Put(const std::string& key, const std::string& value) {
+  if (FLAGS_enable_auto_batch && GetCurrentDeadlineMs() == kNoDeadline) {
+    return data_->stub.GetRawKvAutoBatcher()->Put(key, value);
+  }
+
   RawKvPutTask task(data_->stub, key, value);
   return task.Run();
 }
@@ -548,6 +637,11 @@ Status RawKV::BatchCompareAndSet(const std::vector<KVPair>& kvs, const std::vect
 }
 
 Status RawKV::Scan(const std::string& start_key, const std::string& end_key, uint64_t limit, std::vector<KVPair>& kvs) {
+  return Scan(start_key, end_key, limit, RawKVScanOptions(), kvs);
+}
+
+Status RawKV::Scan(const std::string& start_key, const std::string& end_key, uint64_t limit,
+                   const RawKVScanOptions& options, std::vector<KVPair>& kvs) {
   if (start_key.empty() || end_key.empty()) {
     return Status::InvalidArgument("start_key and end_key must not empty, check params");
   }
@@ -556,10 +650,104 @@ Status RawKV::Scan(const std::string& start_key, const std::string& end_key, uin
     return Status::InvalidArgument("end_key must greater than start_key, check params");
   }
 
-  RawKvScanTask task(data_->stub, start_key, end_key, limit, kvs);
+  RawKvScanTask task(data_->stub, start_key, end_key, limit, kvs, options.key_only);
   return task.Run();
 }
 
+Status RawKV::CountRange(const std::string& start_key, const std::string& end_key, int64_t& out_count) {
+  if (start_key.empty() || end_key.empty()) {
+    return Status::InvalidArgument("start_key and end_key must not empty, check params");
+  }
+
+  if (start_key >= end_key) {
+    return Status::InvalidArgument("end_key must greater than start_key, check params");
+  }
+
+  RawKvScanTask task(data_->stub, start_key, end_key, out_count);
+  return task.Run();
+}
+
+Status RawKV::NewIterator(const std::string& start_key, const std::string& end_key, const RawKVIteratorOptions& options,
+                          RawKVIterator** out_iterator) {
+  if (start_key.empty() || end_key.empty()) {
+    return Status::InvalidArgument("start_key and end_key must not empty, check params");
+  }
+
+  if (start_key >= end_key) {
+    return Status::InvalidArgument("end_key must greater than start_key, check params");
+  }
+
+  auto impl = std::make_unique<RawKvIteratorImpl>(data_->stub, start_key, end_key, options);
+  Status status = impl->Init();
+  if (!status.ok()) {
+    return status;
+  }
+
+  *out_iterator = new RawKVIterator(new RawKVIterator::Data(std::move(impl)));
+  return Status::OK();
+}
+
+RawKVIterator::RawKVIterator(Data* data) : data_(data) {}
+
+RawKVIterator::~RawKVIterator() { delete data_; }
+
+bool RawKVIterator::Valid() const { return data_->impl->Valid(); }
+
+void RawKVIterator::Next() { data_->impl->Next(); }
+
+const std::string& RawKVIterator::Key() const { return data_->impl->Key(); }
+
+const std::string& RawKVIterator::Value() const { return data_->impl->Value(); }
+
+Status RawKVIterator::GetStatus() const { return data_->impl->GetStatus(); }
+
+void RawKV::AsyncGet(std::string key, std::string& out_value, StatusCallback cb) {
+  auto owned_key = std::make_shared<std::string>(std::move(key));
+  AsyncRunTask(new RawKvGetTask(data_->stub, *owned_key, out_value), std::move(cb), owned_key);
+}
+
+void RawKV::AsyncBatchGet(std::vector<std::string> keys, std::vector<KVPair>& out_kvs, StatusCallback cb) {
+  auto owned_keys = std::make_shared<std::vector<std::string>>(std::move(keys));
+  AsyncRunTask(new RawKvBatchGetTask(data_->stub, *owned_keys, out_kvs), std::move(cb), owned_keys);
+}
+
+void RawKV::AsyncPut(std::string key, std::string value, StatusCallback cb) {
+  auto owned_kv = std::make_shared<KVPair>(KVPair{std::move(key), std::move(value)});
+  AsyncRunTask(new RawKvPutTask(data_->stub, owned_kv->key, owned_kv->value), std::move(cb), owned_kv);
+}
+
+void RawKV::AsyncBatchPut(std::vector<KVPair> kvs, StatusCallback cb) {
+  auto owned_kvs = std::make_shared<std::vector<KVPair>>(std::move(kvs));
+  AsyncRunTask(new RawKvBatchPutTask(data_->stub, *owned_kvs), std::move(cb), owned_kvs);
+}
+
+void RawKV::AsyncDelete(std::string key, StatusCallback cb) {
+  auto owned_key = std::make_shared<std::string>(std::move(key));
+  AsyncRunTask(new RawKvDeleteTask(data_->stub, *owned_key), std::move(cb), owned_key);
+}
+
+void RawKV::AsyncBatchDelete(std::vector<std::string> keys, StatusCallback cb) {
+  auto owned_keys = std::make_shared<std::vector<std::string>>(std::move(keys));
+  AsyncRunTask(new RawKvBatchDeleteTask(data_->stub, *owned_keys), std::move(cb), owned_keys);
+}
+
+void RawKV::AsyncScan(std::string start_key, std::string end_key, uint64_t limit, std::vector<KVPair>& out_kvs,
+                      StatusCallback cb) {
+  if (start_key.empty() || end_key.empty()) {
+    cb(Status::InvalidArgument("start_key and end_key must not empty, check params"));
+    return;
+  }
+
+  if (start_key >= end_key) {
+    cb(Status::InvalidArgument("end_key must greater than start_key, check params"));
+    return;
+  }
+
+  auto owned_range = std::make_shared<KVPair>(KVPair{std::move(start_key), std::move(end_key)});
+  AsyncRunTask(new RawKvScanTask(data_->stub, owned_range->key, owned_range->value, limit, out_kvs), std::move(cb),
+               owned_range);
+}
+
 Transaction::Transaction(Data* data) : data_(data) {}
 
 Transaction::~Transaction() { delete data_; }
@@ -597,6 +785,18 @@ Status Transaction::Commit() { return data_->impl->PreWriteAndCommit(); }
 
 Status Transaction::Rollback() { return data_->impl->Rollback(); }
 
+void Transaction::AsyncGet(std::string key, std::string& value, StatusCallback cb) {
+  data_->impl->AsyncGet(std::move(key), value, std::move(cb));
+}
+
+void Transaction::AsyncBatchGet(std::vector<std::string> keys, std::vector<KVPair>& kvs, StatusCallback cb) {
+  data_->impl->AsyncBatchGet(std::move(keys), kvs, std::move(cb));
+}
+
+void Transaction::AsyncCommit(StatusCallback cb) { data_->impl->AsyncPreWriteAndCommit(std::move(cb)); }
+
+void Transaction::AsyncRollback(StatusCallback cb) { data_->impl->AsyncRollback(std::move(cb)); }
+
 bool Transaction::IsOnePc() const { return data_->impl->IsOnePc(); }
 
 bool Transaction::IsAsyncCommit() const { return data_->impl->IsAsyncCommit(); }
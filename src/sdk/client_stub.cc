@@ -17,9 +17,11 @@
 #include <memory>
 #include <vector>
 
+#include "common/logging.h"
 #include "dingosdk/status.h"
 #include "sdk/common/param_config.h"
 #include "sdk/meta_cache.h"
+#include "sdk/rawkv/raw_kv_auto_batcher.h"
 #include "sdk/rawkv/raw_kv_region_scanner_impl.h"
 #include "sdk/rpc/coordinator_rpc_controller.h"
 #include "sdk/rpc/rpc_client.h"
@@ -28,6 +30,7 @@
 #include "sdk/transaction/txn_region_scanner_impl.h"
 #include "sdk/utils/net_util.h"
 #include "sdk/utils/thread_pool_actuator.h"
+#include "sdk/vector/vector_search_auto_batcher.h"
 
 namespace dingodb {
 namespace sdk {
@@ -61,6 +64,12 @@ Status ClientStub::Open(const std::vector<EndPoint>& endpoints) {
   rpc_client_.reset(NewRpcClient(options));
 
   meta_cache_ = std::make_shared<MetaCache>(coordinator_rpc_controller_);
+  if (!FLAGS_region_cache_file.empty()) {
+    Status s = meta_cache_->LoadFromFile(FLAGS_region_cache_file);
+    if (!s.ok()) {
+      DINGO_LOG(WARNING) << "load region cache fail, status:" << s.ToString();
+    }
+  }
 
   raw_kv_region_scanner_factory_ = std::make_shared<RawKvRegionScannerFactoryImpl>();
 
@@ -86,11 +95,83 @@ Status ClientStub::Open(const std::vector<EndPoint>& endpoints) {
 
   txn_manager_ = std::make_unique<TxnManager>();
 
+  raw_kv_auto_batcher_ =
+      std::make_shared<RawKvAutoBatcher>(*this, FLAGS_auto_batch_window_us, FLAGS_auto_batch_max_size);
+
+  vector_search_auto_batcher_ =
+      std::make_shared<VectorSearchAutoBatcher>(*this, FLAGS_auto_batch_window_us, FLAGS_auto_batch_max_size);
+
+  if (FLAGS_meta_cache_refresh_interval_ms > 0) {
+    ScheduleRegionRefresh();
+  }
+
+  if (FLAGS_client_metrics_dump_interval_ms > 0) {
+    ScheduleMetricsDump();
+  }
+
   return Status::OK();
 }
 
+void ClientStub::ScheduleRegionRefresh() {
+  actuator_->Schedule(
+      [this] {
+        Status s = meta_cache_->RefreshWarmupRanges();
+        if (!s.ok()) {
+          DINGO_LOG(WARNING) << "refresh warmup ranges fail, status:" << s.ToString();
+        }
+
+        LockGuard guard(&refresh_mutex_);
+        if (!refresh_stopped_) {
+          ScheduleRegionRefresh();
+        }
+      },
+      FLAGS_meta_cache_refresh_interval_ms);
+}
+
+void ClientStub::ScheduleMetricsDump() {
+  actuator_->Schedule(
+      [this] {
+        ClientMetrics metrics;
+        GetMetrics(metrics);
+        DINGO_LOG(INFO) << "[sdk.metrics] " << metrics.ToString();
+
+        LockGuard guard(&refresh_mutex_);
+        if (!refresh_stopped_) {
+          ScheduleMetricsDump();
+        }
+      },
+      FLAGS_client_metrics_dump_interval_ms);
+}
+
+void ClientStub::GetMetrics(ClientMetrics& metrics) const {
+  auto rpc_client = GetRpcClient();
+  rpc_client->GetRpcMetrics().GetMetrics(metrics);
+
+  auto cache_stats = GetMetaCache()->GetStats();
+  metrics.meta_cache_hit = cache_stats.hit_count;
+  metrics.meta_cache_miss = cache_stats.miss_count;
+  metrics.meta_cache_coalesced = cache_stats.coalesced_count;
+  metrics.meta_cache_rpc = cache_stats.rpc_count;
+
+  auto hedge_metrics = rpc_client->GetHedgeBudget().GetMetrics();
+  metrics.hedge_requests = hedge_metrics.requests;
+  metrics.hedged = hedge_metrics.hedged;
+  metrics.hedge_won = hedge_metrics.hedge_won;
+}
+
 // ensure the task execution in the thread pool is completed first
 void ClientStub::Stop() {
+  {
+    LockGuard guard(&refresh_mutex_);
+    refresh_stopped_ = true;
+  }
+
+  if (meta_cache_ && !FLAGS_region_cache_file.empty()) {
+    Status s = meta_cache_->SaveToFile(FLAGS_region_cache_file);
+    if (!s.ok()) {
+      DINGO_LOG(WARNING) << "save region cache fail, status:" << s.ToString();
+    }
+  }
   if (txn_manager_) {
     txn_manager_->Stop();
   }
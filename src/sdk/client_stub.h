@@ -17,6 +17,7 @@
 
 #include <memory>
 
+#include "dingosdk/metric.h"
 #include "glog/logging.h"
 #include "sdk/admin_tool.h"
 #include "sdk/auto_increment_manager.h"
@@ -27,6 +28,7 @@
 #include "sdk/rpc/rpc_client.h"
 #include "sdk/transaction/tso.h"
 #include "sdk/transaction/txn_lock_resolver.h"
+#include "sdk/utils/mutex_lock.h"
 #include "sdk/vector/vector_index_cache.h"
 #include "utils/actuator.h"
 
@@ -34,6 +36,8 @@ namespace dingodb {
 namespace sdk {
 
 class TxnManager;
+class RawKvAutoBatcher;
+class VectorSearchAutoBatcher;
 
 class ClientStub {
  public:
@@ -130,7 +134,26 @@ class ClientStub {
     return txn_manager_.get();
   }
 
+  virtual std::shared_ptr<RawKvAutoBatcher> GetRawKvAutoBatcher() const {
+    DCHECK_NOTNULL(raw_kv_auto_batcher_.get());
+    return raw_kv_auto_batcher_;
+  }
+
+  virtual std::shared_ptr<VectorSearchAutoBatcher> GetVectorSearchAutoBatcher() const {
+    DCHECK_NOTNULL(vector_search_auto_batcher_.get());
+    return vector_search_auto_batcher_;
+  }
+
+  // snapshot of rpc, meta cache and hedge metrics
+  void GetMetrics(ClientMetrics& metrics) const;
+
  private:
+  // periodically reload regions of warmup ranges, stop when client stop
+  void ScheduleRegionRefresh();
+
+  // periodically log metrics, stop when client stop
+  void ScheduleMetricsDump();
+
   // TODO: use unique ptr
   std::shared_ptr<CoordinatorRpcController> coordinator_rpc_controller_;
   std::shared_ptr<CoordinatorRpcController> tso_rpc_controller_;
@@ -149,6 +172,12 @@ class ClientStub {
   std::shared_ptr<AutoIncrementerManager> auto_increment_manager_;
   TsoProviderSPtr tso_provider_;
   std::unique_ptr<TxnManager> txn_manager_;
+  std::shared_ptr<RawKvAutoBatcher> raw_kv_auto_batcher_;
+  std::shared_ptr<VectorSearchAutoBatcher> vector_search_auto_batcher_;
+
+  // guard periodic tasks
+  Mutex refresh_mutex_;
+  bool refresh_stopped_{false};
 };
 
 }  // namespace sdk
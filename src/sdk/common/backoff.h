@@ -0,0 +1,66 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_BACKOFF_H_
+#define DINGODB_SDK_BACKOFF_H_
+
+#include <algorithm>
+#include <cstdint>
+
+#include "sdk/common/param_config.h"
+#include "sdk/common/rand.h"
+
+namespace dingodb {
+namespace sdk {
+
+// error class of retry, each class has its own base delay and attempt count
+enum BackoffType : uint8_t {
+  kBackoffNotLeader = 0,
+  kBackoffRegionEpoch,
+  kBackoffRequestFull,
+  kBackoffNetwork,
+  kBackoffTypeCount
+};
+
+inline int64_t BackoffBaseMs(BackoffType type) {
+  switch (type) {
+    case kBackoffNotLeader:
+      return FLAGS_backoff_not_leader_base_ms;
+    case kBackoffRegionEpoch:
+      return FLAGS_backoff_region_epoch_base_ms;
+    case kBackoffRequestFull:
+      return FLAGS_backoff_request_full_base_ms;
+    case kBackoffNetwork:
+      return FLAGS_backoff_network_base_ms;
+    default:
+      return FLAGS_backoff_network_base_ms;
+  }
+}
+
+// exponential backoff with full jitter, delay is random in [0, min(cap, base * 2^attempt)],
+// so retries of many requests fail at the same time spread out instead of firing together
+inline int64_t FullJitterBackoffMs(int64_t base_ms, int64_t cap_ms, int attempt) {
+  if (base_ms <= 0 || cap_ms <= 0) {
+    return 0;
+  }
+
+  int shift = std::clamp(attempt, 0, 30);
+  int64_t ceiling = std::min(cap_ms, base_ms << shift);
+  return static_cast<int64_t>(RandHelper::RandUInt64() % static_cast<uint64_t>(ceiling + 1));
+}
+
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_BACKOFF_H_
@@ -0,0 +1,65 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/common/call_context.h"
+
+#include "glog/logging.h"
+
+#ifndef USE_GRPC
+#include "bthread/bthread.h"
+#endif  // USE_GRPC
+
+namespace dingodb {
+namespace sdk {
+
+#ifdef USE_GRPC
+
+static thread_local CallContext current_call_context;
+
+CallContext CurrentCallContext() { return current_call_context; }
+
+void SetCurrentCallContext(const CallContext& ctx) { current_call_context = ctx; }
+
+#else
+
+// bthread may be moved to another worker pthread, so thread_local is not safe, bthread local storage also work in
+// pthread
+static bthread_key_t GetCallContextKey() {
+  static bthread_key_t key = [] {
+    bthread_key_t tmp_key;
+    CHECK(bthread_key_create(&tmp_key, [](void* data) { delete static_cast<CallContext*>(data); }) == 0)
+        << "bthread_key_create fail.";
+    return tmp_key;
+  }();
+  return key;
+}
+
+CallContext CurrentCallContext() {
+  auto* ctx = static_cast<CallContext*>(bthread_getspecific(GetCallContextKey()));
+  return ctx != nullptr ? *ctx : CallContext();
+}
+
+void SetCurrentCallContext(const CallContext& ctx) {
+  auto* current = static_cast<CallContext*>(bthread_getspecific(GetCallContextKey()));
+  if (current == nullptr) {
+    current = new CallContext();
+    CHECK(bthread_setspecific(GetCallContextKey(), current) == 0) << "bthread_setspecific fail.";
+  }
+  *current = ctx;
+}
+
+#endif  // USE_GRPC
+
+}  // namespace sdk
+}  // namespace dingodb
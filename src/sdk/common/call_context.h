@@ -0,0 +1,57 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_CALL_CONTEXT_H_
+#define DINGODB_SDK_CALL_CONTEXT_H_
+
+#include <cstdint>
+
+namespace dingodb {
+namespace sdk {
+
+// State of a sdk call which follow it from public api across tasks, retries and rpc callbacks.
+// Task and controller capture the current one when construct, and set it back while running their code, so task,
+// controller and rpc created inside inherit it, e.g. sub task created in DoAsync or next rpc sent in callback.
+struct CallContext {
+  // absolute time of MonotonicMs(), 0 means no deadline
+  int64_t deadline_ms{0};
+  // 0 means not traced
+  uint64_t trace_id{0};
+  // new spans are children of it
+  uint64_t span_id{0};
+};
+
+// context of current bthread(or thread when use grpc)
+CallContext CurrentCallContext();
+
+void SetCurrentCallContext(const CallContext& ctx);
+
+// set ctx as current context and restore the previous one when leave
+class CallContextGuard {
+ public:
+  explicit CallContextGuard(const CallContext& ctx) : prev_ctx_(CurrentCallContext()) { SetCurrentCallContext(ctx); }
+
+  ~CallContextGuard() { SetCurrentCallContext(prev_ctx_); }
+
+  CallContextGuard(const CallContextGuard&) = delete;
+  const CallContextGuard& operator=(const CallContextGuard&) = delete;
+
+ private:
+  CallContext prev_ctx_;
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_CALL_CONTEXT_H_
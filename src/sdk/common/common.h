@@ -154,14 +154,28 @@ static bool IsRetryErrorCode(int32_t error_code) {
          error_code == pb::error::EREGION_NEW;
 }
 
-static void TraceRpcPerformance(int64_t elapse_time, const std::string& method_name, const std::string& endpoint,
-                                const std::string& str) {
-  if (FLAGS_enable_trace_rpc_performance) {
-    if (elapse_time > FLAGS_rpc_elapse_time_threshold_us) {
-      // Log concise rpc info if elapse time greater than threshold
-      DINGO_LOG(INFO) << fmt::format("[sdk.trace.rpc][{}][{:.6f}s][endpoint({})] {}", method_name, elapse_time / 1e6,
-                                     endpoint, str);
-    }
+// check it before build anything for TraceRpcPerformance, most rpc are fast and never logged
+static bool NeedTraceRpcPerformance(int64_t elapse_time) {
+  return elapse_time > FLAGS_rpc_trace_full_info_threshold_us ||
+         (FLAGS_enable_trace_rpc_performance && elapse_time > FLAGS_rpc_elapse_time_threshold_us);
+}
+
+// request and response are only formatted when elapse time greater than FLAGS_rpc_trace_full_info_threshold_us
+static void TraceRpcPerformance(int64_t elapse_time, const char* method_name, const std::string& endpoint,
+                                uint64_t log_id, const Status& status, const google::protobuf::Message& request,
+                                const google::protobuf::Message& response) {
+  std::string str = fmt::format("request_id: {}, status: {}", log_id, status.ToString());
+  if (elapse_time > FLAGS_rpc_trace_full_info_threshold_us) {
+    // Default log all rpc info if elapse time greater than 1 second
+    str += fmt::format(", request: {}, response: {}", request.ShortDebugString(), response.ShortDebugString());
+    DINGO_LOG(INFO) << fmt::format("[sdk.trace.rpc][{}][{:.6f}s][endpoint({})] Full rpc info {}", method_name,
+                                   elapse_time / 1e6, endpoint, str);
+  }
+
+  if (FLAGS_enable_trace_rpc_performance && elapse_time > FLAGS_rpc_elapse_time_threshold_us) {
+    // Log concise rpc info if elapse time greater than threshold
+    DINGO_LOG(INFO) << fmt::format("[sdk.trace.rpc][{}][{:.6f}s][endpoint({})] {}", method_name, elapse_time / 1e6,
+                                   endpoint, str);
   }
 }
 
@@ -0,0 +1,48 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/common/deadline.h"
+
+#include <chrono>
+#include <cstdint>
+
+#include "dingosdk/client.h"
+
+namespace dingodb {
+namespace sdk {
+
+int64_t MonotonicMs() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+ScopedDeadline::ScopedDeadline(int64_t timeout_ms) : prev_deadline_ms_(GetCurrentDeadlineMs()) {
+  int64_t deadline_ms = MonotonicMs() + std::max(timeout_ms, int64_t(0));
+  if (prev_deadline_ms_ != kNoDeadline) {
+    deadline_ms = std::min(deadline_ms, prev_deadline_ms_);
+  }
+
+  CallContext ctx = CurrentCallContext();
+  ctx.deadline_ms = deadline_ms;
+  SetCurrentCallContext(ctx);
+}
+
+ScopedDeadline::~ScopedDeadline() {
+  CallContext ctx = CurrentCallContext();
+  ctx.deadline_ms = prev_deadline_ms_;
+  SetCurrentCallContext(ctx);
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,56 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_DEADLINE_H_
+#define DINGODB_SDK_DEADLINE_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+#include "sdk/common/call_context.h"
+
+namespace dingodb {
+namespace sdk {
+
+// deadline is absolute time of MonotonicMs(), 0 means no deadline
+static const int64_t kNoDeadline = 0;
+
+int64_t MonotonicMs();
+
+// deadline of sdk call running in current bthread(or thread when use grpc)
+inline int64_t GetCurrentDeadlineMs() { return CurrentCallContext().deadline_ms; }
+
+// int64 max when no deadline, <= 0 when expired
+inline int64_t DeadlineRemainingMs(int64_t deadline_ms) {
+  if (deadline_ms == kNoDeadline) {
+    return std::numeric_limits<int64_t>::max();
+  }
+  return deadline_ms - MonotonicMs();
+}
+
+inline bool IsDeadlineExpired(int64_t deadline_ms) { return DeadlineRemainingMs(deadline_ms) <= 0; }
+
+// clip timeout of one attempt to the remaining budget, at least 1ms so rpc still fail by timeout
+inline int64_t ClipTimeoutMs(int64_t timeout_ms, int64_t deadline_ms) {
+  if (deadline_ms == kNoDeadline) {
+    return timeout_ms;
+  }
+  return std::max(std::min(timeout_ms, DeadlineRemainingMs(deadline_ms)), int64_t(1));
+}
+
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_DEADLINE_H_
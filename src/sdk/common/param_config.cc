@@ -29,11 +29,19 @@ DEFINE_int64(auto_incre_req_count, 1000, "raw kv max retry times");
 // ChannelOptions should set "timeout_ms > connect_timeout_ms" for circuit breaker
 DEFINE_int64(rpc_channel_timeout_ms, 500000, "rpc channel timeout ms");
 DEFINE_int64(rpc_channel_connect_timeout_ms, 3000, "rpc channel connect timeout ms");
+DEFINE_int64(rpc_channel_num_per_endpoint, 1, "rpc channel num per endpoint, each channel use its own connection");
+DEFINE_string(rpc_channel_connection_type, "single", "rpc channel connection type, single/pooled/short");
 
 // only used for grpc
 DEFINE_int64(grpc_poll_thread_num, 32, "grpc poll cq thread num");
+DEFINE_bool(grpc_pin_poll_thread, false, "pin each grpc poll cq thread to one cpu");
+DEFINE_int64(grpc_max_message_size, 0, "grpc max send and receive message size, 0 means grpc default");
+DEFINE_int64(grpc_keepalive_time_ms, 0, "grpc keepalive ping interval ms, 0 means disable");
+DEFINE_int64(grpc_keepalive_timeout_ms, 20000, "grpc keepalive ping ack timeout ms");
+DEFINE_bool(grpc_use_callback_api, false, "send grpc with callback api instead of completion queue");
 
 DEFINE_int64(rpc_max_retry, 3, "rpc call max retry times");
+DEFINE_bool(rpc_enable_arena, false, "allocate rpc request and response on protobuf arena");
 DEFINE_int64(rpc_time_out_ms, 500000, "rpc call timeout ms");
 
 DEFINE_bool(enable_trace_rpc_performance, true, "enable trance rpc performance, use for debug");
@@ -41,10 +49,42 @@ DEFINE_int64(rpc_elapse_time_threshold_us, 1000, "rpc elapse time us threshold")
 DEFINE_int64(rpc_trace_full_info_threshold_us, 1000000,
 			 "log full rpc detail when elapsed time exceeds this threshold (us)");
 
-DEFINE_int64(store_rpc_retry_delay_ms, 500, "store rpc retry delay ms");
+DEFINE_int64(store_rpc_retry_delay_ms, 500, "max store rpc retry delay ms, cap of exponential backoff");
+DEFINE_int64(backoff_not_leader_base_ms, 10, "backoff base delay ms of not leader and raft errors");
+DEFINE_int64(backoff_region_epoch_base_ms, 20, "backoff base delay ms of region epoch changed errors");
+DEFINE_int64(backoff_request_full_base_ms, 50, "backoff base delay ms of request full and busy errors");
+DEFINE_int64(backoff_network_base_ms, 100, "backoff base delay ms of network errors");
+DEFINE_string(store_read_policy, "leader",
+              "replica policy of read only store rpc, leader: only leader, any: random replica, "
+              "nearest: replica with least ewma latency");
+DEFINE_int64(store_unhealthy_duration_ms, 3000, "store endpoint is avoided for this duration after rpc to it fail");
+DEFINE_int64(store_unhealthy_failure_threshold, 3,
+             "consecutive transport failures of a store endpoint before it is marked unhealthy");
+DEFINE_bool(store_enable_hedge_read, false,
+            "send duplicate replica read to another replica when it is slower than tail latency, "
+            "need store_read_policy any or nearest");
+DEFINE_int64(store_hedge_deviation_factor, 4, "hedge delay is ewma latency + factor * latency mean deviation");
+DEFINE_int64(store_hedge_min_delay_ms, 5, "min delay ms before sending hedged read");
+DEFINE_int64(store_hedge_budget_percent, 5, "max percent of extra rpc caused by hedged read");
+DEFINE_bool(store_enable_concurrency_limit, false,
+            "limit inflight rpc of each store endpoint, the limit adapt to EREQUEST_FULL, timeout and latency");
+DEFINE_int64(store_concurrency_limit_init, 32, "initial inflight rpc limit of each store endpoint");
+DEFINE_int64(store_concurrency_limit_min, 1, "min inflight rpc limit of each store endpoint");
+DEFINE_int64(store_concurrency_limit_max, 1024, "max inflight rpc limit of each store endpoint");
+DEFINE_int64(store_concurrency_limit_queue_size, 1024,
+             "max rpc wait for limit of each store endpoint, rpc fail fast when queue is full");
+DEFINE_int64(store_concurrency_limit_max_queue_ms, 30000,
+             "max time rpc without deadline wait for limit of each store endpoint, 0 means no limit");
+DEFINE_int64(store_concurrency_limit_latency_tolerance, 2,
+             "limit stop growing when rpc latency exceed tolerance * min latency");
 DEFINE_int64(store_rpc_max_retry, 600, "store rpc max retry times, use case: wrong leader or request range invalid");
 
 DEFINE_int64(scan_batch_size, 1000, "scan batch size, use for region scanner");
+DEFINE_int64(scan_region_concurrency, 1, "max regions raw kv scan read at the same time, 1 means scan one by one");
+DEFINE_int64(scan_region_prefetch_batch_num, 2, "max batches a region scanner read ahead of the merged output");
+DEFINE_int64(count_range_region_concurrency, 8, "max regions raw kv count range read at the same time");
+DEFINE_int64(scan_batch_bytes, 4 * 1024 * 1024,
+             "target bytes of one scan batch, fetch count is adjusted by learned kv size, 0 means use scan_batch_size");
 
 DEFINE_int64(txn_op_delay_ms, 300, "txn op delay ms");
 DEFINE_int64(txn_op_max_retry, 20, "txn op max retry times");
@@ -53,8 +93,11 @@ DEFINE_int64(txn_prewrite_delay_ms, 500, "txn prewrite delay ms");
 DEFINE_int64(txn_prewrite_max_retry, 300, "txn prewrite max retry");
 DEFINE_bool(enable_txn_concurrent_prewrite, true, "enable txn concurrent prewrite");
 
-DEFINE_int64(raw_kv_delay_ms, 500, "raw kv backoff delay ms");
+DEFINE_int64(raw_kv_delay_ms, 500, "max raw kv backoff delay ms");
 DEFINE_int64(raw_kv_max_retry, 10, "raw kv max retry times");
+DEFINE_int64(raw_kv_batch_write_max_count, 4096, "max kvs of one rpc of raw kv batch put/delete");
+DEFINE_int64(raw_kv_batch_write_max_bytes, 4 * 1024 * 1024, "max bytes of one rpc of raw kv batch put/delete");
+DEFINE_int64(raw_kv_batch_write_window_per_store, 4, "max in flight rpcs to one store of raw kv batch put/delete");
 
 DEFINE_int64(vector_op_delay_ms, 500, "vector task base backoff delay ms");
 DEFINE_int64(vector_op_max_retry, 30, "vector task max retry times");
@@ -72,3 +115,18 @@ DEFINE_int64(txn_check_status_interval_ms, 100, "txn check status interval ms");
 
 DEFINE_uint32(stale_period_us, 1000, "stale period us default 1000 us, used for tso provider");
 DEFINE_uint32(tso_batch_size, 256, "tso batch size default 256, used for tso provider");
+
+DEFINE_string(region_cache_file, "", "region cache file, load when client open and save when client stop, empty means disable");
+DEFINE_int64(meta_cache_warmup_page_size, 256, "max region count of one scan regions rpc when warmup range");
+DEFINE_int64(meta_cache_refresh_interval_ms, 0, "reload regions of warmup ranges interval ms, 0 means disable");
+
+DEFINE_bool(enable_auto_batch, false, "merge concurrent raw kv get/put and vector search into batch rpc");
+DEFINE_int64(auto_batch_window_us, 200, "max time us the first request of a batch wait for others");
+DEFINE_int64(auto_batch_max_size, 128, "max request count of one auto batch");
+
+DEFINE_int64(client_metrics_dump_interval_ms, 0, "log client metrics interval ms, 0 means disable");
+
+DEFINE_bool(enable_trace, false, "record trace spans of sdk calls");
+DEFINE_int64(trace_slow_threshold_ms, 100, "export trace of call slower than this ms");
+DEFINE_int64(trace_buffer_size, 65536, "span count of trace ring buffer, round up to power of 2");
+DEFINE_string(trace_slow_file, "", "append slow trace as json line to this file, empty means disable");
@@ -38,12 +38,20 @@ DECLARE_int64(auto_incre_req_count);
 // ChannelOptions should set "timeout_ms > connect_timeout_ms" for circuit breaker
 DECLARE_int64(rpc_channel_timeout_ms);
 DECLARE_int64(rpc_channel_connect_timeout_ms);
+DECLARE_int64(rpc_channel_num_per_endpoint);
+DECLARE_string(rpc_channel_connection_type);
 
 // each rpc call params, set for brpc::Controller
 DECLARE_int64(rpc_max_retry);
+DECLARE_bool(rpc_enable_arena);
 DECLARE_int64(rpc_time_out_ms);
 
 DECLARE_int64(grpc_poll_thread_num);
+DECLARE_bool(grpc_pin_poll_thread);
+DECLARE_int64(grpc_max_message_size);
+DECLARE_int64(grpc_keepalive_time_ms);
+DECLARE_int64(grpc_keepalive_timeout_ms);
+DECLARE_bool(grpc_use_callback_api);
 
 DECLARE_bool(enable_trace_rpc_performance);
 DECLARE_int64(rpc_elapse_time_threshold_us);
@@ -52,15 +60,42 @@ DECLARE_int64(rpc_trace_full_info_threshold_us);
 // each store rpc params, used for store rpc controller
 DECLARE_int64(store_rpc_max_retry);
 DECLARE_int64(store_rpc_retry_delay_ms);
+DECLARE_int64(backoff_not_leader_base_ms);
+DECLARE_int64(backoff_region_epoch_base_ms);
+DECLARE_int64(backoff_request_full_base_ms);
+DECLARE_int64(backoff_network_base_ms);
+DECLARE_string(store_read_policy);
+DECLARE_int64(store_unhealthy_duration_ms);
+DECLARE_int64(store_unhealthy_failure_threshold);
+DECLARE_bool(store_enable_hedge_read);
+DECLARE_int64(store_hedge_deviation_factor);
+DECLARE_int64(store_hedge_min_delay_ms);
+DECLARE_int64(store_hedge_budget_percent);
+DECLARE_bool(store_enable_concurrency_limit);
+DECLARE_int64(store_concurrency_limit_init);
+DECLARE_int64(store_concurrency_limit_min);
+DECLARE_int64(store_concurrency_limit_max);
+DECLARE_int64(store_concurrency_limit_queue_size);
+DECLARE_int64(store_concurrency_limit_max_queue_ms);
+DECLARE_int64(store_concurrency_limit_latency_tolerance);
 
 // start: use for region scanner
 DECLARE_int64(scan_batch_size);
+DECLARE_int64(scan_region_concurrency);
+DECLARE_int64(scan_region_prefetch_batch_num);
+DECLARE_int64(scan_batch_bytes);
+DECLARE_int64(count_range_region_concurrency);
 const int64_t kMinScanBatchSize = 1;
 const int64_t kMaxScanBatchSize = 100;
+// upper bound when batch size is sized by FLAGS_scan_batch_bytes
+const int64_t kMaxAdaptiveScanBatchSize = 100000;
 // end: use for region scanner
 
 DECLARE_int64(raw_kv_delay_ms);
 DECLARE_int64(raw_kv_max_retry);
+DECLARE_int64(raw_kv_batch_write_max_count);
+DECLARE_int64(raw_kv_batch_write_max_bytes);
+DECLARE_int64(raw_kv_batch_write_window_per_store);
 
 DECLARE_int64(txn_op_delay_ms);
 DECLARE_int64(txn_op_max_retry);
@@ -86,4 +121,19 @@ DECLARE_int64(txn_check_status_interval_ms);
 DECLARE_uint32(stale_period_us);
 DECLARE_uint32(tso_batch_size);
 
+DECLARE_string(region_cache_file);
+DECLARE_int64(meta_cache_warmup_page_size);
+DECLARE_int64(meta_cache_refresh_interval_ms);
+
+DECLARE_bool(enable_auto_batch);
+DECLARE_int64(auto_batch_window_us);
+DECLARE_int64(auto_batch_max_size);
+
+DECLARE_int64(client_metrics_dump_interval_ms);
+
+DECLARE_bool(enable_trace);
+DECLARE_int64(trace_slow_threshold_ms);
+DECLARE_int64(trace_buffer_size);
+DECLARE_string(trace_slow_file);
+
 #endif  // DINGODB_SDK_PARAM_CONFIG_H_
\ No newline at end of file
@@ -0,0 +1,288 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/common/tracer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <utility>
+
+#include "common/logging.h"
+#include "fmt/format.h"
+#include "sdk/common/rand.h"
+
+namespace dingodb {
+namespace sdk {
+
+static const int64_t kMaxExportQueueSize = 1024;
+
+static int64_t WallClockUs() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+static void CopyTruncated(std::string_view src, char* dst, size_t dst_size) {
+  size_t len = std::min(src.size(), dst_size - 1);
+  std::memcpy(dst, src.data(), len);
+  dst[len] = '\0';
+}
+
+Span Span::Start(std::string_view name, const CallContext& parent) {
+  Span span;
+  if (!NeedTrace(parent)) {
+    return span;
+  }
+
+  span.record_.trace_id = parent.trace_id != 0 ? parent.trace_id : Tracer::NextId();
+  span.record_.parent_id = parent.trace_id != 0 ? parent.span_id : 0;
+  span.record_.span_id = Tracer::NextId();
+  span.record_.start_us = WallClockUs();
+  CopyTruncated(name, span.record_.name, sizeof(span.record_.name));
+  return span;
+}
+
+CallContext Span::ChildContext(const CallContext& base) const {
+  CallContext ctx = base;
+  if (IsActive()) {
+    ctx.trace_id = record_.trace_id;
+    ctx.span_id = record_.span_id;
+  }
+  return ctx;
+}
+
+void Span::SetEndPoint(const EndPoint& end_point) {
+  if (IsActive()) {
+    CopyTruncated(end_point.ToString(), record_.end_point, sizeof(record_.end_point));
+  }
+}
+
+void Span::End(const Status& status) {
+  if (!IsActive() || record_.end_us != 0) {
+    return;
+  }
+
+  record_.end_us = std::max(WallClockUs(), record_.start_us + 1);
+  record_.ok = status.ok();
+  record_.errcode = status.Errno();
+  Tracer::GetInstance().Record(record_);
+}
+
+ScopedSpan::ScopedSpan(std::string_view name, const CallContext& parent) : prev_ctx_(CurrentCallContext()) {
+  span_ = Span::Start(name, parent);
+  if (span_.IsActive()) {
+    SetCurrentCallContext(span_.ChildContext(prev_ctx_));
+  }
+}
+
+ScopedSpan::~ScopedSpan() {
+  if (span_.IsActive()) {
+    span_.End(Status::OK());
+    SetCurrentCallContext(prev_ctx_);
+  }
+}
+
+Tracer& Tracer::GetInstance() {
+  static Tracer tracer;
+  return tracer;
+}
+
+Tracer::Tracer() {
+  uint64_t size = 1;
+  while (size < static_cast<uint64_t>(std::max(FLAGS_trace_buffer_size, int64_t(1)))) {
+    size <<= 1;
+  }
+  slots_ = std::make_unique<Slot[]>(size);
+  mask_ = size - 1;
+}
+
+Tracer::~Tracer() {
+  {
+    std::lock_guard<std::mutex> guard(export_mutex_);
+    stop_ = true;
+  }
+  export_cond_.notify_all();
+  if (export_thread_ != nullptr) {
+    export_thread_->join();
+  }
+}
+
+uint64_t Tracer::NextId() {
+  // random start so ids of different processes rarely collide, never 0
+  static std::atomic<uint64_t> next_id{(RandHelper::RandUInt64() >> 1) + 1};
+  return next_id.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Tracer::Record(const SpanRecord& record) {
+  uint64_t index = write_index_.fetch_add(1, std::memory_order_relaxed);
+  Slot& slot = slots_[index & mask_];
+
+  // claim the slot by moving seq from even to odd, a writer lapped onto a slot still being written drop its record,
+  // so two writers never copy into one record at the same time
+  uint64_t seq = slot.seq.load(std::memory_order_relaxed);
+  if ((seq & 1) == 0 && slot.seq.compare_exchange_strong(seq, seq + 1, std::memory_order_relaxed)) {
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.record = record;
+    slot.seq.store(seq + 2, std::memory_order_release);
+  }
+
+  if (record.parent_id == 0 && record.end_us - record.start_us >= FLAGS_trace_slow_threshold_ms * 1000) {
+    EnqueueSlowTrace(record.trace_id);
+  }
+}
+
+void Tracer::CollectTrace(uint64_t trace_id, std::vector<TraceSpan>& spans) {
+  spans.clear();
+  for (uint64_t i = 0; i <= mask_; ++i) {
+    Slot& slot = slots_[i];
+    uint64_t seq_before = slot.seq.load(std::memory_order_acquire);
+    if ((seq_before & 1) != 0) {
+      continue;
+    }
+
+    SpanRecord record = slot.record;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.seq.load(std::memory_order_relaxed) != seq_before || record.trace_id != trace_id) {
+      continue;
+    }
+
+    TraceSpan span;
+    span.trace_id = record.trace_id;
+    span.span_id = record.span_id;
+    span.parent_id = record.parent_id;
+    span.name = record.name;
+    span.start_us = record.start_us;
+    span.duration_us = record.end_us - record.start_us;
+    span.log_id = record.log_id;
+    span.region_id = record.region_id;
+    span.end_point = record.end_point;
+    span.ok = record.ok;
+    span.errcode = record.errcode;
+    spans.push_back(std::move(span));
+  }
+
+  std::sort(spans.begin(), spans.end(), [](const TraceSpan& a, const TraceSpan& b) {
+    return a.start_us != b.start_us ? a.start_us < b.start_us : a.span_id < b.span_id;
+  });
+}
+
+void Tracer::SetSink(TraceSink sink) {
+  LockGuard guard(&sink_mutex_);
+  sink_ = std::move(sink);
+}
+
+void Tracer::Flush() {
+  std::unique_lock<std::mutex> lock(export_mutex_);
+  export_cond_.wait(lock, [this] { return (export_queue_.empty() && !exporting_) || stop_; });
+}
+
+void Tracer::EnqueueSlowTrace(uint64_t trace_id) {
+  {
+    std::lock_guard<std::mutex> guard(export_mutex_);
+    if (stop_) {
+      return;
+    }
+    if (static_cast<int64_t>(export_queue_.size()) >= kMaxExportQueueSize) {
+      DINGO_LOG(WARNING) << "slow trace export queue is full, drop trace:" << trace_id;
+      return;
+    }
+    export_queue_.push_back(trace_id);
+    if (export_thread_ == nullptr) {
+      export_thread_ = std::make_unique<std::thread>(&Tracer::ExportLoop, this);
+    }
+  }
+  export_cond_.notify_all();
+}
+
+void Tracer::ExportLoop() {
+  std::unique_lock<std::mutex> lock(export_mutex_);
+  while (true) {
+    export_cond_.wait(lock, [this] { return !export_queue_.empty() || stop_; });
+    if (stop_) {
+      return;
+    }
+
+    uint64_t trace_id = export_queue_.front();
+    export_queue_.pop_front();
+    exporting_ = true;
+    lock.unlock();
+
+    ExportSlowTrace(trace_id);
+
+    lock.lock();
+    exporting_ = false;
+    export_cond_.notify_all();
+  }
+}
+
+void Tracer::ExportSlowTrace(uint64_t trace_id) {
+  std::vector<TraceSpan> spans;
+  CollectTrace(trace_id, spans);
+
+  TraceSink sink;
+  {
+    LockGuard guard(&sink_mutex_);
+    sink = sink_;
+  }
+  if (sink) {
+    sink(spans);
+  }
+
+  // only exporter thread write the file
+  if (!FLAGS_trace_slow_file.empty()) {
+    std::ofstream file(FLAGS_trace_slow_file, std::ios::app);
+    if (!file.is_open()) {
+      DINGO_LOG(WARNING) << "open trace file fail, path:" << FLAGS_trace_slow_file;
+      return;
+    }
+    file << TraceSpansToJson(spans) << '\n';
+  }
+}
+
+void SetTraceSink(TraceSink sink) { Tracer::GetInstance().SetSink(std::move(sink)); }
+
+static std::string EscapeJson(const std::string& str) {
+  std::string escaped;
+  escaped.reserve(str.size());
+  for (char c : str) {
+    if (c == '"' || c == '\\') {
+      escaped.push_back('\\');
+      escaped.push_back(c);
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      escaped += fmt::format("\\u{:04x}", static_cast<int>(c));
+    } else {
+      escaped.push_back(c);
+    }
+  }
+  return escaped;
+}
+
+std::string TraceSpansToJson(const std::vector<TraceSpan>& spans) {
+  std::string json = fmt::format("{{\"trace_id\":{},\"spans\":[", spans.empty() ? 0 : spans.front().trace_id);
+  for (size_t i = 0; i < spans.size(); ++i) {
+    const auto& span = spans[i];
+    json += fmt::format(
+        "{}{{\"span_id\":{},\"parent_id\":{},\"name\":\"{}\",\"start_us\":{},\"duration_us\":{},\"log_id\":{},"
+        "\"region_id\":{},\"end_point\":\"{}\",\"ok\":{},\"errcode\":{}}}",
+        i == 0 ? "" : ",", span.span_id, span.parent_id, EscapeJson(span.name), span.start_us, span.duration_us,
+        span.log_id, span.region_id, EscapeJson(span.end_point), span.ok, span.errcode);
+  }
+  json += "]}";
+  return json;
+}
+
+}  // namespace sdk
+}  // namespace dingodb
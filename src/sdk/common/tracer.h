@@ -0,0 +1,159 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_TRACER_H_
+#define DINGODB_SDK_TRACER_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "dingosdk/status.h"
+#include "dingosdk/trace.h"
+#include "sdk/common/call_context.h"
+#include "sdk/common/param_config.h"
+#include "sdk/utils/mutex_lock.h"
+#include "sdk/utils/net_util.h"
+
+namespace dingodb {
+namespace sdk {
+
+// fixed size so it can be copied into ring buffer without allocation, long name is truncated
+struct SpanRecord {
+  uint64_t trace_id{0};
+  uint64_t span_id{0};
+  uint64_t parent_id{0};
+  int64_t start_us{0};
+  int64_t end_us{0};
+  int64_t log_id{0};
+  int64_t region_id{0};
+  int32_t errcode{0};
+  bool ok{true};
+  char name[64]{};
+  char end_point[48]{};
+};
+
+// call is traced if it is already in a trace, or tracing is enabled and a new trace can start
+inline bool NeedTrace(const CallContext& ctx) { return ctx.trace_id != 0 || FLAGS_enable_trace; }
+
+// Span of a step which may end in another bthread, e.g. rpc attempt end in callback.
+// Default constructed or started when NeedTrace is false span is inactive, all methods are no-op then.
+class Span {
+ public:
+  Span() = default;
+
+  // child of parent span, or root of a new trace when parent is not traced
+  static Span Start(std::string_view name, const CallContext& parent);
+
+  static Span Start(std::string_view name) { return Start(name, CurrentCallContext()); }
+
+  bool IsActive() const { return record_.span_id != 0; }
+
+  // base with this span as parent of new spans
+  CallContext ChildContext(const CallContext& base) const;
+
+  void SetLogId(int64_t log_id) { record_.log_id = log_id; }
+
+  void SetRegionId(int64_t region_id) { record_.region_id = region_id; }
+
+  void SetEndPoint(const EndPoint& end_point);
+
+  // record the span, only the first call take effect
+  void End(const Status& status);
+
+ private:
+  SpanRecord record_;
+};
+
+// span of current scope, spans started in the scope are its children
+class ScopedSpan {
+ public:
+  explicit ScopedSpan(std::string_view name) : ScopedSpan(name, CurrentCallContext()) {}
+
+  ScopedSpan(std::string_view name, const CallContext& parent);
+
+  ~ScopedSpan();
+
+  ScopedSpan(const ScopedSpan&) = delete;
+  const ScopedSpan& operator=(const ScopedSpan&) = delete;
+
+ private:
+  Span span_;
+  CallContext prev_ctx_;
+};
+
+// Keep recent spans in a lock-free ring buffer, old spans are overwritten.
+// When a root span is slower than FLAGS_trace_slow_threshold_ms, spans of its trace still in buffer are exported
+// by a background thread, so the thread ending the span never scan the buffer or do I/O.
+class Tracer {
+ public:
+  static Tracer& GetInstance();
+
+  Tracer(const Tracer&) = delete;
+  const Tracer& operator=(const Tracer&) = delete;
+
+  void Record(const SpanRecord& record);
+
+  // spans of trace still in ring buffer, ordered by start time
+  void CollectTrace(uint64_t trace_id, std::vector<TraceSpan>& spans);
+
+  void SetSink(TraceSink sink);
+
+  // block until slow traces recorded before are exported
+  void Flush();
+
+  static uint64_t NextId();
+
+ private:
+  Tracer();
+  ~Tracer();
+
+  // seqlock: writer claim the slot by CAS seq from even to odd, reader skip slot whose seq is odd or changed
+  struct Slot {
+    std::atomic<uint64_t> seq{0};
+    SpanRecord record;
+  };
+
+  // queue trace_id for exporter thread, dropped when queue is full
+  void EnqueueSlowTrace(uint64_t trace_id);
+  void ExportLoop();
+  void ExportSlowTrace(uint64_t trace_id);
+
+  std::unique_ptr<Slot[]> slots_;
+  uint64_t mask_;
+  std::atomic<uint64_t> write_index_{0};
+
+  Mutex sink_mutex_;
+  TraceSink sink_;
+
+  std::mutex export_mutex_;
+  std::condition_variable export_cond_;
+  std::deque<uint64_t> export_queue_;
+  // exporter thread is working on a trace popped from export_queue_
+  bool exporting_{false};
+  bool stop_{false};
+  // started on first slow trace
+  std::unique_ptr<std::thread> export_thread_;
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_TRACER_H_
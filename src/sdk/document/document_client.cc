@@ -13,6 +13,9 @@
 // limitations under the License.
 
 #include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
 
 #include "sdk/client_stub.h"
 #include "dingosdk/document.h"
@@ -29,6 +32,7 @@
 #include "sdk/document/document_search_task.h"
 #include "sdk/document/document_update_auto_increment_task.h"
 #include "sdk/document/document_update_task.h"
+#include "sdk/utils/callback.h"
 #include "dingosdk/status.h"
 
 namespace dingodb {
@@ -131,6 +135,28 @@ Status DocumentClient::BatchQueryByIndexName(int64_t schema_id, const std::strin
   return task.Run();
 }
 
+void DocumentClient::AsyncAddByIndexId(int64_t index_id, std::vector<DocWithId>& docs, StatusCallback cb) {
+  AsyncRunTask(new DocumentAddTask(stub_, index_id, docs), std::move(cb));
+}
+
+void DocumentClient::AsyncSearchByIndexId(int64_t index_id, DocSearchParam search_param, DocSearchResult& out_result,
+                                          StatusCallback cb) {
+  auto owned_param = std::make_shared<DocSearchParam>(std::move(search_param));
+  AsyncRunTask(new DocumentSearchTask(stub_, index_id, *owned_param, out_result), std::move(cb), owned_param);
+}
+
+void DocumentClient::AsyncDeleteByIndexId(int64_t index_id, std::vector<int64_t> doc_ids,
+                                          std::vector<DocDeleteResult>& out_result, StatusCallback cb) {
+  auto owned_ids = std::make_shared<std::vector<int64_t>>(std::move(doc_ids));
+  AsyncRunTask(new DocumentDeleteTask(stub_, index_id, *owned_ids, out_result), std::move(cb), owned_ids);
+}
+
+void DocumentClient::AsyncBatchQueryByIndexId(int64_t index_id, DocQueryParam query_param, DocQueryResult& out_result,
+                                              StatusCallback cb) {
+  auto owned_param = std::make_shared<DocQueryParam>(std::move(query_param));
+  AsyncRunTask(new DocumentBatchQueryTask(stub_, index_id, *owned_param, out_result), std::move(cb), owned_param);
+}
+
 Status DocumentClient::GetBorderByIndexId(int64_t index_id, bool is_max, int64_t& out_doc_id) {
   DocumentGetBorderTask task(stub_, index_id, is_max, out_doc_id);
   return task.Run();
@@ -14,10 +14,13 @@
 
 #include "sdk/document/document_task.h"
 
+#include <algorithm>
+
 #include "common/logging.h"
 #include "sdk/common/param_config.h"
 #include "sdk/utils/async_util.h"
 #include "sdk/common/common.h"
+#include "sdk/common/deadline.h"
 namespace dingodb {
 namespace sdk {
 
@@ -36,6 +39,12 @@ void DocumentTask::AsyncRun(StatusCallback cb) {
     call_back_.swap(cb);
   }
 
+  if (NeedTrace(call_ctx_)) {
+    span_ = Span::Start(Name(), call_ctx_);
+    call_ctx_ = span_.ChildContext(call_ctx_);
+  }
+
+  CallContextGuard ctx_guard(call_ctx_);
   Status status = Init();
   if (status.ok()) {
     DoAsync();
@@ -59,6 +68,12 @@ void DocumentTask::DoAsyncDone(const Status& status) {
 }
 
 void DocumentTask::FailOrRetry() {
+  if (IsDeadlineExpired(call_ctx_.deadline_ms)) {
+    status_ = Status::TimedOut(fmt::format("Fail task:{} deadline exceeded, last err:{}", Name(), status_.ToString()));
+    FireCallback();
+    return;
+  }
+
   if (NeedRetry()) {
     BackoffAndRetry();
   } else {
@@ -89,9 +104,15 @@ bool DocumentTask::NeedRetry() {
 }
 
 void DocumentTask::BackoffAndRetry() {
-  auto delay = retry_count_ * FLAGS_vector_op_delay_ms;
+  int64_t delay = std::min(retry_count_ * FLAGS_vector_op_delay_ms, DeadlineRemainingMs(call_ctx_.deadline_ms));
   DINGO_LOG(INFO) << "Task:" << Name() << " will retry after " << delay << "ms";
-  stub.GetActuator()->Schedule([this] { DoAsync(); }, delay);
+  stub.GetActuator()->Schedule(
+      [this, backoff_span = Span::Start("backoff", call_ctx_)]() mutable {
+        backoff_span.End(Status::OK());
+        CallContextGuard ctx_guard(call_ctx_);
+        DoAsync();
+      },
+      delay);
 }
 
 void DocumentTask::FireCallback() {
@@ -108,6 +129,8 @@ void DocumentTask::FireCallback() {
     call_back_.swap(cb);
   }
 
+  span_.End(status_);
+  CallContextGuard ctx_guard(call_ctx_);
   cb(status_);
 }
 
@@ -19,6 +19,8 @@
 #include "dingosdk/status.h"
 #include "dingosdk/types.h"
 #include "sdk/client_stub.h"
+#include "sdk/common/call_context.h"
+#include "sdk/common/tracer.h"
 #include "sdk/utils/callback.h"
 #include "sdk/utils/rw_lock.h"
 
@@ -27,7 +29,7 @@ namespace sdk {
 
 class DocumentTask {
  public:
-  DocumentTask(const ClientStub& stub) : stub(stub) {}
+  DocumentTask(const ClientStub& stub) : stub(stub), call_ctx_(CurrentCallContext()) {}
   virtual ~DocumentTask() = default;
 
   Status Run();
@@ -55,6 +57,9 @@ class DocumentTask {
   RWLock rw_lock_;
   StatusCallback call_back_;
   int retry_count_{0};
+  // captured from caller when construct, span_ become parent of new spans once started
+  CallContext call_ctx_;
+  Span span_;
 };
 
 }  // namespace sdk
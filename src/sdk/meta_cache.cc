@@ -14,9 +14,19 @@
 
 #include "sdk/meta_cache.h"
 
+#include <fcntl.h>
 #include <fmt/format.h>
-
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
 #include <string_view>
+#include <utility>
 
 #include "common/logging.h"
 #include "dingosdk/status.h"
@@ -27,26 +37,193 @@
 #include "sdk/common/common.h"
 #include "sdk/common/helper.h"
 #include "sdk/common/param_config.h"
+#include "sdk/common/tracer.h"
 #include "sdk/region.h"
 #include "sdk/rpc/coordinator_rpc.h"
 #include "sdk/utils/async_util.h"
+#include "sdk/utils/scoped_cleanup.h"
 
 namespace dingodb {
 namespace sdk {
 
 using pb::coordinator::ScanRegionInfo;
 
+// region cache file layout:
+// | magic(4) | version(4) | region_count(8) | { length(4) | ScanRegionInfo(length) } * region_count |
+static const uint32_t kRegionCacheFileMagic = 0x44535243;
+static const uint32_t kRegionCacheFileVersion = 1;
+static const size_t kRegionCacheFileHeaderSize = 16;
+
+void RegionSnapshot::Iterator::Next() {
+  if (++index_ >= snapshot_->chunks_[chunk_]->size()) {
+    ++chunk_;
+    index_ = 0;
+  }
+}
+
+RegionSnapshot::RegionSnapshot(uint64_t version, const std::vector<std::shared_ptr<Region>>& regions)
+    : version_(version) {
+  std::vector<Entry> entries;
+  entries.reserve(regions.size());
+  for (const auto& region : regions) {
+    const auto& range = region->GetRange();
+    entries.push_back({range.start_key, range.end_key, region});
+  }
+  AppendChunks(entries);
+
+  std::array<IdShard, kIdShardNum> shards;
+  for (const auto& region : regions) {
+    shards[IdShardIndex(region->RegionId())].emplace(region->RegionId(), region);
+  }
+  for (size_t i = 0; i < kIdShardNum; ++i) {
+    if (!shards[i].empty()) {
+      id_shards_[i] = std::make_shared<const IdShard>(std::move(shards[i]));
+    }
+  }
+}
+
+RegionSnapshot::RegionSnapshot(uint64_t version, const RegionSnapshot& base, const RegionByKey& region_by_key,
+                               const RegionById& region_by_id, std::vector<std::string>& dirty_keys,
+                               std::vector<int64_t>& dirty_ids)
+    : version_(version), id_shards_(base.id_shards_) {
+  std::sort(dirty_keys.begin(), dirty_keys.end());
+  dirty_keys.erase(std::unique(dirty_keys.begin(), dirty_keys.end()), dirty_keys.end());
+
+  std::vector<Entry> entries;
+  if (base.chunks_.empty()) {
+    for (const auto& [start_key, region] : region_by_key) {
+      const auto& range = region->GetRange();
+      entries.push_back({range.start_key, range.end_key, region});
+    }
+    AppendChunks(entries);
+  } else {
+    chunks_.reserve(base.chunks_.size() + 1);
+    size_t dirty_index = 0;
+    for (size_t i = 0; i < base.chunks_.size(); ++i) {
+      // chunk i covers keys in [start of chunk i, start of chunk i+1), the first and last chunk are unbounded
+      bool is_last = (i + 1 == base.chunks_.size());
+      std::string_view span_end = is_last ? std::string_view() : base.chunks_[i + 1]->front().start_key;
+
+      size_t dirty_end = dirty_index;
+      while (dirty_end < dirty_keys.size() && (is_last || dirty_keys[dirty_end] < span_end)) {
+        ++dirty_end;
+      }
+      if (dirty_end == dirty_index) {
+        size_ += base.chunks_[i]->size();
+        chunks_.push_back(base.chunks_[i]);
+        continue;
+      }
+      dirty_index = dirty_end;
+
+      auto iter = (i == 0) ? region_by_key.begin() : region_by_key.lower_bound(base.chunks_[i]->front().start_key);
+      for (; iter != region_by_key.end() && (is_last || iter->first < span_end); ++iter) {
+        const auto& range = iter->second->GetRange();
+        entries.push_back({range.start_key, range.end_key, iter->second});
+      }
+      AppendChunks(entries);
+      entries.clear();
+    }
+  }
+  dirty_keys.clear();
+
+  std::sort(dirty_ids.begin(), dirty_ids.end(),
+            [](int64_t a, int64_t b) { return IdShardIndex(a) < IdShardIndex(b); });
+  for (size_t i = 0; i < dirty_ids.size();) {
+    size_t shard_index = IdShardIndex(dirty_ids[i]);
+    auto shard = id_shards_[shard_index] == nullptr ? std::make_shared<IdShard>()
+                                                    : std::make_shared<IdShard>(*id_shards_[shard_index]);
+    for (; i < dirty_ids.size() && IdShardIndex(dirty_ids[i]) == shard_index; ++i) {
+      auto iter = region_by_id.find(dirty_ids[i]);
+      if (iter == region_by_id.end()) {
+        shard->erase(dirty_ids[i]);
+      } else {
+        (*shard)[dirty_ids[i]] = iter->second;
+      }
+    }
+    id_shards_[shard_index] = shard->empty() ? nullptr : std::move(shard);
+  }
+  dirty_ids.clear();
+}
+
+void RegionSnapshot::AppendChunks(std::vector<Entry>& entries) {
+  if (entries.empty()) {
+    return;
+  }
+
+  size_ += entries.size();
+  // split evenly, so a chunk just over kChunkSize not leave a tiny one behind
+  size_t chunk_count = (entries.size() + kChunkSize - 1) / kChunkSize;
+  size_t offset = 0;
+  for (size_t i = 0; i < chunk_count; ++i) {
+    size_t count = (entries.size() - offset) / (chunk_count - i);
+    auto chunk = std::make_shared<Chunk>(std::make_move_iterator(entries.begin() + offset),
+                                         std::make_move_iterator(entries.begin() + offset + count));
+    chunks_.push_back(std::move(chunk));
+    offset += count;
+  }
+}
+
+RegionSnapshot::Iterator RegionSnapshot::LowerBound(std::string_view key) const {
+  // first chunk whose last start_key >= key
+  auto chunk_iter = std::lower_bound(
+      chunks_.begin(), chunks_.end(), key,
+      [](const std::shared_ptr<const Chunk>& chunk, std::string_view k) { return chunk->back().start_key < k; });
+  if (chunk_iter == chunks_.end()) {
+    return Iterator(this, chunks_.size(), 0);
+  }
+
+  const auto& chunk = **chunk_iter;
+  auto iter = std::lower_bound(chunk.begin(), chunk.end(), key,
+                               [](const Entry& entry, std::string_view k) { return entry.start_key < k; });
+  return Iterator(this, chunk_iter - chunks_.begin(), iter - chunk.begin());
+}
+
+RegionSnapshot::Iterator RegionSnapshot::Floor(std::string_view key) const {
+  // last chunk whose first start_key <= key
+  auto chunk_iter = std::upper_bound(
+      chunks_.begin(), chunks_.end(), key,
+      [](std::string_view k, const std::shared_ptr<const Chunk>& chunk) { return k < chunk->front().start_key; });
+  if (chunk_iter == chunks_.begin()) {
+    return Iterator(this, chunks_.size(), 0);
+  }
+
+  chunk_iter--;
+  const auto& chunk = **chunk_iter;
+  auto iter = std::upper_bound(chunk.begin(), chunk.end(), key,
+                               [](std::string_view k, const Entry& entry) { return k < entry.start_key; });
+  return Iterator(this, chunk_iter - chunks_.begin(), (iter - chunk.begin()) - 1);
+}
+
+const RegionSnapshot::Entry* RegionSnapshot::FindByKey(std::string_view key) const {
+  auto iter = Floor(key);
+  if (!iter.Valid() || key >= iter->end_key) {
+    return nullptr;
+  }
+
+  return &(*iter);
+}
+
+const std::shared_ptr<Region>* RegionSnapshot::FindById(int64_t region_id) const {
+  const auto& shard = id_shards_[IdShardIndex(region_id)];
+  if (shard == nullptr) {
+    return nullptr;
+  }
+
+  auto iter = shard->find(region_id);
+  if (iter == shard->end()) {
+    return nullptr;
+  }
+
+  return &iter->second;
+}
+
 Status MetaCache::LookupRegionByKey(std::string_view key, std::shared_ptr<Region>& region) {
   DINGO_LOG(DEBUG) << fmt::format("LookupRegionByKey key:{}", StringToHex(key));
   CHECK(!key.empty()) << "key should not empty";
-  Status s;
-  {
-    ReadLockGuard guard(rw_lock_);
-
-    s = FastLookUpRegionByKeyUnlocked(key, region);
-    if (s.IsOK()) {
-      return s;
-    }
+  Status s = FastLookUpRegionByKeyUnlocked(key, region);
+  if (s.IsOK()) {
+    LocalLookupStats().hit_count.fetch_add(1, std::memory_order_relaxed);
+    return s;
   }
 
   s = SlowLookUpRegionByKey(key, region);
@@ -56,41 +233,155 @@ Status MetaCache::LookupRegionByKey(std::string_view key, std::shared_ptr<Region
 Status MetaCache::LookupRegionByRegionId(int64_t region_id, std::shared_ptr<Region>& region) {
   DINGO_LOG(DEBUG) << fmt::format("LookupRegionByRegionId region_id:{}", region_id);
   CHECK_GT(region_id, 0) << "region_id should bigger than 0";
-  Status s;
-  {
-    ReadLockGuard guard(rw_lock_);
-    s = FastLookUpRegionByRegionIdUnlocked(region_id, region);
-    if (s.IsOK()) {
-      return s;
-    }
+  Status s = FastLookUpRegionByRegionIdUnlocked(region_id, region);
+  if (s.IsOK()) {
+    LocalLookupStats().hit_count.fetch_add(1, std::memory_order_relaxed);
+    return s;
   }
 
   s = SlowLookUpRegionByRegionId(region_id, region);
   return s;
 }
 
+Status MetaCache::LookupRegionsByKeys(const std::vector<std::string_view>& keys, std::vector<RegionKeyGroup>& groups) {
+  DINGO_LOG(DEBUG) << fmt::format("LookupRegionsByKeys key count:{}", keys.size());
+  groups.clear();
+  if (keys.empty()) {
+    return Status::OK();
+  }
+
+  std::vector<size_t> key_indexes(keys.size());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    CHECK(!keys[i].empty()) << "key should not empty";
+    key_indexes[i] = i;
+  }
+
+  if (!std::is_sorted(keys.begin(), keys.end())) {
+    std::sort(key_indexes.begin(), key_indexes.end(), [&keys](size_t a, size_t b) { return keys[a] < keys[b]; });
+  }
+
+  std::unordered_map<int64_t, size_t> region_to_group;
+  std::vector<size_t> misses;
+  {
+    EpochReclaimer::Guard guard;
+    SweepKeysOverRegions(keys, key_indexes, *LoadSnapshot(), region_to_group, groups, misses);
+  }
+
+  auto& lookup_stats = LocalLookupStats();
+  lookup_stats.hit_count.fetch_add(static_cast<int64_t>(keys.size() - misses.size()), std::memory_order_relaxed);
+  lookup_stats.miss_count.fetch_add(static_cast<int64_t>(misses.size()), std::memory_order_relaxed);
+  if (misses.empty()) {
+    return Status::OK();
+  }
+
+  // split misses into runs of keys adjacent in sorted order, a hit key between two runs means cached regions lie in
+  // between, so each run is scanned alone instead of one scan over the whole key span
+  std::vector<std::pair<size_t, size_t>> runs;
+  size_t miss_pos = 0;
+  bool prev_miss = false;
+  for (size_t index : key_indexes) {
+    if (miss_pos < misses.size() && index == misses[miss_pos]) {
+      if (!prev_miss) {
+        runs.emplace_back(miss_pos, miss_pos);
+      }
+      runs.back().second = ++miss_pos;
+      prev_miss = true;
+    } else {
+      prev_miss = false;
+    }
+  }
+
+  DINGO_LOG(DEBUG) << fmt::format("LookupRegionsByKeys miss count:{}, run count:{}", misses.size(), runs.size());
+
+  for (const auto& run : runs) {
+    std::vector<size_t> run_misses(misses.begin() + run.first, misses.begin() + run.second);
+    DINGO_RETURN_NOT_OK(LookupMissedKeysFromRemote(keys, std::move(run_misses), region_to_group, groups));
+  }
+
+  return Status::OK();
+}
+
+Status MetaCache::LookupMissedKeysFromRemote(const std::vector<std::string_view>& keys, std::vector<size_t> misses,
+                                             std::unordered_map<int64_t, size_t>& region_to_group,
+                                             std::vector<RegionKeyGroup>& groups) {
+  while (!misses.empty()) {
+    // range [first_miss, last_miss + '\0'), keys hit at most one region each, so limit by key count
+    std::string start_key(keys[misses.front()]);
+    std::string end_key(keys[misses.back()]);
+    end_key.push_back('\0');
+    int64_t limit = static_cast<int64_t>(misses.size());
+
+    std::vector<std::shared_ptr<Region>> regions;
+    DINGO_RETURN_NOT_OK(ScanRegionsBetweenRange(start_key, end_key, limit, regions));
+
+    std::sort(regions.begin(), regions.end(), [](const std::shared_ptr<Region>& a, const std::shared_ptr<Region>& b) {
+      return a->GetRange().start_key < b->GetRange().start_key;
+    });
+
+    RegionSnapshot fetched(0, regions);
+    std::vector<size_t> still_misses;
+    SweepKeysOverRegions(keys, misses, fetched, region_to_group, groups, still_misses);
+
+    // fewer regions than limit means the whole range is scanned, keys left fall in no region
+    bool truncated = static_cast<int64_t>(regions.size()) >= limit;
+    if (!still_misses.empty() && (!truncated || still_misses.size() == misses.size())) {
+      std::string msg = fmt::format("not found region for key:{}, miss count:{}",
+                                    StringToHex(keys[still_misses.front()]), still_misses.size());
+      DINGO_LOG(WARNING) << msg;
+      return Status::NotFound(msg);
+    }
+
+    misses.swap(still_misses);
+  }
+
+  return Status::OK();
+}
+
+void MetaCache::SweepKeysOverRegions(const std::vector<std::string_view>& keys, const std::vector<size_t>& key_indexes,
+                                     const RegionSnapshot& snapshot,
+                                     std::unordered_map<int64_t, size_t>& region_to_group,
+                                     std::vector<RegionKeyGroup>& groups, std::vector<size_t>& misses) {
+  const RegionSnapshot::Entry* entry = nullptr;
+  for (size_t index : key_indexes) {
+    std::string_view key = keys[index];
+
+    // keys are sorted, adjacent keys mostly fall in the same region
+    if (entry == nullptr || key >= entry->end_key) {
+      entry = snapshot.FindByKey(key);
+    }
+
+    if (entry == nullptr || entry->region->IsStale()) {
+      misses.push_back(index);
+      continue;
+    }
+
+    int64_t region_id = entry->region->RegionId();
+    auto iter = region_to_group.find(region_id);
+    if (iter == region_to_group.end()) {
+      iter = region_to_group.emplace(region_id, groups.size()).first;
+      groups.push_back({entry->region, {}});
+    }
+    groups[iter->second].key_indexes.push_back(index);
+  }
+}
+
 Status MetaCache::LookupRegionBetweenRange(std::string_view start_key, std::string_view end_key,
                                            std::shared_ptr<Region>& region) {
   DINGO_LOG(DEBUG) << fmt::format("LookupRegionBetweenRange range: [{}, {}]", StringToHex(start_key),
                                   StringToHex(end_key));
   CHECK(!start_key.empty()) << "start_key should not empty";
   CHECK(!end_key.empty()) << "end_key should not empty";
-  Status s;
-  {
-    ReadLockGuard guard(rw_lock_);
-
-    s = FastLookUpRegionByKeyUnlocked(start_key, region);
-    if (s.IsOK()) {
-      DINGO_LOG_IF(WARNING, start_key < region->GetRange().start_key) << fmt::format(
-          "start_key is less than region start_key, range: [{}, {}], region_range: [{}, {}]", StringToHex(start_key),
-          StringToHex(end_key), StringToHex(region->GetRange().start_key), StringToHex(region->GetRange().end_key));
-
-      CHECK(end_key > region->GetRange().start_key)
-          << fmt::format("end_key should greater than region start_key, range: [{}, {}], region_range: [{}, {}]",
-                         StringToHex(start_key), StringToHex(end_key), StringToHex(region->GetRange().start_key),
-                         StringToHex(region->GetRange().end_key));
-      return s;
-    }
+  Status s = FastLookUpRegionByKeyUnlocked(start_key, region);
+  if (s.IsOK()) {
+    DINGO_LOG_IF(WARNING, start_key < region->GetRange().start_key) << fmt::format(
+        "start_key is less than region start_key, range: [{}, {}], region_range: [{}, {}]", StringToHex(start_key),
+        StringToHex(end_key), StringToHex(region->GetRange().start_key), StringToHex(region->GetRange().end_key));
+
+    CHECK(end_key > region->GetRange().start_key)
+        << fmt::format("end_key should greater than region start_key, range: [{}, {}], region_range: [{}, {}]",
+                       StringToHex(start_key), StringToHex(end_key), StringToHex(region->GetRange().start_key),
+                       StringToHex(region->GetRange().end_key));
+    return s;
   }
 
   std::vector<std::shared_ptr<Region>> regions;
@@ -111,22 +402,17 @@ Status MetaCache::LookupRegionBetweenRangeNoPrefetch(std::string_view start_key,
                                   StringToHex(end_key));
   CHECK(!start_key.empty()) << "start_key should not empty";
   CHECK(!end_key.empty()) << "end_key should not empty";
-  Status s;
-  {
-    ReadLockGuard guard(rw_lock_);
-
-    s = FastLookUpRegionByKeyUnlocked(start_key, region);
-    if (s.IsOK()) {
-      DINGO_LOG_IF(WARNING, start_key < region->GetRange().start_key) << fmt::format(
-          "start_key is less than region start_key, range: [{}, {}], region_range: [{}, {}]", StringToHex(start_key),
-          StringToHex(end_key), StringToHex(region->GetRange().start_key), StringToHex(region->GetRange().end_key));
-
-      CHECK(end_key > region->GetRange().start_key)
-          << fmt::format("end_key should greater than region start_key, range: [{}, {}], region_range: [{}, {}]",
-                         StringToHex(start_key), StringToHex(end_key), StringToHex(region->GetRange().start_key),
-                         StringToHex(region->GetRange().end_key));
-      return s;
-    }
+  Status s = FastLookUpRegionByKeyUnlocked(start_key, region);
+  if (s.IsOK()) {
+    DINGO_LOG_IF(WARNING, start_key < region->GetRange().start_key) << fmt::format(
+        "start_key is less than region start_key, range: [{}, {}], region_range: [{}, {}]", StringToHex(start_key),
+        StringToHex(end_key), StringToHex(region->GetRange().start_key), StringToHex(region->GetRange().end_key));
+
+    CHECK(end_key > region->GetRange().start_key)
+        << fmt::format("end_key should greater than region start_key, range: [{}, {}], region_range: [{}, {}]",
+                       StringToHex(start_key), StringToHex(end_key), StringToHex(region->GetRange().start_key),
+                       StringToHex(region->GetRange().end_key));
+    return s;
   }
 
   std::vector<std::shared_ptr<Region>> regions;
@@ -176,27 +462,97 @@ Status MetaCache::ScanRegionsBetweenRange(std::string_view start_key, std::strin
   return s;
 }
 
+Status MetaCache::WarmupRange(std::string_view start_key, std::string_view end_key) {
+  CHECK(!start_key.empty()) << "start_key should not empty";
+  CHECK(!end_key.empty()) << "end_key should not empty";
+  if (start_key >= end_key) {
+    return Status::InvalidArgument(
+        fmt::format("start_key must < end_key, range: [{}, {})", StringToHex(start_key), StringToHex(end_key)));
+  }
+
+  int64_t region_count = 0;
+  DINGO_RETURN_NOT_OK(LoadRange(start_key, end_key, region_count));
+
+  {
+    LockGuard guard(&warmup_mutex_);
+    warmup_ranges_[std::string(start_key)] = std::string(end_key);
+  }
+
+  DINGO_LOG(INFO) << fmt::format("warmup range: [{}, {}), region count:{}", StringToHex(start_key),
+                                 StringToHex(end_key), region_count);
+  return Status::OK();
+}
+
+Status MetaCache::RefreshWarmupRanges() {
+  std::map<std::string, std::string> ranges;
+  {
+    LockGuard guard(&warmup_mutex_);
+    ranges = warmup_ranges_;
+  }
+
+  Status ret;
+  for (const auto& [start_key, end_key] : ranges) {
+    int64_t region_count = 0;
+    Status s = LoadRange(start_key, end_key, region_count);
+    if (!s.ok()) {
+      DINGO_LOG(WARNING) << fmt::format("refresh range: [{}, {}) fail, status:{}", StringToHex(start_key),
+                                        StringToHex(end_key), s.ToString());
+      ret = s;
+    }
+  }
+
+  return ret;
+}
+
+Status MetaCache::LoadRange(std::string_view start_key, std::string_view end_key, int64_t& region_count) {
+  int64_t page_size = FLAGS_meta_cache_warmup_page_size;
+  CHECK_GT(page_size, 0) << "meta_cache_warmup_page_size should greater than 0";
+
+  region_count = 0;
+  std::string next_start(start_key);
+  while (next_start < end_key) {
+    std::vector<std::shared_ptr<Region>> regions;
+    Status s = ScanRegionsBetweenRange(next_start, end_key, page_size, regions);
+    if (s.IsNotFound()) {
+      break;
+    }
+    DINGO_RETURN_NOT_OK(s);
+
+    region_count += regions.size();
+
+    std::string_view max_end_key = regions.front()->GetRange().end_key;
+    for (const auto& region : regions) {
+      max_end_key = std::max(max_end_key, std::string_view(region->GetRange().end_key));
+    }
+
+    if (static_cast<int64_t>(regions.size()) < page_size || max_end_key <= next_start) {
+      break;
+    }
+    next_start = std::string(max_end_key);
+  }
+
+  return Status::OK();
+}
+
 Status MetaCache::ScanRegionsBetweenContinuousRange(std::string_view start_key, std::string_view end_key,
                                                     std::vector<std::shared_ptr<Region>>& regions) {
+  ScopedSpan span("meta_cache.scan_regions");
   std::vector<std::shared_ptr<Region>> to_return;
   {
-    ReadLockGuard guard(rw_lock_);
+    EpochReclaimer::Guard guard;
+    const auto* snapshot = LoadSnapshot();
 
     // find region start_key >= start_key
-    auto start_iter = region_by_key_.lower_bound(start_key);
-    if (start_iter != region_by_key_.end() && start_iter->first == start_key) {
-      // find region start_key >= end_key
-      auto end_iter = region_by_key_.lower_bound(end_key);
-      if (end_iter != region_by_key_.begin()) {
-        end_iter--;
-        if (end_iter->second->GetRange().end_key == end_key) {
-          auto iter = start_iter;
-          while (iter != end_iter) {
-            to_return.push_back(iter->second);
-            iter++;
-          }
-          to_return.push_back(end_iter->second);
-        }
+    auto iter = snapshot->LowerBound(start_key);
+    if (iter.Valid() && iter->start_key == start_key) {
+      // collect regions until start_key >= end_key
+      std::string_view last_end_key;
+      for (; iter.Valid() && iter->start_key < end_key; iter.Next()) {
+        to_return.push_back(iter->region);
+        last_end_key = iter->end_key;
+      }
+      if (last_end_key != end_key) {
+        to_return.clear();
       }
     }
   }
@@ -272,6 +628,7 @@ void MetaCache::ClearRegion(const std::shared_ptr<Region>& region) {
       DINGO_LOG(DEBUG) << fmt::format("clear region in map, old_region=[{}], target_region:[{}]", region->ToString(),
                                       iter->second->ToString());
       RemoveRegionUnlocked(region->RegionId());
+      PublishSnapshotUnlocked();
     } else {
       // record this situation
       // only one case : region was not added to the map，because region_by_id_ contain a larger version region
@@ -291,6 +648,7 @@ void MetaCache::RemoveRegion(int64_t region_id) {
 void MetaCache::RemoveRegionIfPresentUnlocked(int64_t region_id) {
   if (region_by_id_.find(region_id) != region_by_id_.end()) {
     RemoveRegionUnlocked(region_id);
+    PublishSnapshotUnlocked();
   }
 }
 
@@ -301,6 +659,7 @@ void MetaCache::ClearCache() {
   }
   region_by_key_.clear();
   region_by_id_.clear();
+  PublishSnapshotUnlocked();
 }
 
 void MetaCache::MaybeAddRegion(const std::shared_ptr<Region>& new_region) {
@@ -312,6 +671,7 @@ void MetaCache::MaybeAddRegion(const std::shared_ptr<Region>& new_region) {
   WriteLockGuard guard(rw_lock_);
 
   MaybeAddRegionUnlocked(new_region);
+  PublishSnapshotUnlocked();
 }
 
 void MetaCache::MaybeAddRegions(const std::vector<std::shared_ptr<Region>>& new_regions) {
@@ -323,6 +683,7 @@ void MetaCache::MaybeAddRegions(const std::vector<std::shared_ptr<Region>>& new_
         << new_region->ToString();
     MaybeAddRegionUnlocked(new_region);
   }
+  PublishSnapshotUnlocked();
 }
 
 void MetaCache::MaybeAddRegionUnlocked(const std::shared_ptr<Region>& new_region) {
@@ -344,34 +705,230 @@ void MetaCache::MaybeAddRegionUnlocked(const std::shared_ptr<Region>& new_region
 }
 
 Status MetaCache::FastLookUpRegionByKeyUnlocked(std::string_view key, std::shared_ptr<Region>& region) {
-  auto iter = region_by_key_.upper_bound(key);
-  if (iter == region_by_key_.begin()) {
-    return Status::NotFound(fmt::format("not found region for key:{}", key));
+  uint64_t version = 0;
+  int64_t stale_region_id = 0;
+  {
+    EpochReclaimer::Guard guard;
+    const auto* snapshot = LoadSnapshot();
+    const auto* entry = snapshot->FindByKey(key);
+    // region maybe marked stale by writer before the newer snapshot is published
+    if (entry != nullptr && !entry->region->IsStale()) {
+      // lucky we found it
+      region = entry->region;
+      return Status::OK();
+    }
+    version = snapshot->Version();
+    stale_region_id = (entry == nullptr) ? 0 : entry->region->RegionId();
   }
 
-  iter--;
-  auto found_region = iter->second;
-  CHECK(!found_region->IsStale());
+  if (stale_region_id == 0) {
+    DINGO_LOG(DEBUG) << fmt::format("not found region for key:{} in cache, snapshot version:{}", StringToHex(key),
+                                    version);
+    return Status::NotFound(fmt::format("not found region for key:{}", StringToHex(key)));
+  }
 
-  auto range = found_region->GetRange();
-  CHECK(key >= range.start_key) << fmt::format("key:{} is less than range start_key:{}, region:{}", StringToHex(key),
-                                               StringToHex(range.start_key), found_region->ToString());
+  DINGO_LOG(DEBUG) << fmt::format("found stale region:{} for key:{} in snapshot version:{}", stale_region_id,
+                                  StringToHex(key), version);
+  return Status::NotFound(fmt::format("region:{} is stale", stale_region_id));
+}
 
-  if (key >= range.end_key) {
-    std::string msg = fmt::format(
-        "not found region for key:{} in cache, key is out of bounds, nearest found_region:{} range:({}-{})",
-        StringToHex(key), found_region->RegionId(), StringToHex(range.start_key), StringToHex(range.end_key));
+size_t MetaCache::LookupStatsShardIndex() {
+  static std::atomic<size_t> next_index{0};
+  // bthread may move to another pthread, it only changes which shard is counted, sum is still right
+  static thread_local size_t index = next_index.fetch_add(1, std::memory_order_relaxed) % kLookupStatsShardNum;
+  return index;
+}
 
-    DINGO_LOG(DEBUG) << msg;
-    return Status::NotFound(msg);
-  } else {
-    // lucky we found it
-    region = found_region;
-    return Status::OK();
+MetaCacheStats MetaCache::GetStats() const {
+  MetaCacheStats stats;
+  for (const auto& shard : lookup_stats_) {
+    stats.hit_count += shard.hit_count.load(std::memory_order_relaxed);
+    stats.miss_count += shard.miss_count.load(std::memory_order_relaxed);
   }
+  stats.rpc_count = rpc_count_.load(std::memory_order_relaxed);
+  stats.coalesced_count = coalesced_count_.load(std::memory_order_relaxed);
+  return stats;
+}
+
+void MetaCache::MarkEndPointUnhealthy(const EndPoint& end_point) {
+  int64_t now_ms = TimestampMs();
+  {
+    WriteLockGuard guard(health_lock_);
+    auto iter = unhealthy_end_points_.find(end_point);
+    if (iter != unhealthy_end_points_.end() && iter->second > now_ms) {
+      // already demoted in all regions
+      return;
+    }
+    unhealthy_end_points_[end_point] = now_ms + FLAGS_store_unhealthy_duration_ms;
+    UpdateHealthTrackedCountUnlocked();
+  }
+
+  int64_t demote_count = 0;
+  for (const auto& region : SnapshotRegions()) {
+    if (region->DemoteLeader(end_point)) {
+      demote_count++;
+    }
+  }
+
+  DINGO_LOG(INFO) << fmt::format("mark endpoint:{} unhealthy, demote leader of {} regions", end_point.ToString(),
+                                 demote_count);
+}
+
+void MetaCache::RecordEndPointFailure(const EndPoint& end_point) {
+  {
+    WriteLockGuard guard(health_lock_);
+    int64_t& count = failure_counts_[end_point];
+    UpdateHealthTrackedCountUnlocked();
+    if (++count < FLAGS_store_unhealthy_failure_threshold) {
+      return;
+    }
+    count = 0;
+  }
+
+  MarkEndPointUnhealthy(end_point);
+}
+
+void MetaCache::MarkEndPointHealthy(const EndPoint& end_point) {
+  if (health_tracked_count_.load(std::memory_order_acquire) == 0) {
+    return;
+  }
+
+  {
+    ReadLockGuard guard(health_lock_);
+    if (unhealthy_end_points_.find(end_point) == unhealthy_end_points_.end() &&
+        failure_counts_.find(end_point) == failure_counts_.end()) {
+      return;
+    }
+  }
+
+  WriteLockGuard guard(health_lock_);
+  unhealthy_end_points_.erase(end_point);
+  failure_counts_.erase(end_point);
+  UpdateHealthTrackedCountUnlocked();
+}
+
+void MetaCache::UpdateHealthTrackedCountUnlocked() {
+  health_tracked_count_.store(static_cast<int64_t>(unhealthy_end_points_.size() + failure_counts_.size()),
+                              std::memory_order_release);
+}
+
+bool MetaCache::IsEndPointHealthy(const EndPoint& end_point) {
+  if (health_tracked_count_.load(std::memory_order_acquire) == 0) {
+    return true;
+  }
+
+  ReadLockGuard guard(health_lock_);
+  auto iter = unhealthy_end_points_.find(end_point);
+  return iter == unhealthy_end_points_.end() || iter->second <= static_cast<int64_t>(TimestampMs());
+}
+
+void MetaCache::PropagateLeaderHint(const EndPoint& old_leader, const EndPoint& new_leader) {
+  if (old_leader == new_leader) {
+    return;
+  }
+
+  int64_t now_ms = TimestampMs();
+  {
+    WriteLockGuard guard(health_lock_);
+    auto iter = leader_hints_.find(old_leader);
+    if (iter != leader_hints_.end() && iter->second.first == new_leader &&
+        iter->second.second + FLAGS_store_unhealthy_duration_ms > now_ms) {
+      return;
+    }
+    leader_hints_[old_leader] = {new_leader, now_ms};
+  }
+
+  int64_t transfer_count = 0;
+  for (const auto& region : SnapshotRegions()) {
+    if (region->TransferLeader(old_leader, new_leader)) {
+      transfer_count++;
+    }
+  }
+
+  DINGO_LOG(INFO) << fmt::format("propagate leader hint {} -> {}, transfer leader of {} regions",
+                                 old_leader.ToString(), new_leader.ToString(), transfer_count);
+}
+
+std::string MetaCache::UncachedRangeStart(std::string_view key) {
+  EpochReclaimer::Guard guard;
+
+  // find the last region start_key <= key
+  auto iter = LoadSnapshot()->Floor(key);
+  if (!iter.Valid()) {
+    return "";
+  }
+
+  if (key >= iter->end_key) {
+    return std::string(iter->end_key);
+  }
+
+  // key in a stale region which will be removed soon
+  return std::string(iter->start_key);
+}
+
+void MetaCache::WaitInflightLookup(const InflightLookupPtr& inflight) {
+  LockGuard guard(&inflight->mutex);
+  while (!inflight->done) {
+    inflight->cond.Wait();
+  }
+}
+
+void MetaCache::FinishInflightLookup(const InflightLookupPtr& inflight, const Status& status) {
+  LockGuard guard(&inflight->mutex);
+  inflight->status = status;
+  inflight->done = true;
+  inflight->cond.NotifyAll();
 }
 
 Status MetaCache::SlowLookUpRegionByKey(std::string_view key, std::shared_ptr<Region>& region) {
+  LocalLookupStats().miss_count.fetch_add(1, std::memory_order_relaxed);
+
+  while (true) {
+    std::string range_start = UncachedRangeStart(key);
+
+    InflightLookupPtr inflight;
+    bool is_leader = false;
+    {
+      LockGuard guard(&inflight_mutex_);
+      auto iter = inflight_by_key_.find(range_start);
+      if (iter == inflight_by_key_.end()) {
+        inflight = std::make_shared<InflightLookup>();
+        inflight_by_key_.emplace(range_start, inflight);
+        is_leader = true;
+      } else {
+        inflight = iter->second;
+      }
+    }
+
+    if (is_leader) {
+      Status s = LookUpRegionByKeyFromRemote(key, region);
+      {
+        LockGuard guard(&inflight_mutex_);
+        inflight_by_key_.erase(range_start);
+      }
+      FinishInflightLookup(inflight, s);
+      return s;
+    }
+
+    coalesced_count_.fetch_add(1, std::memory_order_relaxed);
+    WaitInflightLookup(inflight);
+    if (!inflight->status.ok() && !inflight->status.IsNotFound()) {
+      return inflight->status;
+    }
+
+    if (FastLookUpRegionByKeyUnlocked(key, region).ok()) {
+      return Status::OK();
+    }
+
+    // the region fetched by leader not contains key, lookup again in the smaller uncached range
+    DINGO_LOG(DEBUG) << fmt::format("coalesced lookup not cover key:{}, range_start:{}", StringToHex(key),
+                                    StringToHex(range_start));
+  }
+}
+
+Status MetaCache::LookUpRegionByKeyFromRemote(std::string_view key, std::shared_ptr<Region>& region) {
+  rpc_count_.fetch_add(1, std::memory_order_relaxed);
+
   ScanRegionsRpc rpc;
   rpc.MutableRequest()->set_key(std::string(key));
 
@@ -388,16 +945,61 @@ Status MetaCache::SlowLookUpRegionByKey(std::string_view key, std::shared_ptr<Re
 }
 
 Status MetaCache::FastLookUpRegionByRegionIdUnlocked(int64_t region_id, std::shared_ptr<Region>& region) {
-  auto it = region_by_id_.find(region_id);
-  if (it == region_by_id_.end()) {
-    return Status::NotFound(fmt::format("not found region for region_id:{}", region_id));
-  } else {
-    region = region_by_id_[region_id];
-    return Status::OK();
+  {
+    EpochReclaimer::Guard guard;
+    const auto* found = LoadSnapshot()->FindById(region_id);
+    if (found != nullptr && !(*found)->IsStale()) {
+      region = *found;
+      return Status::OK();
+    }
   }
+
+  return Status::NotFound(fmt::format("not found region for region_id:{}", region_id));
 }
 
 Status MetaCache::SlowLookUpRegionByRegionId(int64_t region_id, std::shared_ptr<Region>& region) {
+  LocalLookupStats().miss_count.fetch_add(1, std::memory_order_relaxed);
+
+  while (true) {
+    InflightLookupPtr inflight;
+    bool is_leader = false;
+    {
+      LockGuard guard(&inflight_mutex_);
+      auto iter = inflight_by_id_.find(region_id);
+      if (iter == inflight_by_id_.end()) {
+        inflight = std::make_shared<InflightLookup>();
+        inflight_by_id_.emplace(region_id, inflight);
+        is_leader = true;
+      } else {
+        inflight = iter->second;
+      }
+    }
+
+    if (is_leader) {
+      Status s = LookUpRegionByRegionIdFromRemote(region_id, region);
+      {
+        LockGuard guard(&inflight_mutex_);
+        inflight_by_id_.erase(region_id);
+      }
+      FinishInflightLookup(inflight, s);
+      return s;
+    }
+
+    coalesced_count_.fetch_add(1, std::memory_order_relaxed);
+    WaitInflightLookup(inflight);
+    if (!inflight->status.ok()) {
+      return inflight->status;
+    }
+
+    if (FastLookUpRegionByRegionIdUnlocked(region_id, region).ok()) {
+      return Status::OK();
+    }
+  }
+}
+
+Status MetaCache::LookUpRegionByRegionIdFromRemote(int64_t region_id, std::shared_ptr<Region>& region) {
+  rpc_count_.fetch_add(1, std::memory_order_relaxed);
+
   QueryRegionRpc rpc;
   rpc.MutableRequest()->set_region_id(region_id);
 
@@ -554,6 +1156,8 @@ void MetaCache::RemoveRegionUnlocked(int64_t region_id) {
   auto region = iter->second;
   region->MarkStale();
   region_by_id_.erase(iter);
+  dirty_ids_.push_back(region_id);
+  dirty_keys_.push_back(region->GetRange().start_key);
 
   CHECK(region_by_key_.erase(region->GetRange().start_key) == 1);
 
@@ -593,12 +1197,210 @@ void MetaCache::AddRangeToCacheUnlocked(const std::shared_ptr<Region>& region) {
   // add region to cache
   CHECK(region_by_id_.insert(std::make_pair(region->RegionId(), region)).second);
   CHECK(region_by_key_.insert(std::make_pair(region->GetRange().start_key, region)).second);
+  dirty_ids_.push_back(region->RegionId());
+  dirty_keys_.push_back(region->GetRange().start_key);
 
   region->UnMarkStale();
 
   DINGO_LOG(DEBUG) << "add region success, region:" << region->ToString();
 }
 
+void MetaCache::PublishSnapshotUnlocked() {
+  const RegionSnapshot* old_snapshot = snapshot_.load(std::memory_order_relaxed);
+  const RegionSnapshot* snapshot = nullptr;
+  if (region_by_key_.empty()) {
+    snapshot = new RegionSnapshot(++snapshot_version_, {});
+    dirty_keys_.clear();
+    dirty_ids_.clear();
+  } else {
+    snapshot =
+        new RegionSnapshot(++snapshot_version_, *old_snapshot, region_by_key_, region_by_id_, dirty_keys_, dirty_ids_);
+  }
+
+  snapshot_.store(snapshot, std::memory_order_seq_cst);
+  snapshot_reclaimer_.Retire(old_snapshot);
+}
+
+std::vector<std::shared_ptr<Region>> MetaCache::SnapshotRegions() const {
+  std::vector<std::shared_ptr<Region>> regions;
+  EpochReclaimer::Guard guard;
+  const auto* snapshot = LoadSnapshot();
+  regions.reserve(snapshot->Size());
+  for (auto iter = snapshot->Begin(); iter.Valid(); iter.Next()) {
+    regions.push_back(iter->region);
+  }
+  return regions;
+}
+
+Status MetaCache::SaveToFile(const std::string& path) {
+  auto regions = SnapshotRegions();
+
+  uint64_t region_count = regions.size();
+  std::string buf;
+  buf.append(reinterpret_cast<const char*>(&kRegionCacheFileMagic), sizeof(kRegionCacheFileMagic));
+  buf.append(reinterpret_cast<const char*>(&kRegionCacheFileVersion), sizeof(kRegionCacheFileVersion));
+  buf.append(reinterpret_cast<const char*>(&region_count), sizeof(region_count));
+
+  std::string region_buf;
+  for (const auto& region : regions) {
+    ScanRegionInfo scan_region_info;
+    RegionToScanRegionInfo(region, scan_region_info);
+
+    region_buf.clear();
+    CHECK(scan_region_info.SerializeToString(&region_buf));
+    uint32_t length = region_buf.size();
+    buf.append(reinterpret_cast<const char*>(&length), sizeof(length));
+    buf.append(region_buf);
+  }
+
+  // write to a unique tmp file in the same directory then rename, so reader never see a partial file and
+  // clients sharing the file never write into the same tmp file
+  std::string tmp_path = path + ".tmp.XXXXXX";
+  int fd = mkstemp(tmp_path.data());
+  if (fd < 0) {
+    return Status::IOError(fmt::format("create tmp file:{} fail, error:{}", tmp_path, strerror(errno)));
+  }
+
+  auto fail = [&](const std::string& op) {
+    std::string msg = fmt::format("{} file:{} fail, error:{}", op, tmp_path, strerror(errno));
+    close(fd);
+    unlink(tmp_path.c_str());
+    return Status::IOError(msg);
+  };
+
+  // mkstemp create file with 0600
+  if (fchmod(fd, 0644) != 0) {
+    return fail("chmod");
+  }
+
+  size_t written = 0;
+  while (written < buf.size()) {
+    ssize_t n = write(fd, buf.data() + written, buf.size() - written);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return fail("write");
+    }
+    written += n;
+  }
+
+  // data must be durable before rename publish it, otherwise a crash may leave an empty file behind the name
+  if (fsync(fd) != 0) {
+    return fail("fsync");
+  }
+  close(fd);
+
+  if (rename(tmp_path.c_str(), path.c_str()) != 0) {
+    std::string msg = fmt::format("rename file:{} to {} fail, error:{}", tmp_path, path, strerror(errno));
+    unlink(tmp_path.c_str());
+    return Status::IOError(msg);
+  }
+
+  DINGO_LOG(INFO) << fmt::format("save region cache to file:{}, region count:{}, size:{}", path, region_count,
+                                 buf.size());
+  return Status::OK();
+}
+
+Status MetaCache::LoadFromFile(const std::string& path) {
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return Status::IOError(fmt::format("open file:{} fail, error:{}", path, strerror(errno)));
+  }
+  SCOPED_CLEANUP({ close(fd); });
+
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    return Status::IOError(fmt::format("stat file:{} fail, error:{}", path, strerror(errno)));
+  }
+
+  size_t size = st.st_size;
+  if (size < kRegionCacheFileHeaderSize) {
+    return Status::Corruption(fmt::format("file:{} size:{} too small", path, size));
+  }
+
+  void* addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  if (addr == MAP_FAILED) {
+    return Status::IOError(fmt::format("mmap file:{} fail, error:{}", path, strerror(errno)));
+  }
+  SCOPED_CLEANUP({ munmap(addr, size); });
+
+  const char* data = static_cast<const char*>(addr);
+  uint32_t magic;
+  uint32_t version;
+  uint64_t region_count;
+  memcpy(&magic, data, sizeof(magic));
+  memcpy(&version, data + 4, sizeof(version));
+  memcpy(&region_count, data + 8, sizeof(region_count));
+  if (magic != kRegionCacheFileMagic || version != kRegionCacheFileVersion) {
+    return Status::Corruption(fmt::format("file:{} magic:{} or version:{} not match", path, magic, version));
+  }
+
+  // each region take at least its length field, reject a corrupt count before reserve
+  if (region_count > (size - kRegionCacheFileHeaderSize) / sizeof(uint32_t)) {
+    return Status::Corruption(fmt::format("file:{} size:{} too small for region count:{}", path, size, region_count));
+  }
+
+  std::vector<std::shared_ptr<Region>> regions;
+  regions.reserve(region_count);
+
+  size_t offset = kRegionCacheFileHeaderSize;
+  for (uint64_t i = 0; i < region_count; ++i) {
+    uint32_t length;
+    if (offset + sizeof(length) > size) {
+      return Status::Corruption(fmt::format("file:{} truncated at region:{}", path, i));
+    }
+    memcpy(&length, data + offset, sizeof(length));
+    offset += sizeof(length);
+
+    if (offset + length > size) {
+      return Status::Corruption(fmt::format("file:{} truncated at region:{}", path, i));
+    }
+
+    ScanRegionInfo scan_region_info;
+    if (!scan_region_info.ParseFromArray(data + offset, length) || !scan_region_info.has_range() ||
+        !scan_region_info.has_region_epoch()) {
+      return Status::Corruption(fmt::format("file:{} parse region:{} fail", path, i));
+    }
+    offset += length;
+
+    std::shared_ptr<Region> region;
+    ProcessScanRegionInfo(scan_region_info, region);
+    if (region->GetRange().start_key >= region->GetRange().end_key || region->Replicas().empty()) {
+      DINGO_LOG(WARNING) << "skip invalid region in cache file, region:" << region->ToString();
+      continue;
+    }
+    regions.push_back(std::move(region));
+  }
+
+  MaybeAddRegions(regions);
+
+  DINGO_LOG(INFO) << fmt::format("load region cache from file:{}, region count:{}", path, regions.size());
+  return Status::OK();
+}
+
+void MetaCache::RegionToScanRegionInfo(const std::shared_ptr<Region>& region, ScanRegionInfo& scan_region_info) {
+  scan_region_info.set_region_id(region->RegionId());
+
+  auto* range = scan_region_info.mutable_range();
+  range->set_start_key(region->GetRange().start_key);
+  range->set_end_key(region->GetRange().end_key);
+
+  auto* epoch = scan_region_info.mutable_region_epoch();
+  epoch->set_version(region->GetEpoch().version);
+  epoch->set_conf_version(region->GetEpoch().conf_version);
+
+  scan_region_info.mutable_status()->set_region_type(RegionTypeToPBRegionType(region->GetRegionType()));
+
+  for (const auto& replica : region->Replicas()) {
+    if (replica.role == kLeader) {
+      *scan_region_info.mutable_leader() = EndPointToLocation(replica.end_point);
+    } else {
+      *scan_region_info.add_voters() = EndPointToLocation(replica.end_point);
+    }
+  }
+}
+
 void MetaCache::Dump() {
   ReadLockGuard guard(rw_lock_);
 
@@ -606,6 +1408,8 @@ void MetaCache::Dump() {
 }
 
 void MetaCache::DumpUnlocked() {
+  DINGO_LOG(INFO) << fmt::format("snapshot version:{}", snapshot_version_);
+
   for (const auto& r : region_by_id_) {
     std::string dump = fmt::format("region_id:{}, region:{}", r.first, r.second->ToString());
     DINGO_LOG(INFO) << dump;
@@ -15,10 +15,13 @@
 #ifndef DINGODB_SDK_META_CACHE_H_
 #define DINGODB_SDK_META_CACHE_H_
 
+#include <array>
+#include <atomic>
 #include <cstdint>
 #include <map>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
@@ -28,26 +31,138 @@
 #include "sdk/region.h"
 #include "sdk/rpc/coordinator_rpc.h"
 #include "sdk/rpc/coordinator_rpc_controller.h"
+#include "sdk/utils/epoch_reclaimer.h"
+#include "sdk/utils/mutex_lock.h"
 
 namespace dingodb {
 namespace sdk {
 
 class ClientStub;
 
+// Immutable routing table of MetaCache, readers lookup without any lock or refcount, see EpochReclaimer.
+// entries sorted by start_key are split into chunks and region_by_id is split into shards,
+// a new snapshot shares every chunk and shard untouched by the mutations with the previous one,
+// so one publish costs O(chunk count + dirty chunks) instead of O(region count).
+// start_key/end_key point into the region owned by the entry.
+class RegionSnapshot {
+ public:
+  struct Entry {
+    std::string_view start_key;
+    std::string_view end_key;
+    std::shared_ptr<Region> region;
+  };
+
+  using Chunk = std::vector<Entry>;
+  using IdShard = std::unordered_map<int64_t, std::shared_ptr<Region>>;
+  using RegionByKey = std::map<std::string, std::shared_ptr<Region>, std::less<void>>;
+  using RegionById = std::unordered_map<int64_t, std::shared_ptr<Region>>;
+
+  static constexpr size_t kChunkSize = 128;
+  static constexpr size_t kIdShardNum = 64;
+
+  // forward iterator over entries in start_key order
+  class Iterator {
+   public:
+    bool Valid() const { return snapshot_ != nullptr && chunk_ < snapshot_->chunks_.size(); }
+
+    const Entry& operator*() const { return (*snapshot_->chunks_[chunk_])[index_]; }
+    const Entry* operator->() const { return &(*snapshot_->chunks_[chunk_])[index_]; }
+
+    void Next();
+
+   private:
+    friend class RegionSnapshot;
+
+    Iterator(const RegionSnapshot* snapshot, size_t chunk, size_t index)
+        : snapshot_(snapshot), chunk_(chunk), index_(index) {}
+
+    const RegionSnapshot* snapshot_;
+    size_t chunk_;
+    size_t index_;
+  };
+
+  RegionSnapshot() = default;
+
+  // build from scratch, regions must be sorted by start_key and not overlap
+  RegionSnapshot(uint64_t version, const std::vector<std::shared_ptr<Region>>& regions);
+
+  // build from base, only chunks containing dirty_keys and shards containing dirty_ids are rebuilt from
+  // region_by_key/region_by_id, dirty_keys are start_key of added or removed regions, both are cleared after build
+  RegionSnapshot(uint64_t version, const RegionSnapshot& base, const RegionByKey& region_by_key,
+                 const RegionById& region_by_id, std::vector<std::string>& dirty_keys,
+                 std::vector<int64_t>& dirty_ids);
+
+  ~RegionSnapshot() = default;
+
+  RegionSnapshot(const RegionSnapshot&) = delete;
+  const RegionSnapshot& operator=(const RegionSnapshot&) = delete;
+
+  uint64_t Version() const { return version_; }
+
+  size_t Size() const { return size_; }
+
+  Iterator Begin() const { return Iterator(this, 0, 0); }
+
+  // return the entry whose range contains key, nullptr if not found
+  const Entry* FindByKey(std::string_view key) const;
+
+  // return the first entry whose start_key >= key
+  Iterator LowerBound(std::string_view key) const;
+
+  // return the last entry whose start_key <= key, invalid if not found
+  Iterator Floor(std::string_view key) const;
+
+  // return nullptr if not found
+  const std::shared_ptr<Region>* FindById(int64_t region_id) const;
+
+ private:
+  static size_t IdShardIndex(int64_t region_id) { return static_cast<uint64_t>(region_id) % kIdShardNum; }
+
+  // append entries to chunks_, split into chunks no larger than kChunkSize
+  void AppendChunks(std::vector<Entry>& entries);
+
+  uint64_t version_{0};
+  size_t size_{0};
+  std::vector<std::shared_ptr<const Chunk>> chunks_;
+  std::array<std::shared_ptr<const IdShard>, kIdShardNum> id_shards_;
+};
+
+// keys belong to the same region, key_indexes point into the keys passed to LookupRegionsByKeys
+struct RegionKeyGroup {
+  std::shared_ptr<Region> region;
+  std::vector<size_t> key_indexes;
+};
+
+struct MetaCacheStats {
+  // lookups found in cache
+  int64_t hit_count{0};
+  // lookups not found in cache
+  int64_t miss_count{0};
+  // rpc sent to coordinator for cache miss
+  int64_t rpc_count{0};
+  // lookups waited on other in-flight rpc instead of sending its own
+  int64_t coalesced_count{0};
+};
+
 class MetaCache {
  public:
   MetaCache(const MetaCache&) = delete;
   const MetaCache& operator=(const MetaCache&) = delete;
 
   explicit MetaCache(std::shared_ptr<CoordinatorRpcController> coordinator_rpc_controller)
-      : coordinator_rpc_controller_(std::move(coordinator_rpc_controller)) {}
+      : coordinator_rpc_controller_(std::move(coordinator_rpc_controller)), snapshot_(new RegionSnapshot()) {}
 
-  ~MetaCache() = default;
+  ~MetaCache() { delete snapshot_.load(std::memory_order_relaxed); }
 
   Status LookupRegionByKey(std::string_view key, std::shared_ptr<Region>& region);
 
   Status LookupRegionByRegionId(int64_t region_id, std::shared_ptr<Region>& region);
 
+  // group keys by region, keys can be sorted or unsorted.
+  // keys are sorted once and sweep over one routing snapshot, cache misses adjacent in key order are resolved
+  // together by one ScanRegions rpc limited to the number of missed keys.
+  Status LookupRegionsByKeys(const std::vector<std::string_view>& keys, std::vector<RegionKeyGroup>& groups);
+
   // return first region between [start_key, end_key), this will prefetch regions and put into cache
   Status LookupRegionBetweenRange(std::string_view start_key, std::string_view end_key,
                                   std::shared_ptr<Region>& region);
@@ -65,6 +180,14 @@ class MetaCache {
   Status ScanRegionsBetweenContinuousRange(std::string_view start_key, std::string_view end_key,
                                            std::vector<std::shared_ptr<Region>>& regions);
 
+  // load all regions between [start_key, end_key) in pages of FLAGS_meta_cache_warmup_page_size,
+  // the range is remembered and reloaded by RefreshWarmupRanges
+  Status WarmupRange(std::string_view start_key, std::string_view end_key);
+
+  // reload regions of all warmup ranges, so split/merge are picked up before requests hit them.
+  // region with same epoch is kept as is, leader change is still learned from store response
+  Status RefreshWarmupRanges();
+
   void ClearRegion(const std::shared_ptr<Region>& region);
 
   void RemoveRegion(int64_t region_id);
@@ -75,24 +198,90 @@ class MetaCache {
   void MaybeAddRegion(const std::shared_ptr<Region>& new_region);
   void MaybeAddRegions(const std::vector<std::shared_ptr<Region>>& new_regions);
 
-  Status TEST_FastLookUpRegionByKey(std::string_view key, std::shared_ptr<Region>& region) {  // NOLINT
-    ReadLockGuard guard(rw_lock_);
+  MetaCacheStats GetStats() const;
+
+  // end_point is unreachable, demote it in all cached regions,
+  // so sibling regions pick other replica at first try instead of each paying a failed rpc
+  void MarkEndPointUnhealthy(const EndPoint& end_point);
+
+  // rpc to end_point fail in transport, mark it unhealthy after FLAGS_store_unhealthy_failure_threshold in a row
+  void RecordEndPointFailure(const EndPoint& end_point);
+
+  // also reset consecutive failure count of end_point
+  void MarkEndPointHealthy(const EndPoint& end_point);
+
+  // unhealthy end_point recover after FLAGS_store_unhealthy_duration_ms
+  bool IsEndPointHealthy(const EndPoint& end_point);
+
+  // leadership of one region moved from old_leader to new_leader,
+  // apply the hint to all cached regions led by old_leader which have new_leader as replica
+  void PropagateLeaderHint(const EndPoint& old_leader, const EndPoint& new_leader);
 
+  // save cached regions(range, epoch, replicas and last known leader) to file
+  Status SaveToFile(const std::string& path);
+
+  // load regions saved by SaveToFile, file is mapped into memory and parsed in place.
+  // NOTE: loaded regions are only hints, stale one will be corrected by store epoch error
+  Status LoadFromFile(const std::string& path);
+
+  // version of current published routing snapshot, increase on every cache mutation
+  uint64_t SnapshotVersion() const {
+    EpochReclaimer::Guard guard;
+    return LoadSnapshot()->Version();
+  }
+
+  Status TEST_FastLookUpRegionByKey(std::string_view key, std::shared_ptr<Region>& region) {  // NOLINT
     return FastLookUpRegionByKeyUnlocked(key, region);
   }
 
   void Dump();
 
  private:
-  // TODO: backoff when region not ready
+  // one in-flight coordinator rpc, concurrent misses wait on it instead of sending their own
+  struct InflightLookup {
+    Mutex mutex;
+    CondVar cond{&mutex};
+    bool done{false};
+    Status status;
+  };
+
+  using InflightLookupPtr = std::shared_ptr<InflightLookup>;
+
+  // NOTE: single-flight, concurrent misses in the same uncached range share one coordinator rpc
   Status SlowLookUpRegionByKey(std::string_view key, std::shared_ptr<Region>& region);
 
+  // TODO: backoff when region not ready
+  Status LookUpRegionByKeyFromRemote(std::string_view key, std::shared_ptr<Region>& region);
+
+  // return the start of uncached range which contains key
+  std::string UncachedRangeStart(std::string_view key);
+
+  static void WaitInflightLookup(const InflightLookupPtr& inflight);
+
+  static void FinishInflightLookup(const InflightLookupPtr& inflight, const Status& status);
+
+  // resolve key_indexes(sorted by key) by sweeping over regions(sorted by start_key),
+  // resolved keys are appended to groups, unresolved keys are appended to misses
+  static void SweepKeysOverRegions(const std::vector<std::string_view>& keys, const std::vector<size_t>& key_indexes,
+                                   const RegionSnapshot& snapshot,
+                                   std::unordered_map<int64_t, size_t>& region_to_group,
+                                   std::vector<RegionKeyGroup>& groups, std::vector<size_t>& misses);
+
+  // resolve misses(sorted by key) by ScanRegions, more rpc are sent only if the scan is truncated by limit
+  Status LookupMissedKeysFromRemote(const std::vector<std::string_view>& keys, std::vector<size_t> misses,
+                                    std::unordered_map<int64_t, size_t>& region_to_group,
+                                    std::vector<RegionKeyGroup>& groups);
+
+  // NOTE: fast lookup only read the published snapshot, no need hold rw_lock_
   Status FastLookUpRegionByKeyUnlocked(std::string_view key, std::shared_ptr<Region>& region);
 
   Status FastLookUpRegionByRegionIdUnlocked(int64_t region_id, std::shared_ptr<Region>& region);
 
+  // NOTE: single-flight, concurrent misses of the same region_id share one coordinator rpc
   Status SlowLookUpRegionByRegionId(int64_t region_id, std::shared_ptr<Region>& region);
 
+  Status LookUpRegionByRegionIdFromRemote(int64_t region_id, std::shared_ptr<Region>& region);
+
   static Status ProcessScanRegionsByKeyResponse(const ScanRegionsRpc& rpc, std::shared_ptr<Region>& region);
 
   static void ProcesssQueryRegion(const pb::common::Region& query_region, std::shared_ptr<Region>& new_region);
@@ -105,6 +294,12 @@ class MetaCache {
   static void ProcessScanRegionInfo(const pb::coordinator::ScanRegionInfo& scan_region_info,
                                     std::shared_ptr<Region>& new_region);
 
+  // paged scan all regions between [start_key, end_key) from coordinator
+  Status LoadRange(std::string_view start_key, std::string_view end_key, int64_t& region_count);
+
+  static void RegionToScanRegionInfo(const std::shared_ptr<Region>& region,
+                                     pb::coordinator::ScanRegionInfo& scan_region_info);
+
   void MaybeAddRegionUnlocked(const std::shared_ptr<Region>& new_region);
 
   void RemoveRegionIfPresentUnlocked(int64_t region_id);
@@ -114,18 +309,79 @@ class MetaCache {
 
   void AddRangeToCacheUnlocked(const std::shared_ptr<Region>& region);
 
+  // build routing snapshot from the published one and the dirty keys/ids, publish it and retire the old one,
+  // must hold write lock. batch mutations publish once after the whole batch
+  void PublishSnapshotUnlocked();
+
+  // copy regions of the published snapshot in start_key order, for work which may block on region lock
+  std::vector<std::shared_ptr<Region>> SnapshotRegions() const;
+
+  // NOTE: must be called inside EpochReclaimer::Guard, returned snapshot is valid until the guard is gone
+  const RegionSnapshot* LoadSnapshot() const { return snapshot_.load(std::memory_order_seq_cst); }
+
   void DumpUnlocked();
 
+  // must hold write lock of health_lock_
+  void UpdateHealthTrackedCountUnlocked();
+
   static bool NeedUpdateRegion(const std::shared_ptr<Region>& old_region, const std::shared_ptr<Region>& new_region);
 
   static bool NeedClearRegion(const std::shared_ptr<Region>& old_region, const std::shared_ptr<Region>& target_region);
 
   std::shared_ptr<CoordinatorRpcController> coordinator_rpc_controller_;
 
+  // rw_lock_ only serializes writers, readers use snapshot_
   RWLock rw_lock_;
   std::unordered_map<int64_t, std::shared_ptr<Region>> region_by_id_;
   // start-key -> region
   std::map<std::string, std::shared_ptr<Region>, std::less<void>> region_by_key_;
+
+  // protected by rw_lock_
+  uint64_t snapshot_version_{0};
+  // start_key of regions added or removed since last publish, protected by rw_lock_
+  std::vector<std::string> dirty_keys_;
+  // region_id of regions added or removed since last publish, protected by rw_lock_
+  std::vector<int64_t> dirty_ids_;
+  // replaced snapshots wait here until no reader pins them, protected by rw_lock_
+  EpochReclaimer snapshot_reclaimer_;
+  // written by writers under rw_lock_
+  std::atomic<const RegionSnapshot*> snapshot_;
+
+  Mutex inflight_mutex_;
+  // uncached range start -> in-flight lookup
+  std::map<std::string, InflightLookupPtr, std::less<void>> inflight_by_key_;
+  std::unordered_map<int64_t, InflightLookupPtr> inflight_by_id_;
+
+  // hit/miss are counted on every lookup, shard them by thread so readers not share one cache line
+  struct alignas(64) LookupStatsShard {
+    std::atomic<int64_t> hit_count{0};
+    std::atomic<int64_t> miss_count{0};
+  };
+  static constexpr size_t kLookupStatsShardNum = 32;
+
+  LookupStatsShard& LocalLookupStats() { return lookup_stats_[LookupStatsShardIndex()]; }
+
+  // threads are assigned shards round robin at first use
+  static size_t LookupStatsShardIndex();
+
+  std::array<LookupStatsShard, kLookupStatsShardNum> lookup_stats_;
+  std::atomic<int64_t> rpc_count_{0};
+  std::atomic<int64_t> coalesced_count_{0};
+
+  RWLock health_lock_;
+  // unhealthy end_point -> expire time ms
+  std::map<EndPoint, int64_t> unhealthy_end_points_;
+  // end_point -> consecutive transport failure count
+  std::map<EndPoint, int64_t> failure_counts_;
+  // size of unhealthy_end_points_ plus failure_counts_, MarkEndPointHealthy on every successful rpc
+  // skip health_lock_ when no end_point is tracked
+  std::atomic<int64_t> health_tracked_count_{0};
+  // old leader -> (new leader, propagate time ms), avoid propagate same hint repeatedly
+  std::map<EndPoint, std::pair<EndPoint, int64_t>> leader_hints_;
+
+  Mutex warmup_mutex_;
+  // start_key -> end_key of warmup ranges
+  std::map<std::string, std::string> warmup_ranges_;
 };
 
 }  // namespace sdk
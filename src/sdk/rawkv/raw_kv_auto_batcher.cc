@@ -0,0 +1,104 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/rawkv/raw_kv_auto_batcher.h"
+
+#include <map>
+#include <string_view>
+#include <unordered_map>
+
+#include "dingosdk/client.h"
+#include "sdk/client_stub.h"
+#include "sdk/rawkv/raw_kv_batch_get_task.h"
+#include "sdk/rawkv/raw_kv_batch_put_task.h"
+
+namespace dingodb {
+namespace sdk {
+
+RawKvAutoBatcher::RawKvAutoBatcher(const ClientStub& stub, int64_t window_us, int64_t max_batch_size)
+    : stub_(stub),
+      get_batcher_(window_us, max_batch_size, [this](std::vector<GetItem*>& items) { BatchGet(items); }),
+      put_batcher_(window_us, max_batch_size, [this](std::vector<PutItem*>& items) { BatchPut(items); }) {}
+
+Status RawKvAutoBatcher::Get(const std::string& key, std::string& out_value) {
+  GetItem item{&key, &out_value, Status::OK()};
+  get_batcher_.Submit(&item);
+  return item.status;
+}
+
+Status RawKvAutoBatcher::Put(const std::string& key, const std::string& value) {
+  PutItem item{&key, &value, Status::OK()};
+  put_batcher_.Submit(&item);
+  return item.status;
+}
+
+void RawKvAutoBatcher::BatchGet(std::vector<GetItem*>& items) {
+  // RawKvBatchGetTask reject duplicate key, callers get the same key share one slot
+  std::map<std::string_view, std::vector<GetItem*>> key_to_items;
+  for (auto* item : items) {
+    key_to_items[*item->key].push_back(item);
+  }
+
+  std::vector<std::string> keys;
+  keys.reserve(key_to_items.size());
+  for (const auto& iter : key_to_items) {
+    keys.emplace_back(iter.first);
+  }
+
+  std::vector<KVPair> kvs;
+  RawKvBatchGetTask task(stub_, keys, kvs);
+  Status s = task.Run();
+  if (!s.ok()) {
+    for (auto* item : items) {
+      item->status = s;
+    }
+    return;
+  }
+
+  for (auto& kv : kvs) {
+    auto iter = key_to_items.find(kv.key);
+    if (iter == key_to_items.end() || kv.value.empty()) {
+      continue;
+    }
+
+    for (auto* item : iter->second) {
+      *item->out_value = kv.value;
+    }
+  }
+}
+
+void RawKvAutoBatcher::BatchPut(std::vector<PutItem*>& items) {
+  // concurrent puts of the same key have no order, the last one in batch win
+  std::unordered_map<std::string_view, size_t> key_to_index;
+  std::vector<KVPair> kvs;
+  kvs.reserve(items.size());
+  for (auto* item : items) {
+    auto iter = key_to_index.find(*item->key);
+    if (iter != key_to_index.end()) {
+      kvs[iter->second].value = *item->value;
+    } else {
+      key_to_index.emplace(*item->key, kvs.size());
+      kvs.push_back({*item->key, *item->value});
+    }
+  }
+
+  RawKvBatchPutTask task(stub_, kvs);
+  Status s = task.Run();
+  for (auto* item : items) {
+    item->status = s;
+  }
+}
+
+}  // namespace sdk
+}  // namespace dingodb
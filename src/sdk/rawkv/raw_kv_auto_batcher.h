@@ -0,0 +1,66 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_RAW_KV_AUTO_BATCHER_H_
+#define DINGODB_SDK_RAW_KV_AUTO_BATCHER_H_
+
+#include <string>
+#include <vector>
+
+#include "dingosdk/status.h"
+#include "sdk/utils/auto_batcher.h"
+
+namespace dingodb {
+namespace sdk {
+
+class ClientStub;
+
+// Merge concurrent RawKV::Get/Put into RawKvBatchGetTask/RawKvBatchPutTask, which split keys by region and send one
+// KvBatchGetRpc/KvBatchPutRpc per region.
+class RawKvAutoBatcher {
+ public:
+  RawKvAutoBatcher(const ClientStub& stub, int64_t window_us, int64_t max_batch_size);
+
+  ~RawKvAutoBatcher() = default;
+
+  // same semantic as RawKvGetTask, out_value is untouched when key not found
+  Status Get(const std::string& key, std::string& out_value);
+
+  Status Put(const std::string& key, const std::string& value);
+
+ private:
+  struct GetItem {
+    const std::string* key;
+    std::string* out_value;
+    Status status;
+  };
+
+  struct PutItem {
+    const std::string* key;
+    const std::string* value;
+    Status status;
+  };
+
+  void BatchGet(std::vector<GetItem*>& items);
+  void BatchPut(std::vector<PutItem*>& items);
+
+  const ClientStub& stub_;
+  AutoBatcher<GetItem> get_batcher_;
+  AutoBatcher<PutItem> put_batcher_;
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_RAW_KV_AUTO_BATCHER_H_
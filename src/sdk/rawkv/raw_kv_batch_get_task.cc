@@ -54,55 +54,41 @@ void RawKvBatchGetTask::DoAsync() {
     return;
   }
 
-  std::unordered_map<int64_t, std::shared_ptr<Region>> region_id_to_region;
-  std::unordered_map<int64_t, std::vector<std::string_view>> region_keys;
-
-  auto meta_cache = stub.GetMetaCache();
-  for (const auto& key : next_batch) {
-    std::shared_ptr<Region> tmp;
-    Status s = meta_cache->LookupRegionByKey(key, tmp);
-    if (!s.ok()) {
-      // TODO: continue
-      DoAsyncDone(s);
-      return;
-    }
-    auto iter = region_id_to_region.find(tmp->RegionId());
-    if (iter == region_id_to_region.end()) {
-      region_id_to_region.emplace(std::make_pair(tmp->RegionId(), tmp));
-    }
-
-    region_keys[tmp->RegionId()].push_back(key);
+  std::vector<std::string_view> keys(next_batch.begin(), next_batch.end());
+  std::vector<RegionKeyGroup> groups;
+  Status s = stub.GetMetaCache()->LookupRegionsByKeys(keys, groups);
+  if (!s.ok()) {
+    // TODO: continue
+    DoAsyncDone(s);
+    return;
   }
 
   controllers_.clear();
   rpcs_.clear();
 
-  for (const auto& entry : region_keys) {
-    auto region_id = entry.first;
-
-    auto iter = region_id_to_region.find(region_id);
-    CHECK(iter != region_id_to_region.end());
-    auto region = iter->second;
+  for (const auto& group : groups) {
+    const auto& region = group.region;
 
     auto rpc = std::make_unique<KvBatchGetRpc>();
-    FillRpcContext(*rpc->MutableRequest()->mutable_context(), region_id, region->GetEpoch());
-    for (const auto& key : entry.second) {
+    FillRpcContext(*rpc->MutableRequest()->mutable_context(), region->RegionId(), region->GetEpoch());
+    for (auto index : group.key_indexes) {
       auto* fill = rpc->MutableRequest()->add_keys();
-      *fill = key;
+      *fill = keys[index];
     }
 
     StoreRpcController controller(stub, *rpc, region);
+    controller.SetReadOnly(true);
     controllers_.push_back(controller);
 
     rpcs_.push_back(std::move(rpc));
   }
 
-  CHECK_EQ(rpcs_.size(), region_keys.size());
+  CHECK_EQ(rpcs_.size(), groups.size());
   CHECK_EQ(rpcs_.size(), controllers_.size());
 
-  sub_tasks_count_.store(region_keys.size());
+  sub_tasks_count_.store(groups.size());
 
-  for (auto i = 0; i < region_keys.size(); i++) {
+  for (auto i = 0; i < groups.size(); i++) {
     auto& controller = controllers_[i];
 
     controller.AsyncCall(
@@ -17,6 +17,7 @@
 #include "dingosdk/client.h"
 #include "dingosdk/status.h"
 #include "sdk/common/common.h"
+#include "sdk/common/param_config.h"
 
 namespace dingodb {
 namespace sdk {
@@ -51,67 +52,81 @@ void RawKvBatchPutTask::DoAsync() {
     return;
   }
 
-  std::unordered_map<int64_t, std::shared_ptr<Region>> region_id_to_region;
-  std::unordered_map<int64_t, std::vector<std::string_view>> region_keys;
-
-  auto meta_cache = stub.GetMetaCache();
-
-  for (const auto& key : next_batch) {
-    std::shared_ptr<Region> tmp;
-    Status s = meta_cache->LookupRegionByKey(key, tmp);
-    if (!s.ok()) {
-      // TODO: continue
-      DoAsyncDone(s);
-      return;
-    }
-    auto iter = region_id_to_region.find(tmp->RegionId());
-    if (iter == region_id_to_region.end()) {
-      region_id_to_region.emplace(std::make_pair(tmp->RegionId(), tmp));
+  std::vector<std::string_view> keys;
+  std::vector<const KVPair*> kvs;
+  keys.reserve(next_batch.size());
+  kvs.reserve(next_batch.size());
+  for (const auto& kv : kvs_) {
+    if (next_batch.find(kv.key) != next_batch.end()) {
+      keys.emplace_back(kv.key);
+      kvs.push_back(&kv);
     }
+  }
 
-    region_keys[tmp->RegionId()].push_back(key);
+  std::vector<RegionKeyGroup> groups;
+  Status s = stub.GetMetaCache()->LookupRegionsByKeys(keys, groups);
+  if (!s.ok()) {
+    // TODO: continue
+    DoAsyncDone(s);
+    return;
   }
 
   controllers_.clear();
   rpcs_.clear();
+  window_.Reset(FLAGS_raw_kv_batch_write_window_per_store);
+
+  // split kvs of each region into rpcs bounded by count and bytes
+  for (const auto& group : groups) {
+    const auto& region = group.region;
+    std::string store = RawKvRpcWindow::StoreOf(region);
+
+    std::unique_ptr<KvBatchPutRpc> rpc;
+    int64_t rpc_bytes = 0;
+    for (auto index : group.key_indexes) {
+      const auto* kv = kvs[index];
+      int64_t kv_bytes = kv->key.size() + kv->value.size();
+      if (rpc != nullptr && (rpc->Request()->kvs_size() >= FLAGS_raw_kv_batch_write_max_count ||
+                             rpc_bytes + kv_bytes > FLAGS_raw_kv_batch_write_max_bytes)) {
+        window_.Add(store, rpcs_.size());
+        controllers_.emplace_back(stub, *rpc, region);
+        rpcs_.push_back(std::move(rpc));
+      }
+
+      if (rpc == nullptr) {
+        rpc = std::make_unique<KvBatchPutRpc>();
+        FillRpcContext(*rpc->MutableRequest()->mutable_context(), region->RegionId(), region->GetEpoch());
+        rpc_bytes = 0;
+      }
 
-  for (const auto& entry : region_keys) {
-    auto region_id = entry.first;
-
-    auto iter = region_id_to_region.find(region_id);
-    CHECK(iter != region_id_to_region.end());
-    auto region = iter->second;
-
-    auto rpc = std::make_unique<KvBatchPutRpc>();
-    FillRpcContext(*rpc->MutableRequest()->mutable_context(), region_id, region->GetEpoch());
-    for (const auto& key : entry.second) {
-      auto kv = std::find_if(kvs_.begin(), kvs_.end(), [&](const KVPair& kv) { return kv.key == key; });
-      CHECK(kv != kvs_.end()) << "can't find key:" << key;
       auto* fill = rpc->MutableRequest()->add_kvs();
       fill->set_key(kv->key);
       fill->set_value(kv->value);
+      rpc_bytes += kv_bytes;
     }
 
-    StoreRpcController controller(stub, *rpc, region);
-    controllers_.push_back(controller);
-
-    rpcs_.push_back(std::move(rpc));
+    if (rpc != nullptr) {
+      window_.Add(store, rpcs_.size());
+      controllers_.emplace_back(stub, *rpc, region);
+      rpcs_.push_back(std::move(rpc));
+    }
   }
 
-  CHECK_EQ(rpcs_.size(), region_keys.size());
   CHECK_EQ(rpcs_.size(), controllers_.size());
 
-  sub_tasks_count_.store(region_keys.size());
+  sub_tasks_count_.store(rpcs_.size());
 
-  for (auto i = 0; i < region_keys.size(); i++) {
-    auto& controller = controllers_[i];
-
-    controller.AsyncCall(
-        [this, rpc = rpcs_[i].get()](auto&& s) { KvBatchPutRpcCallback(std::forward<decltype(s)>(s), rpc); });
+  for (auto index : window_.Start()) {
+    SendRpc(index);
   }
 }
 
-void RawKvBatchPutTask::KvBatchPutRpcCallback(const Status& status, KvBatchPutRpc* rpc) {
+void RawKvBatchPutTask::SendRpc(size_t index) {
+  controllers_[index].AsyncCall(
+      [this, index](auto&& s) { KvBatchPutRpcCallback(std::forward<decltype(s)>(s), index); });
+}
+
+void RawKvBatchPutTask::KvBatchPutRpcCallback(const Status& status, size_t index) {
+  auto* rpc = rpcs_[index].get();
   if (!status.ok()) {
     DINGO_LOG(WARNING) << "rpc: " << rpc->Method() << " send to region: " << rpc->Request()->context().region_id()
                        << " fail: " << status.ToString();
@@ -128,6 +143,12 @@ void RawKvBatchPutTask::KvBatchPutRpcCallback(const Status& status, KvBatchPutRp
     }
   }
 
+  // keep the store busy, failed kvs stay in next_keys_ and only they are sent again on retry
+  size_t next_index;
+  if (window_.Next(index, next_index)) {
+    SendRpc(next_index);
+  }
+
   if (sub_tasks_count_.fetch_sub(1) == 1) {
     Status tmp;
     {
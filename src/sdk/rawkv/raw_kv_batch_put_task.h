@@ -18,6 +18,7 @@
 #include <vector>
 
 #include "sdk/client_stub.h"
+#include "sdk/rawkv/raw_kv_rpc_window.h"
 #include "sdk/rawkv/raw_kv_task.h"
 #include "sdk/rpc/store_rpc.h"
 #include "sdk/rpc/store_rpc_controller.h"
@@ -38,11 +39,13 @@ class RawKvBatchPutTask : public RawKvTask {
 
   std::string Name() const override { return "RawKvBatchPutTask"; }
 
-  void KvBatchPutRpcCallback(const Status& status, KvBatchPutRpc* rpc);
+  void SendRpc(size_t index);
+  void KvBatchPutRpcCallback(const Status& status, size_t index);
 
   const std::vector<KVPair>& kvs_;
   std::vector<StoreRpcController> controllers_;
   std::vector<std::unique_ptr<KvBatchPutRpc>> rpcs_;
+  RawKvRpcWindow window_;
 
   RWLock rw_lock_;
   std::set<std::string_view> next_keys_;
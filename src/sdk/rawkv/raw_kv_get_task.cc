@@ -22,7 +22,9 @@ namespace dingodb {
 namespace sdk {
 
 RawKvGetTask::RawKvGetTask(const ClientStub& stub, const std::string& key, std::string& out_value)
-    : RawKvTask(stub), key_(key), out_value_(out_value), store_rpc_controller_(stub, rpc_) {}
+    : RawKvTask(stub), key_(key), out_value_(out_value), store_rpc_controller_(stub, rpc_) {
+  store_rpc_controller_.SetReadOnly(true);
+}
 
 void RawKvGetTask::DoAsync() {
   std::shared_ptr<MetaCache> meta_cache = stub.GetMetaCache();
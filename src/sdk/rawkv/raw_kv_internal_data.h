@@ -15,8 +15,12 @@
 #ifndef DINGODB_SDK_RAW_KV_DATA_H_
 #define DINGODB_SDK_RAW_KV_DATA_H_
 
+#include <memory>
+#include <utility>
+
 #include "dingosdk/client.h"
 #include "sdk/client_stub.h"
+#include "sdk/rawkv/raw_kv_iterator.h"
 
 namespace dingodb {
 namespace sdk {
@@ -32,6 +36,17 @@ class RawKV::Data {
   const ClientStub& stub;
 };
 
+class RawKVIterator::Data {
+ public:
+  Data(const Data&) = delete;
+  const Data& operator=(const Data&) = delete;
+
+  explicit Data(std::unique_ptr<RawKvIteratorImpl> impl) : impl(std::move(impl)) {}
+  ~Data() = default;
+
+  std::unique_ptr<RawKvIteratorImpl> impl;
+};
+
 }  // namespace sdk
 }  // namespace dingodb
 
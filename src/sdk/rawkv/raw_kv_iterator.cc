@@ -0,0 +1,218 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/rawkv/raw_kv_iterator.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "common/logging.h"
+#include "fmt/core.h"
+#include "glog/logging.h"
+#include "sdk/common/backoff.h"
+#include "sdk/common/common.h"
+#include "sdk/common/param_config.h"
+
+namespace dingodb {
+namespace sdk {
+
+static int64_t KvsBytes(const std::vector<KVPair>& kvs) {
+  int64_t bytes = 0;
+  for (const auto& kv : kvs) {
+    bytes += kv.key.size() + kv.value.size();
+  }
+  return bytes;
+}
+
+RawKvIteratorImpl::RawKvIteratorImpl(const ClientStub& stub, std::string start_key, std::string end_key,
+                                     const RawKVIteratorOptions& options)
+    : stub_(stub),
+      start_key_(std::move(start_key)),
+      end_key_(std::move(end_key)),
+      options_(options),
+      next_start_key_(start_key_) {}
+
+RawKvIteratorImpl::~RawKvIteratorImpl() {
+  // fetch chain use this, wait it out
+  if (prefetch_sync_ != nullptr) {
+    prefetch_sync_->Wait();
+  }
+}
+
+Status RawKvIteratorImpl::Init() {
+  StartPrefetch();
+  WaitPrefetch();
+  MaybeStartPrefetch();
+  return status_;
+}
+
+void RawKvIteratorImpl::Next() {
+  CHECK(Valid()) << "iterator is not valid";
+  if (++pos_ < current_kvs_.size()) {
+    return;
+  }
+
+  current_kvs_.clear();
+  current_bytes_ = 0;
+  pos_ = 0;
+  if (reach_end_) {
+    return;
+  }
+
+  // prefetch is skipped when current batch is too large
+  if (prefetch_sync_ == nullptr) {
+    StartPrefetch();
+  }
+  WaitPrefetch();
+  MaybeStartPrefetch();
+}
+
+void RawKvIteratorImpl::StartPrefetch() {
+  CHECK(prefetch_sync_ == nullptr) << "prefetch is already in flight";
+  prefetch_sync_ = std::make_unique<Synchronizer>();
+  prefetch_kvs_.clear();
+  AsyncFetch(prefetch_kvs_, prefetch_sync_->AsStatusCallBack(prefetch_status_));
+}
+
+void RawKvIteratorImpl::WaitPrefetch() {
+  CHECK(prefetch_sync_ != nullptr) << "no prefetch in flight";
+  prefetch_sync_->Wait();
+  prefetch_sync_.reset();
+
+  status_ = prefetch_status_;
+  if (!status_.ok()) {
+    DINGO_LOG(WARNING) << fmt::format("raw kv iterator fail between [{},{}), next_start:{}, status:{}", start_key_,
+                                      end_key_, next_start_key_, status_.ToString());
+    return;
+  }
+
+  current_kvs_ = std::move(prefetch_kvs_);
+  prefetch_kvs_.clear();
+  current_bytes_ = KvsBytes(current_kvs_);
+  pos_ = 0;
+  reach_end_ = current_kvs_.empty();
+}
+
+void RawKvIteratorImpl::MaybeStartPrefetch() {
+  if (!status_.ok() || reach_end_ || prefetch_sync_ != nullptr) {
+    return;
+  }
+
+  if (options_.buffer_bytes > 0 && current_bytes_ * 2 > options_.buffer_bytes) {
+    return;
+  }
+
+  StartPrefetch();
+}
+
+void RawKvIteratorImpl::AsyncFetch(std::vector<KVPair>& kvs, StatusCallback cb) {
+  if (scanner_ != nullptr && scanner_->HasMore()) {
+    kvs.clear();
+    // scanner is captured to outlive its own callback, scanner_ may be reset inside
+    scanner_->AsyncNextBatch(kvs, [this, scanner = scanner_, &kvs, cb](Status s) {
+      FetchCallback(std::move(s), kvs, cb);
+    });
+    return;
+  }
+
+  if (scanner_ != nullptr) {
+    next_start_key_ = scanner_end_key_;
+    scanner_.reset();
+  }
+
+  if (next_start_key_ >= end_key_) {
+    cb(Status::OK());
+    return;
+  }
+
+  OpenNextRegion(kvs, std::move(cb));
+}
+
+void RawKvIteratorImpl::OpenNextRegion(std::vector<KVPair>& kvs, StatusCallback cb) {
+  std::shared_ptr<Region> region;
+  Status status = stub_.GetMetaCache()->LookupRegionBetweenRange(next_start_key_, end_key_, region);
+  if (status.IsNotFound()) {
+    DINGO_LOG(INFO) << fmt::format("region not found between [{},{}), iterate end", next_start_key_, end_key_);
+    next_start_key_ = end_key_;
+    cb(Status::OK());
+    return;
+  }
+
+  if (!status.ok()) {
+    cb(status);
+    return;
+  }
+
+  std::string scanner_start_key = std::max(next_start_key_, region->GetRange().start_key);
+  scanner_end_key_ = std::min(end_key_, region->GetRange().end_key);
+  ScannerOptions options(stub_, region, scanner_start_key, scanner_end_key_);
+  options.key_only = options_.key_only;
+  CHECK(stub_.GetRawKvRegionScannerFactory()->NewRegionScanner(options, scanner_).IsOK());
+
+  scanner_->AsyncOpen([this, scanner = scanner_, &kvs, cb](Status s) {
+    if (!s.ok()) {
+      DINGO_LOG(WARNING) << fmt::format("region scanner open fail, region:{}, status:{}",
+                                        scanner->GetRegion()->RegionId(), s.ToString());
+      if (!RetryFetch(s, kvs, cb)) {
+        cb(s);
+      }
+      return;
+    }
+
+    AsyncFetch(kvs, cb);
+  });
+}
+
+void RawKvIteratorImpl::FetchCallback(Status status, std::vector<KVPair>& kvs, StatusCallback cb) {
+  if (!status.ok()) {
+    if (!RetryFetch(status, kvs, cb)) {
+      cb(status);
+    }
+    return;
+  }
+
+  retry_count_ = 0;
+  if (kvs.empty()) {
+    // region end, move on to next region
+    AsyncFetch(kvs, std::move(cb));
+    return;
+  }
+
+  // the smallest key greater than last fetched key, reopen from it when region changed
+  next_start_key_ = kvs.back().key + std::string(1, '\0');
+  cb(Status::OK());
+}
+
+bool RawKvIteratorImpl::RetryFetch(const Status& status, std::vector<KVPair>& kvs, StatusCallback cb) {
+  if (!status.IsIncomplete() || !IsRetryErrorCode(status.Errno())) {
+    return false;
+  }
+
+  if (++retry_count_ >= FLAGS_raw_kv_max_retry) {
+    return false;
+  }
+
+  // region split or moved, reopen scanner from next_start_key_ with refreshed route
+  scanner_.reset();
+  int64_t delay_ms = FullJitterBackoffMs(BackoffBaseMs(kBackoffRegionEpoch), FLAGS_raw_kv_delay_ms, retry_count_ - 1);
+  stub_.GetActuator()->Schedule([this, &kvs, cb]() { AsyncFetch(kvs, cb); }, delay_ms);
+  return true;
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,97 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_RAW_KV_ITERATOR_H_
+#define DINGODB_SDK_RAW_KV_ITERATOR_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "dingosdk/client.h"
+#include "dingosdk/status.h"
+#include "sdk/client_stub.h"
+#include "sdk/region_scanner.h"
+#include "sdk/utils/async_util.h"
+#include "sdk/utils/callback.h"
+
+namespace dingodb {
+namespace sdk {
+
+// Double buffered cursor over region scanners: user consume current_kvs_ while prefetch_kvs_ is filled in background.
+// Fields used by fetch chain(scanner_, next_start_key_ ...) are only read by user thread after the fetch is waited,
+// so they need no lock.
+class RawKvIteratorImpl {
+ public:
+  RawKvIteratorImpl(const ClientStub& stub, std::string start_key, std::string end_key,
+                    const RawKVIteratorOptions& options);
+
+  ~RawKvIteratorImpl();
+
+  RawKvIteratorImpl(const RawKvIteratorImpl&) = delete;
+  const RawKvIteratorImpl& operator=(const RawKvIteratorImpl&) = delete;
+
+  // fetch first batch
+  Status Init();
+
+  bool Valid() const { return status_.ok() && pos_ < current_kvs_.size(); }
+
+  void Next();
+
+  const std::string& Key() const { return current_kvs_[pos_].key; }
+
+  const std::string& Value() const { return current_kvs_[pos_].value; }
+
+  Status GetStatus() const { return status_; }
+
+ private:
+  void StartPrefetch();
+  // wait prefetch and make it current batch
+  void WaitPrefetch();
+  void MaybeStartPrefetch();
+
+  // fill kvs with next non empty batch, kvs is empty when reach end
+  void AsyncFetch(std::vector<KVPair>& kvs, StatusCallback cb);
+  void OpenNextRegion(std::vector<KVPair>& kvs, StatusCallback cb);
+  void FetchCallback(Status status, std::vector<KVPair>& kvs, StatusCallback cb);
+  bool RetryFetch(const Status& status, std::vector<KVPair>& kvs, StatusCallback cb);
+
+  const ClientStub& stub_;
+  const std::string start_key_;
+  const std::string end_key_;
+  const RawKVIteratorOptions options_;
+
+  Status status_;
+  std::vector<KVPair> current_kvs_;
+  size_t pos_{0};
+  int64_t current_bytes_{0};
+  bool reach_end_{false};
+
+  std::unique_ptr<Synchronizer> prefetch_sync_;
+  Status prefetch_status_;
+  std::vector<KVPair> prefetch_kvs_;
+
+  // used by fetch chain
+  std::shared_ptr<RegionScanner> scanner_;
+  std::string scanner_end_key_;
+  // where to open next region scanner
+  std::string next_start_key_;
+  int retry_count_{0};
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_RAW_KV_ITERATOR_H_
@@ -30,13 +30,14 @@ namespace dingodb {
 namespace sdk {
 
 RawKvRegionScannerImpl::RawKvRegionScannerImpl(const ClientStub& stub, std::shared_ptr<Region> region,
-                                               std::string start_key, std::string end_key)
+                                               std::string start_key, std::string end_key, bool key_only)
     : RegionScanner(stub, std::move(region)),
       start_key_(std::move(start_key)),
       end_key_(std::move(end_key)),
+      key_only_(key_only),
       opened_(false),
       has_more_(false),
-      batch_size_(FLAGS_scan_batch_size) {}
+      batch_sizer_(FLAGS_scan_batch_size) {}
 
 static void RawKvRegionScannerImplDeleted(Status status, std::string scan_id) {
   VLOG(kSdkVlogLevel) << "RawKvRegionScannerImpl deleted, scanner id: " << scan_id << " status:" << status.ToString();
@@ -57,7 +58,7 @@ void RawKvRegionScannerImpl::PrepareScanBegionRpc(KvScanBeginRpc& rpc) {
   range_with_option->set_with_end(false);
 
   request->set_max_fetch_cnt(0);
-  request->set_key_only(false);
+  request->set_key_only(key_only_);
   // TODO: maybe we should support scan keep_alive
   request->set_disable_auto_release(false);
   request->set_disable_coprocessor(true);
@@ -146,7 +147,7 @@ void RawKvRegionScannerImpl::PrepareScanContinueRpc(KvScanContinueRpc& rpc) {
   auto* request = rpc.MutableRequest();
   FillRpcContext(*request->mutable_context(), region->RegionId(), region->GetEpoch());
   request->set_scan_id(scan_id_);
-  request->set_max_fetch_cnt(batch_size_);
+  request->set_max_fetch_cnt(batch_sizer_.BatchSize());
 }
 
 void RawKvRegionScannerImpl::AsyncNextBatch(std::vector<KVPair>& kvs, StatusCallback cb) {
@@ -176,13 +177,16 @@ void RawKvRegionScannerImpl::KvScanContinueRpcCallback(Status status, StoreRpcCo
       // scan to region end_key
       has_more_ = false;
     } else {
+      int64_t bytes = 0;
       for (const auto& kv : response->kvs()) {
+        bytes += kv.key().size() + kv.value().size();
         if (kv.key() < end_key_) {
           tmp_kvs.push_back({kv.key(), kv.value()});
         } else {
           has_more_ = false;
         }
       }
+      batch_sizer_.OnResponse(response->kvs_size(), bytes);
     }
 
     kvs = std::move(tmp_kvs);
@@ -203,16 +207,7 @@ Status RawKvRegionScannerImpl::NextBatch(std::vector<KVPair>& kvs) {
 }
 
 Status RawKvRegionScannerImpl::SetBatchSize(int64_t size) {
-  uint64_t to_size = size;
-  if (size <= kMinScanBatchSize) {
-    to_size = kMinScanBatchSize;
-  }
-
-  if (size > kMaxScanBatchSize) {
-    to_size = kMaxScanBatchSize;
-  }
-
-  batch_size_ = to_size;
+  batch_sizer_.Fix(size);
   return Status::OK();
 }
 
@@ -230,7 +225,7 @@ Status RawKvRegionScannerFactoryImpl::NewRegionScanner(const ScannerOptions& opt
       "end_key:{} should little than region range end_key:{}", options.end_key, options.region->GetRange().end_key);
 
   std::shared_ptr<RegionScanner> tmp(
-      new RawKvRegionScannerImpl(options.stub, options.region, options.start_key, options.end_key));
+      new RawKvRegionScannerImpl(options.stub, options.region, options.start_key, options.end_key, options.key_only));
   scanner = std::move(tmp);
 
   return Status::OK();
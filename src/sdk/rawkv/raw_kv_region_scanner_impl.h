@@ -26,6 +26,7 @@
 #include "sdk/region_scanner.h"
 #include "sdk/rpc/store_rpc.h"
 #include "sdk/rpc/store_rpc_controller.h"
+#include "sdk/utils/scan_batch_sizer.h"
 
 namespace dingodb {
 namespace sdk {
@@ -36,7 +37,7 @@ class TestBase;
 class RawKvRegionScannerImpl : public RegionScanner {
  public:
   explicit RawKvRegionScannerImpl(const ClientStub& stub, std::shared_ptr<Region> region, std::string start_key,
-                                  std::string end_key);
+                                  std::string end_key, bool key_only = false);
 
   ~RawKvRegionScannerImpl() override;
 
@@ -56,7 +57,7 @@ class RawKvRegionScannerImpl : public RegionScanner {
 
   Status SetBatchSize(int64_t size) override;
 
-  int64_t GetBatchSize() const override { return batch_size_; }
+  int64_t GetBatchSize() const override { return batch_sizer_.BatchSize(); }
 
   bool TEST_IsOpen() {  // NOLINT
     return opened_;
@@ -77,7 +78,8 @@ class RawKvRegionScannerImpl : public RegionScanner {
 
   std::string start_key_;
   std::string end_key_;
-  int64_t batch_size_;
+  bool key_only_;
+  ScanBatchSizer batch_sizer_;
   bool opened_;
   std::string scan_id_;
   bool has_more_;
@@ -0,0 +1,98 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_RAW_KV_RPC_WINDOW_H_
+#define DINGODB_SDK_RAW_KV_RPC_WINDOW_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "glog/logging.h"
+#include "sdk/region.h"
+#include "sdk/utils/mutex_lock.h"
+#include "sdk/utils/net_util.h"
+
+namespace dingodb {
+namespace sdk {
+
+// Bound in-flight rpcs of each store for batch write, so one big call does not flood a store and a slow store only
+// hold back its own rpcs. Rpcs are identified by index in order of Add, rpcs of a store are sent in that order.
+class RawKvRpcWindow {
+ public:
+  RawKvRpcWindow() = default;
+  ~RawKvRpcWindow() = default;
+
+  RawKvRpcWindow(const RawKvRpcWindow&) = delete;
+  const RawKvRpcWindow& operator=(const RawKvRpcWindow&) = delete;
+
+  // rpcs are grouped by the leader they are sent to, only peek so grouping does not rotate the replica to try
+  static std::string StoreOf(const std::shared_ptr<Region>& region) { return region->PeekLeader().ToString(); }
+
+  void Reset(int64_t size_per_store) {
+    LockGuard guard(&mutex_);
+    size_per_store_ = std::max(size_per_store, static_cast<int64_t>(1));
+    store_of_.clear();
+    pending_.clear();
+  }
+
+  void Add(const std::string& store, size_t index) {
+    LockGuard guard(&mutex_);
+    CHECK_EQ(index, store_of_.size()) << "rpc must be added in index order";
+    store_of_.push_back(store);
+    pending_[store].push_back(index);
+  }
+
+  // rpcs to send at first, at most size_per_store of each store
+  std::vector<size_t> Start() {
+    LockGuard guard(&mutex_);
+    std::vector<size_t> to_send;
+    for (auto& [store, indexes] : pending_) {
+      for (int64_t i = 0; i < size_per_store_ && !indexes.empty(); ++i) {
+        to_send.push_back(indexes.front());
+        indexes.pop_front();
+      }
+    }
+    return to_send;
+  }
+
+  // rpc of done_index returned, take the next rpc of same store, false when the store has no more
+  bool Next(size_t done_index, size_t& next_index) {
+    LockGuard guard(&mutex_);
+    CHECK_LT(done_index, store_of_.size());
+    auto& indexes = pending_[store_of_[done_index]];
+    if (indexes.empty()) {
+      return false;
+    }
+
+    next_index = indexes.front();
+    indexes.pop_front();
+    return true;
+  }
+
+ private:
+  Mutex mutex_;
+  int64_t size_per_store_{1};
+  std::vector<std::string> store_of_;
+  std::map<std::string, std::deque<size_t>> pending_;
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_RAW_KV_RPC_WINDOW_H_
@@ -14,17 +14,39 @@
 
 #include "sdk/rawkv/raw_kv_scan_task.h"
 
+#include <algorithm>
 #include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 
+#include "sdk/common/param_config.h"
 #include "sdk/rawkv/raw_kv_task.h"
 #include "sdk/region_scanner.h"
+#include "sdk/utils/mutex_lock.h"
 
 namespace dingodb {
 namespace sdk {
 
 RawKvScanTask::RawKvScanTask(const ClientStub& stub, const std::string& start_key, const std::string& end_key,
-                             uint64_t limit, std::vector<KVPair>& out_kvs)
-    : RawKvTask(stub), start_key_(start_key), end_key_(end_key), limit_(limit), out_kvs_(out_kvs) {}
+                             uint64_t limit, std::vector<KVPair>& out_kvs, bool key_only)
+    : RawKvTask(stub),
+      start_key_(start_key),
+      end_key_(end_key),
+      limit_(limit),
+      out_kvs_(&out_kvs),
+      out_count_(nullptr),
+      key_only_(key_only) {}
+
+RawKvScanTask::RawKvScanTask(const ClientStub& stub, const std::string& start_key, const std::string& end_key,
+                             int64_t& out_count)
+    : RawKvTask(stub),
+      start_key_(start_key),
+      end_key_(end_key),
+      limit_(0),
+      out_kvs_(nullptr),
+      out_count_(&out_count),
+      key_only_(true) {}
 
 Status RawKvScanTask::Init() {
   auto meta_cache = stub.GetMetaCache();
@@ -51,7 +73,11 @@ void RawKvScanTask::DoAsync() {
   CHECK(!next_start_key_.empty()) << "next_start_key_ should not empty";
   CHECK(next_start_key_ < end_key_) << fmt::format("next_start_key_:{} should less than end_key_:{}", next_start_key_,
                                                    end_key_);
-  ScanNext();
+  if (RegionConcurrency() > 1) {
+    ParallelScan();
+  } else {
+    ScanNext();
+  }
 }
 
 void RawKvScanTask::ScanNext() {
@@ -92,6 +118,7 @@ void RawKvScanTask::ScanNext() {
       next_start_key_ <= region->GetRange().start_key ? region->GetRange().start_key : next_start_key_;
   std::string scanner_end_key = end_key_ <= region->GetRange().end_key ? end_key_ : region->GetRange().end_key;
   ScannerOptions options(stub, region, scanner_start_key, scanner_end_key);
+  options.key_only = key_only_;
 
   std::shared_ptr<RegionScanner> scanner;
   CHECK(stub.GetRawKvRegionScannerFactory()->NewRegionScanner(options, scanner).IsOK());
@@ -142,8 +169,7 @@ void RawKvScanTask::NextBatchCallback(const Status& status, std::shared_ptr<Regi
   }
 
   if (!tmp_scanner_scan_kvs_.empty()) {
-    tmp_out_kvs_.insert(tmp_out_kvs_.end(), std::make_move_iterator(tmp_scanner_scan_kvs_.begin()),
-                        std::make_move_iterator(tmp_scanner_scan_kvs_.end()));
+    Collect(tmp_scanner_scan_kvs_);
   } else {
     DINGO_LOG(INFO) << fmt::format("region:{} scanner NextBatch is empty", region->RegionId());
     CHECK(!scanner->HasMore());
@@ -152,9 +178,233 @@ void RawKvScanTask::NextBatchCallback(const Status& status, std::shared_ptr<Regi
   ScanNextWithScanner(std::move(scanner));
 }
 
+void RawKvScanTask::ParallelScan() {
+  {
+    LockGuard guard(&mutex_);
+    // retry restart from the first kv not merged yet, kvs read ahead by other regions are scanned again
+    slots_.clear();
+    next_dispatch_key_ = next_start_key_;
+    dispatch_end_ = false;
+    inflight_count_ = 0;
+    status_ = Status::OK();
+  }
+
+  ParallelPump();
+}
+
+void RawKvScanTask::ParallelPump() {
+  {
+    LockGuard guard(&mutex_);
+    if (pumping_) {
+      // state changed under mutex_, the pumping thread will see it in next round
+      return;
+    }
+    pumping_ = true;
+  }
+
+  while (true) {
+    std::vector<std::shared_ptr<RegionSlot>> to_fetch;
+    std::vector<std::shared_ptr<RegionScanner>> to_release;
+    bool need_dispatch = false;
+    bool done = false;
+    {
+      LockGuard guard(&mutex_);
+      MergeHeadUnlocked();
+
+      if (!status_.ok() || ReachLimit()) {
+        // stop read ahead, idle scanners are released now and the others once their rpc return
+        for (auto& slot : slots_) {
+          if (!slot->inflight && slot->scanner != nullptr) {
+            to_release.push_back(std::move(slot->scanner));
+          }
+        }
+        done = (inflight_count_ == 0);
+      } else if (slots_.empty() && dispatch_end_) {
+        done = true;
+      } else {
+        need_dispatch = !dispatch_end_ && static_cast<int64_t>(slots_.size()) < RegionConcurrency();
+        for (size_t i = 0; i < slots_.size(); ++i) {
+          auto& slot = slots_[i];
+          // head is merged at once, so only the regions behind it buffer
+          bool buffer_full =
+              i > 0 && static_cast<int64_t>(slot->batches.size()) >= FLAGS_scan_region_prefetch_batch_num;
+          if (slot->opened && !slot->inflight && !slot->finished && !buffer_full) {
+            slot->inflight = true;
+            inflight_count_++;
+            to_fetch.push_back(slot);
+          }
+        }
+      }
+
+      if (done) {
+        for (auto& slot : slots_) {
+          if (slot->scanner != nullptr) {
+            to_release.push_back(std::move(slot->scanner));
+          }
+        }
+        slots_.clear();
+        pumping_ = false;
+      } else if (to_fetch.empty() && !need_dispatch) {
+        pumping_ = false;
+        break;
+      }
+    }
+
+    if (done) {
+      DINGO_LOG(INFO) << fmt::format("parallel scan end between [{},{}), next_start:{}, limit:{}, scan_cnt:{}",
+                                     start_key_, end_key_, next_start_key_, limit_, tmp_out_kvs_.size());
+      if (status_.ok() && ReachLimit()) {
+        tmp_out_kvs_.resize(limit_);
+      }
+      Status status = status_;
+      DoAsyncDone(status);
+      return;
+    }
+
+    for (auto& slot : to_fetch) {
+      slot->scanner->AsyncNextBatch(slot->fetching_kvs, [this, slot](auto&& s) {
+        ParallelNextBatchCallback(std::forward<decltype(s)>(s), slot);
+      });
+    }
+
+    if (need_dispatch) {
+      DispatchRegion();
+    }
+  }
+}
+
+void RawKvScanTask::DispatchRegion() {
+  std::shared_ptr<Region> region;
+  Status status = stub.GetMetaCache()->LookupRegionBetweenRange(next_dispatch_key_, end_key_, region);
+  if (!status.ok()) {
+    LockGuard guard(&mutex_);
+    if (status.IsNotFound()) {
+      DINGO_LOG(INFO) << fmt::format("region not found between [{},{}), start_key:{} status:{}", next_dispatch_key_,
+                                     end_key_, start_key_, status.ToString());
+      dispatch_end_ = true;
+    } else {
+      DINGO_LOG(WARNING) << fmt::format("region look fail between [{},{}), start_key:{} status:{}", next_dispatch_key_,
+                                        end_key_, start_key_, status.ToString());
+      status_ = status;
+    }
+    return;
+  }
+
+  std::string scanner_start_key = std::max(next_dispatch_key_, region->GetRange().start_key);
+  std::string scanner_end_key = std::min(end_key_, region->GetRange().end_key);
+  ScannerOptions options(stub, region, scanner_start_key, scanner_end_key);
+  options.key_only = key_only_;
+
+  auto slot = std::make_shared<RegionSlot>();
+  slot->end_key = scanner_end_key;
+  slot->inflight = true;
+  CHECK(stub.GetRawKvRegionScannerFactory()->NewRegionScanner(options, slot->scanner).IsOK());
+
+  {
+    LockGuard guard(&mutex_);
+    next_dispatch_key_ = region->GetRange().end_key;
+    dispatch_end_ = next_dispatch_key_ >= end_key_;
+    inflight_count_++;
+    slots_.push_back(slot);
+  }
+
+  DINGO_LOG(INFO) << fmt::format("region:{} parallel scan start, scan range:({}-{})", region->RegionId(),
+                                 scanner_start_key, scanner_end_key);
+  slot->scanner->AsyncOpen([this, slot](auto&& s) { ParallelOpenCallback(std::forward<decltype(s)>(s), slot); });
+}
+
+void RawKvScanTask::ParallelOpenCallback(Status status, std::shared_ptr<RegionSlot> slot) {
+  {
+    LockGuard guard(&mutex_);
+    slot->inflight = false;
+    inflight_count_--;
+    if (status.ok()) {
+      slot->opened = true;
+      slot->finished = !slot->scanner->HasMore();
+    } else {
+      DINGO_LOG(WARNING) << fmt::format("region scanner open fail, region:{}, status:{}",
+                                        slot->scanner->GetRegion()->RegionId(), status.ToString());
+      if (status_.ok()) {
+        status_ = status;
+      }
+    }
+  }
+
+  ParallelPump();
+}
+
+void RawKvScanTask::ParallelNextBatchCallback(Status status, std::shared_ptr<RegionSlot> slot) {
+  {
+    LockGuard guard(&mutex_);
+    slot->inflight = false;
+    inflight_count_--;
+    if (status.ok()) {
+      if (!slot->fetching_kvs.empty()) {
+        slot->batches.push_back(std::move(slot->fetching_kvs));
+        slot->fetching_kvs.clear();
+      }
+      slot->finished = !slot->scanner->HasMore();
+    } else {
+      DINGO_LOG(WARNING) << fmt::format("region scanner NextBatch fail, region:{}, status:{}",
+                                        slot->scanner->GetRegion()->RegionId(), status.ToString());
+      if (status_.ok()) {
+        status_ = status;
+      }
+    }
+  }
+
+  ParallelPump();
+}
+
+void RawKvScanTask::MergeHeadUnlocked() {
+  while (!slots_.empty() && !ReachLimit()) {
+    auto& head = slots_.front();
+    for (auto& batch : head->batches) {
+      if (batch.empty()) {
+        continue;
+      }
+      // the smallest key greater than last merged key, retry resume from it
+      next_start_key_ = batch.back().key + std::string(1, '\0');
+      Collect(batch);
+    }
+    head->batches.clear();
+
+    if (!head->finished || head->inflight) {
+      break;
+    }
+
+    next_start_key_ = head->end_key;
+    slots_.pop_front();
+  }
+}
+
 bool RawKvScanTask::ReachLimit() { return limit_ != 0 && (tmp_out_kvs_.size() >= limit_); }
 
-void RawKvScanTask::PostProcess() { out_kvs_ = std::move(tmp_out_kvs_); }
+void RawKvScanTask::Collect(std::vector<KVPair>& kvs) {
+  if (out_count_ != nullptr) {
+    tmp_out_count_ += kvs.size();
+    return;
+  }
+
+  tmp_out_kvs_.insert(tmp_out_kvs_.end(), std::make_move_iterator(kvs.begin()), std::make_move_iterator(kvs.end()));
+}
+
+int64_t RawKvScanTask::RegionConcurrency() const {
+  // count keep no kvs, so it always read regions in parallel
+  if (out_count_ != nullptr) {
+    return std::max(FLAGS_scan_region_concurrency, FLAGS_count_range_region_concurrency);
+  }
+  return FLAGS_scan_region_concurrency;
+}
+
+void RawKvScanTask::PostProcess() {
+  if (out_count_ != nullptr) {
+    *out_count_ = tmp_out_count_;
+    return;
+  }
+
+  *out_kvs_ = std::move(tmp_out_kvs_);
+}
 
 }  // namespace sdk
 }  // namespace dingodb
\ No newline at end of file
@@ -16,10 +16,16 @@
 #define DINGODB_SDK_RAW_KV_SCAN_TASK_H_
 
 #include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
 
 #include "dingosdk/status.h"
 #include "sdk/client_stub.h"
 #include "sdk/rawkv/raw_kv_task.h"
+#include "sdk/region_scanner.h"
+#include "sdk/utils/mutex_lock.h"
 
 namespace dingodb {
 namespace sdk {
@@ -27,7 +33,10 @@ namespace sdk {
 class RawKvScanTask : public RawKvTask {
  public:
   RawKvScanTask(const ClientStub& stub, const std::string& start_key, const std::string& end_key, uint64_t limit,
-                std::vector<KVPair>& out_kvs);
+                std::vector<KVPair>& out_kvs, bool key_only = false);
+
+  // count keys in range, keys are scanned key only and dropped once counted
+  RawKvScanTask(const ClientStub& stub, const std::string& start_key, const std::string& end_key, int64_t& out_count);
 
   ~RawKvScanTask() override = default;
 
@@ -41,23 +50,59 @@ class RawKvScanTask : public RawKvTask {
   void ScanNextWithScanner(std::shared_ptr<RegionScanner> scanner);
   void NextBatchCallback(const Status& status, std::shared_ptr<RegionScanner> scanner);
 
+  // parallel scan, used when scan_region_concurrency > 1.
+  // Up to scan_region_concurrency region scanners read ahead into their own buffers, the head region is merged into
+  // output first so kvs stay in key order. Only one thread pump the state forward at a time, rpc are sent out of
+  // mutex_ so scanner callbacks fired inline don't recurse.
+  struct RegionSlot {
+    std::shared_ptr<RegionScanner> scanner;
+    std::string end_key;
+    std::deque<std::vector<KVPair>> batches;
+    std::vector<KVPair> fetching_kvs;
+    bool opened{false};
+    bool inflight{false};
+    bool finished{false};
+  };
+
+  void ParallelScan();
+  void ParallelPump();
+  void DispatchRegion();
+  void ParallelOpenCallback(Status status, std::shared_ptr<RegionSlot> slot);
+  void ParallelNextBatchCallback(Status status, std::shared_ptr<RegionSlot> slot);
+  void MergeHeadUnlocked();
+
   bool ReachLimit();
+  // move batch to output, or only count it when counting
+  void Collect(std::vector<KVPair>& kvs);
+  int64_t RegionConcurrency() const;
 
   std::string Name() const override { return "RawKvScanTask"; }
   std::string ErrorMsg() const override {
-    return fmt::format("start_key: {}, end_key:{}, limit:{}", start_key_, end_key_, limit_);
+    return fmt::format("start_key: {}, end_key:{}, limit:{}, key_only:{}, count:{}", start_key_, end_key_, limit_,
+                       key_only_, out_count_ != nullptr);
   }
 
   const std::string& start_key_;
   const std::string& end_key_;
   const uint64_t limit_;
-  std::vector<KVPair>& out_kvs_;
+  // exactly one of them is set
+  std::vector<KVPair>* out_kvs_;
+  int64_t* out_count_;
+  const bool key_only_;
 
   Status status_;
   std::string next_start_key_;
   std::vector<KVPair> tmp_out_kvs_;
+  int64_t tmp_out_count_{0};
 
   std::vector<KVPair> tmp_scanner_scan_kvs_;
+
+  Mutex mutex_;
+  std::deque<std::shared_ptr<RegionSlot>> slots_;
+  std::string next_dispatch_key_;
+  bool dispatch_end_{false};
+  int64_t inflight_count_{0};
+  bool pumping_{false};
 };
 
 }  // namespace sdk
@@ -14,7 +14,11 @@
 
 #include "sdk/rawkv/raw_kv_task.h"
 
+#include <algorithm>
+
+#include "sdk/common/backoff.h"
 #include "sdk/common/common.h"
+#include "sdk/common/deadline.h"
 #include "sdk/common/param_config.h"
 #include "sdk/utils/async_util.h"
 
@@ -35,6 +39,12 @@ void RawKvTask::AsyncRun(StatusCallback cb) {
     WriteLockGuard guard(rw_lock_);
     call_back_.swap(cb);
   }
+  if (NeedTrace(call_ctx_)) {
+    span_ = Span::Start(Name(), call_ctx_);
+    call_ctx_ = span_.ChildContext(call_ctx_);
+  }
+
+  CallContextGuard ctx_guard(call_ctx_);
   Status status = Init();
   if (status.ok()) {
     DoAsync();
@@ -58,6 +68,12 @@ void RawKvTask::DoAsyncDone(const Status& status) {
 }
 
 void RawKvTask::FailOrRetry() {
+  if (IsDeadlineExpired(call_ctx_.deadline_ms)) {
+    status_ = Status::TimedOut(fmt::format("Fail task:{} deadline exceeded, last err:{}", Name(), status_.ToString()));
+    FireCallback();
+    return;
+  }
+
   if (NeedRetry()) {
     BackoffAndRetry();
   } else {
@@ -84,7 +100,16 @@ bool RawKvTask::NeedRetry() {
 }
 
 void RawKvTask::BackoffAndRetry() {
-  stub.GetActuator()->Schedule([this] { DoAsync(); }, FLAGS_raw_kv_delay_ms);
+  // retry error code of task all mean region epoch or range changed
+  int64_t delay_ms = FullJitterBackoffMs(BackoffBaseMs(kBackoffRegionEpoch), FLAGS_raw_kv_delay_ms, retry_count_ - 1);
+  delay_ms = std::min(delay_ms, DeadlineRemainingMs(call_ctx_.deadline_ms));
+  stub.GetActuator()->Schedule(
+      [this, backoff_span = Span::Start("backoff", call_ctx_)]() mutable {
+        backoff_span.End(Status::OK());
+        CallContextGuard ctx_guard(call_ctx_);
+        DoAsync();
+      },
+      delay_ms);
 }
 
 void RawKvTask::FireCallback() {
@@ -101,6 +126,8 @@ void RawKvTask::FireCallback() {
     call_back_.swap(cb);
   }
 
+  span_.End(status_);
+  CallContextGuard ctx_guard(call_ctx_);
   cb(status_);
 }
 
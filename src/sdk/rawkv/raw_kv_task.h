@@ -17,6 +17,8 @@
 
 #include "dingosdk/status.h"
 #include "sdk/client_stub.h"
+#include "sdk/common/call_context.h"
+#include "sdk/common/tracer.h"
 #include "sdk/utils/callback.h"
 #include "sdk/utils/rw_lock.h"
 
@@ -25,7 +27,7 @@ namespace sdk {
 
 class RawKvTask {
  public:
-  RawKvTask(const ClientStub& stub) : stub(stub) {}
+  RawKvTask(const ClientStub& stub) : stub(stub), call_ctx_(CurrentCallContext()) {}
   virtual ~RawKvTask() = default;
 
   Status Run();
@@ -53,6 +55,9 @@ class RawKvTask {
   RWLock rw_lock_;
   StatusCallback call_back_;
   int retry_count_{0};
+  // captured from caller when construct, span_ become parent of new spans once started
+  CallContext call_ctx_;
+  Span span_;
 };
 
 }  // namespace sdk
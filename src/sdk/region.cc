@@ -104,6 +104,49 @@ void Region::MarkFollower(const EndPoint& end_point) {
                   << " follower, current replicas:" << ReplicasAsStringUnlocked();
 }
 
+bool Region::DemoteLeader(const EndPoint& end_point) {
+  WriteLockGuard guard(rw_lock_);
+
+  if (!leader_addr_.IsValid() || leader_addr_ != end_point) {
+    return false;
+  }
+
+  for (auto& r : replicas_) {
+    if (r.end_point == end_point) {
+      r.role = kFollower;
+    }
+  }
+  leader_addr_.ReSet();
+
+  return true;
+}
+
+bool Region::TransferLeader(const EndPoint& old_leader, const EndPoint& new_leader) {
+  WriteLockGuard guard(rw_lock_);
+
+  if (!leader_addr_.IsValid() || leader_addr_ != old_leader) {
+    return false;
+  }
+
+  bool found = false;
+  for (const auto& r : replicas_) {
+    if (r.end_point == new_leader) {
+      found = true;
+      break;
+    }
+  }
+  if (!found) {
+    return false;
+  }
+
+  for (auto& r : replicas_) {
+    r.role = (r.end_point == new_leader) ? kLeader : kFollower;
+  }
+  leader_addr_ = new_leader;
+
+  return true;
+}
+
 Status Region::GetLeader(EndPoint& leader) {
   ReadLockGuard guard(rw_lock_);
 
@@ -119,6 +162,17 @@ Status Region::GetLeader(EndPoint& leader) {
   return Status::OK();
 }
 
+EndPoint Region::PeekLeader() {
+  ReadLockGuard guard(rw_lock_);
+
+  if (leader_addr_.IsValid()) {
+    return leader_addr_;
+  }
+
+  int64_t next_replica_index = next_replica_index_.load(std::memory_order_relaxed);
+  return replicas_[next_replica_index % replicas_.size()].end_point;
+}
+
 std::string Region::ReplicasAsString() {
   ReadLockGuard guard(rw_lock_);
 
@@ -69,6 +69,9 @@ class Region {
 
   Status GetLeader(EndPoint& leader);
 
+  // same as GetLeader but without side effect, when leader is unknown return the replica GetLeader would pick next
+  EndPoint PeekLeader();
+
   bool IsStale() { return stale_.load(std::memory_order_relaxed); }
 
   std::string ReplicasAsString();
@@ -96,6 +99,13 @@ class Region {
 
   bool IsLeader(const EndPoint& end_point);
 
+  // NOTE: below used by MetaCache to propagate store level leadership change, no log for each region
+  // return true if end_point was leader and is demoted
+  bool DemoteLeader(const EndPoint& end_point);
+
+  // return true if old_leader was leader and new_leader is replica of this region
+  bool TransferLeader(const EndPoint& old_leader, const EndPoint& new_leader);
+
   const int64_t region_id_;
   Range range_;
   RegionEpoch epoch_;
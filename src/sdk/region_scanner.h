@@ -71,6 +71,8 @@ struct ScannerOptions {
   std::string end_key;
   std::optional<const TransactionOptions> txn_options;
   std::optional<int64_t> start_ts;
+  // only read keys, value of kvs is empty
+  bool key_only{false};
 
   explicit ScannerOptions(const ClientStub& p_stub, std::shared_ptr<Region> p_region, std::string p_start_key,
                           std::string p_end_key)
@@ -14,44 +14,86 @@
 
 #include "sdk/rpc/brpc/brpc_rpc_client.h"
 
+#include <algorithm>
+#include <functional>
 #include <memory>
 
+#include "fmt/core.h"
 #include "glog/logging.h"
 #include "sdk/rpc/brpc/unary_rpc.h"
 #include "sdk/rpc/rpc_client.h"
-#include "sdk/utils/mutex_lock.h"
 
 namespace dingodb {
 namespace sdk {
 
 void BrpcRpcClient::SendRpc(Rpc &rpc, RpcCallback cb) {
-  auto endpoint = rpc.GetEndPoint();
+  const auto &endpoint = rpc.GetEndPoint();
   CHECK(endpoint.IsValid()) << "rpc endpoint not valid: " << endpoint.ToString();
 
-  std::shared_ptr<brpc::Channel> channel = std::make_shared<brpc::Channel>();
+  std::shared_ptr<brpc::Channel> channel = GetChannel(endpoint);
+  CHECK_NOTNULL(channel.get());
+
+  auto *ctx = static_cast<BrpcContext *>(CHECK_NOTNULL(rpc.MutableRpcContext()));
+  ctx->cb = std::move(cb);
+  ctx->channel = std::move(channel);
+  rpc.Call(ctx);
+}
+
+std::shared_ptr<brpc::Channel> BrpcRpcClient::GetChannel(const EndPoint &endpoint) {
+  auto &shard = shards_[EndPointShardIndex(endpoint, kChannelShardNum)];
+
+  std::shared_ptr<ChannelGroup> group;
   {
-    LockGuard guard(&lock_);
-    auto ch = channel_map_.find(endpoint);
-    if (ch == channel_map_.end()) {
-      brpc::ChannelOptions options;
-      options.timeout_ms = m_options.timeout_ms;
-      options.connect_timeout_ms = m_options.connect_timeout_ms;
-      options.max_retry = m_options.max_retry;
-
-      int ret = channel->Init(endpoint.Host().c_str(), endpoint.Port(), &options);
-
-      CHECK_EQ(ret, 0) << "Fail init channel endpoint:" << endpoint.ToString();
-      channel_map_.insert(std::make_pair(endpoint, channel));
-    } else {
-      channel = CHECK_NOTNULL(ch->second);
+    ReadLockGuard guard(shard.rw_lock);
+    auto iter = shard.channel_groups.find(endpoint);
+    if (iter != shard.channel_groups.end()) {
+      group = iter->second;
     }
   }
 
-  CHECK_NOTNULL(channel.get());
-  auto ctx = std::make_unique<BrpcContext>();
-  ctx->cb = std::move(cb);
-  ctx->channel = channel;
-  rpc.Call(ctx.release());
+  if (group == nullptr) {
+    // init channel out of lock, connect may be slow
+    auto new_group = NewChannelGroup(endpoint);
+
+    WriteLockGuard guard(shard.rw_lock);
+    auto iter = shard.channel_groups.find(endpoint);
+    if (iter == shard.channel_groups.end()) {
+      iter = shard.channel_groups.emplace(endpoint, std::move(new_group)).first;
+    }
+    group = iter->second;
+  }
+
+  const auto &channels = group->channels;
+  if (channels.size() == 1) {
+    return channels[0];
+  }
+
+  uint64_t index = group->next_index.fetch_add(1, std::memory_order_relaxed);
+  return channels[index % channels.size()];
+}
+
+std::shared_ptr<BrpcRpcClient::ChannelGroup> BrpcRpcClient::NewChannelGroup(const EndPoint &endpoint) {
+  int channel_num = std::max(m_options.channel_num_per_endpoint, 1);
+
+  auto group = std::make_shared<ChannelGroup>();
+  group->channels.reserve(channel_num);
+  for (int i = 0; i < channel_num; ++i) {
+    brpc::ChannelOptions options;
+    options.timeout_ms = m_options.timeout_ms;
+    options.connect_timeout_ms = m_options.connect_timeout_ms;
+    options.max_retry = m_options.max_retry;
+    options.connection_type = m_options.connection_type;
+    // channels with different connection group use different connections
+    options.connection_group = fmt::format("dingosdk_{}", i);
+
+    auto channel = std::make_shared<brpc::Channel>();
+    int ret = channel->Init(endpoint.Host().c_str(), endpoint.Port(), &options);
+    CHECK_EQ(ret, 0) << "Fail init channel endpoint:" << endpoint.ToString();
+
+    group->channels.push_back(std::move(channel));
+  }
+
+  return group;
 }
 
 RpcClient *NewRpcClient(const RpcClientOptions &options) {
@@ -60,4 +102,4 @@ RpcClient *NewRpcClient(const RpcClientOptions &options) {
 }
 
 }  // namespace sdk
-};  // namespace dingodb
\ No newline at end of file
+};  // namespace dingodb
@@ -15,11 +15,15 @@
 #ifndef DINGODB_SDK_BRPC_RPC_CLIENT_H_
 #define DINGODB_SDK_BRPC_RPC_CLIENT_H_
 
+#include <atomic>
+#include <cstdint>
 #include <map>
+#include <memory>
+#include <vector>
 
 #include "brpc/channel.h"
 #include "sdk/rpc/rpc_client.h"
-#include "sdk/utils/mutex_lock.h"
+#include "sdk/utils/rw_lock.h"
 
 namespace dingodb {
 namespace sdk {
@@ -32,12 +36,37 @@ class BrpcRpcClient : public RpcClient {
 
   void SendRpc(Rpc& rpc, RpcCallback cb) override;
 
+  std::shared_ptr<brpc::Channel> TEST_GetChannel(const EndPoint& endpoint) {  // NOLINT
+    return GetChannel(endpoint);
+  }
+
+  static size_t TEST_ShardIndex(const EndPoint& endpoint) {  // NOLINT
+    return EndPointShardIndex(endpoint, kChannelShardNum);
+  }
+
  private:
-  Mutex lock_;
-  std::map<EndPoint, std::shared_ptr<brpc::Channel>> channel_map_;
+  // channels to one endpoint, picked round robin
+  struct ChannelGroup {
+    std::vector<std::shared_ptr<brpc::Channel>> channels;
+    std::atomic<uint64_t> next_index{0};
+  };
+
+  // endpoint -> channel group, sharded by endpoint hash so concurrent rpc to different stores don't contend
+  struct ChannelShard {
+    RWLock rw_lock;
+    std::map<EndPoint, std::shared_ptr<ChannelGroup>> channel_groups;
+  };
+
+  static const int kChannelShardNum = 32;
+
+  std::shared_ptr<brpc::Channel> GetChannel(const EndPoint& endpoint);
+
+  std::shared_ptr<ChannelGroup> NewChannelGroup(const EndPoint& endpoint);
+
+  ChannelShard shards_[kChannelShardNum];
 };
 
 }  // namespace sdk
 }  // namespace dingodb
 
-#endif  // DINGODB_SDK_BRPC_RPC_CLIENT_H_
\ No newline at end of file
+#endif  // DINGODB_SDK_BRPC_RPC_CLIENT_H_
@@ -66,9 +66,10 @@ class TsoServiceRpc final
   explicit TsoServiceRpc();
   explicit TsoServiceRpc(const std ::string& cmd);
   ~TsoServiceRpc() override;
-  std ::string Method() const override { return ConstMethod(); }
+  const char* Method() const override { return ConstMethod(); }
+  std::unique_ptr<Rpc> Clone() const override;
   void Send(pb::meta::MetaService_Stub& stub, google::protobuf::Closure* done) override;
-  static std ::string ConstMethod();
+  static const char* ConstMethod();
 };
 
 }  // namespace sdk
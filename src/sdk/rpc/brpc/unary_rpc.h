@@ -18,6 +18,7 @@
 #include <fmt/format.h>
 #include <sys/stat.h>
 
+#include <cerrno>
 #include <cstdint>
 #include <string>
 
@@ -34,6 +35,7 @@
 #include "sdk/common/param_config.h"
 #include "sdk/common/rand.h"
 #include "sdk/rpc/rpc.h"
+#include "sdk/rpc/rpc_arena.h"
 #include "sdk/utils/callback.h"
 
 namespace dingodb {
@@ -46,21 +48,44 @@ struct BrpcContext : public RpcContext {
   std::shared_ptr<brpc::Channel> channel;
 };
 
+// peer is unreachable, ERPCTIMEDOUT and ETIMEDOUT are caller side timeout and excluded
+inline bool IsTransportErrorCode(int error_code) {
+  switch (error_code) {
+    case ECONNREFUSED:
+    case ECONNRESET:
+    case EHOSTDOWN:
+    case EHOSTUNREACH:
+    case ENETUNREACH:
+    case brpc::EFAILEDSOCKET:
+    case brpc::EEOF:
+      return true;
+    default:
+      return false;
+  }
+}
+
 template <class RequestType, class ResponseType, class ServiceType, class StubType>
 class UnaryRpc : public Rpc {
  public:
   UnaryRpc(const std::string& cmd) : Rpc(cmd) {
-    request = new RequestType;
-    response = new ResponseType;
+    if (FLAGS_rpc_enable_arena) {
+      arena = NewRpcArena(GetArenaSizeHint());
+      request = google::protobuf::Arena::CreateMessage<RequestType>(arena.get());
+      response = google::protobuf::Arena::CreateMessage<ResponseType>(arena.get());
+    } else {
+      request = new RequestType;
+      response = new ResponseType;
+    }
     log_id = RandHelper::RandUInt64();
     controller.set_log_id(log_id);
-    brpc_ctx = nullptr;
   }
 
   ~UnaryRpc() override {
-    delete request;
-    delete response;
-    delete brpc_ctx;
+    // messages on arena are freed with arena
+    if (arena == nullptr) {
+      delete request;
+      delete response;
+    }
   }
 
   RequestType* MutableRequest() { return request; }
@@ -89,6 +114,13 @@ class UnaryRpc : public Rpc {
 
   uint64_t LogId() const override { return controller.log_id(); }
 
+  // learn arena usage of this rpc type, so later rpc start with one block large enough for the response
+  void UpdateArenaSizeHint() {
+    if (arena != nullptr) {
+      GetArenaSizeHint().Update(arena->SpaceUsed());
+    }
+  }
+
   void OnRpcDone() override {
     if (controller.Failed()) {
       DINGO_LOG(WARNING) << fmt::format("[sdk.rpc.{}] Fail send rpc: {}, endpoint: {}, error_code: {}, error_text: {}",
@@ -97,49 +129,46 @@ class UnaryRpc : public Rpc {
 
       Status err = Status::NetworkError(controller.ErrorCode(), controller.ErrorText());
       SetStatus(err);
+      transport_failure = IsTransportErrorCode(controller.ErrorCode());
     } else {
       DINGO_LOG(DEBUG) << fmt::format("[sdk.rpc.{}] Success send rpc: {}, endpoint: {}, request: {}, response: {}",
                                       controller.log_id(), Method(), endpoint2str(controller.remote_side()).c_str(),
                                       request->ShortDebugString(), response->ShortDebugString());
     }
 
-    int64_t end_time =
-        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch())
-            .count();
-    std::string str = fmt::format("request_id: {}, status: {}", controller.log_id(), status.ToString());
-    if ((end_time - start_time) > FLAGS_rpc_trace_full_info_threshold_us) {
-      // Default log all rpc info if elapse time greater than 1 second
-      str += fmt::format(",request : {}, response : {}", request->ShortDebugString(), response->ShortDebugString());
-      DINGO_LOG(INFO) << fmt::format("[sdk.trace.rpc][{}][{:.6f}s][endpoint({})] Full rpc info {}", Method(),
-                                     (end_time - start_time) / 1e6, endpoint2str(controller.remote_side()).c_str(),
-                                     str);
+    elapse_time_us = MonotonicUs() - start_time;
+    if (NeedTraceRpcPerformance(elapse_time_us)) {
+      TraceRpcPerformance(elapse_time_us, Method(), endpoint2str(controller.remote_side()).c_str(),
+                          controller.log_id(), status, *request, *response);
     }
-    TraceRpcPerformance(end_time - start_time, Method(), endpoint2str(controller.remote_side()).c_str(), str);
 
-    brpc_ctx->cb();
+    UpdateArenaSizeHint();
+
+    // callback may retry and refill brpc_ctx, so call it from stack
+    RpcCallback cb = std::move(brpc_ctx.cb);
+    cb();
   }
 
   void Reset() override {
     response->Clear();
     controller.Reset();
-    controller.set_timeout_ms(FLAGS_rpc_time_out_ms);
+    controller.set_timeout_ms(timeout_ms > 0 ? timeout_ms : FLAGS_rpc_time_out_ms);
     controller.set_max_retry(FLAGS_rpc_max_retry);
     controller.set_log_id(log_id);
     status = Status::OK();
+    transport_failure = false;
   }
 
-  // virtual void Call(RpcContext* ctx) = 0;
-  // void Call(void* channel, RpcCallback cb, void* cq) override {
+  RpcContext* MutableRpcContext() override { return &brpc_ctx; }
+
+  // ctx must be MutableRpcContext() filled by rpc client
   void Call(RpcContext* ctx) override {
-    brpc_ctx = dynamic_cast<BrpcContext*>(ctx);
-    CHECK_NOTNULL(brpc_ctx);
-    CHECK_NOTNULL(brpc_ctx->channel);
-    StubType stub(brpc_ctx->channel.get());
+    CHECK(ctx == &brpc_ctx) << "rpc context not owned by rpc";
+    CHECK_NOTNULL(brpc_ctx.channel);
+    StubType stub(brpc_ctx.channel.get());
 
     // Record the start time for performance tracing
-    start_time =
-        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch())
-            .count();
+    start_time = MonotonicUs();
 
     Send(stub, brpc::NewCallback(this, &UnaryRpc::OnRpcDone));
   }
@@ -147,10 +176,18 @@ class UnaryRpc : public Rpc {
   virtual void Send(StubType& stub, google::protobuf::Closure* done) = 0;
 
  protected:
+  static RpcArenaSizeHint& GetArenaSizeHint() {
+    static RpcArenaSizeHint hint;
+    return hint;
+  }
+
+  // NOTE: arena live across retries, response->Clear() keep memory of repeated fields for reuse
+  std::unique_ptr<google::protobuf::Arena> arena;
   RequestType* request;
   ResponseType* response;
   brpc::Controller controller;
-  BrpcContext* brpc_ctx;
+  // embedded so sending an rpc allocate no context, reused across retries
+  BrpcContext brpc_ctx;
   int64_t start_time{0};  // record the start time of the RPC call , use for trace
   int64_t log_id{0};
 };
@@ -164,9 +201,10 @@ class UnaryRpc : public Rpc {
     explicit METHOD##Rpc();                                                                                           \
     explicit METHOD##Rpc(const std::string& cmd);                                                                     \
     ~METHOD##Rpc() override;                                                                                          \
-    std::string Method() const override { return ConstMethod(); }                                                     \
+    const char* Method() const override { return ConstMethod(); }                                                     \
+    std::unique_ptr<Rpc> Clone() const override;                                                                      \
     void Send(NS::SERVICE##_Stub& stub, google::protobuf::Closure* done) override;                                    \
-    static std::string ConstMethod();                                                                                 \
+    static const char* ConstMethod();                                                                                 \
   };
 
 #define DECLARE_UNARY_RPC(NS, SERVICE, METHOD)                                                        \
@@ -178,9 +216,10 @@ class UnaryRpc : public Rpc {
     explicit METHOD##Rpc();                                                                           \
     explicit METHOD##Rpc(const std::string& cmd);                                                     \
     ~METHOD##Rpc() override;                                                                          \
-    std::string Method() const override { return ConstMethod(); }                                     \
+    const char* Method() const override { return ConstMethod(); }                                     \
+    std::unique_ptr<Rpc> Clone() const override;                                                      \
     void Send(NS::SERVICE##_Stub& stub, google::protobuf::Closure* done) override;                    \
-    static std::string ConstMethod();                                                                 \
+    static const char* ConstMethod();                                                                 \
   };
 
 #define DEFINE_UNAEY_RPC(NS, SERVICE, METHOD)                                         \
@@ -190,7 +229,16 @@ class UnaryRpc : public Rpc {
   void METHOD##Rpc::Send(NS::SERVICE##_Stub& stub, google::protobuf::Closure* done) { \
     stub.METHOD(MutableController(), request, response, done);                        \
   }                                                                                   \
-  std::string METHOD##Rpc::ConstMethod() { return fmt::format("{}.{}Rpc", NS::SERVICE::descriptor()->name(), #METHOD); }
+  std::unique_ptr<Rpc> METHOD##Rpc::Clone() const {                                   \
+    auto rpc = std::make_unique<METHOD##Rpc>(cmd);                                    \
+    rpc->MutableRequest()->CopyFrom(*request);                                        \
+    return rpc;                                                                       \
+  }                                                                                   \
+  const char* METHOD##Rpc::ConstMethod() {                                            \
+    static const std::string kMethod =                                                \
+        fmt::format("{}.{}Rpc", NS::SERVICE::descriptor()->name(), #METHOD);          \
+    return kMethod.c_str();                                                           \
+  }
 
 }  // namespace sdk
 }  // namespace dingodb
@@ -0,0 +1,248 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/rpc/concurrency_limiter.h"
+
+#include <algorithm>
+#include <chrono>
+#include <utility>
+#include <vector>
+
+#include "sdk/common/deadline.h"
+#include "sdk/common/param_config.h"
+
+namespace dingodb {
+namespace sdk {
+
+static const double kDecreaseRatio = 0.5;
+// min latency drift up slowly, so it can follow a store which really become slower
+static const int kMinLatencyDriftShift = 10;
+
+static int64_t MonotonicUs() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+ConcurrencyLimiter::AdmitResult ConcurrencyLimiter::Acquire(const EndPoint& end_point, int64_t deadline_ms,
+                                                            std::function<void(const Status&)> on_admit,
+                                                            const std::shared_ptr<Actuator>& actuator) {
+  auto limit = GetOrCreateLimit(end_point);
+  if (deadline_ms == kNoDeadline && FLAGS_store_concurrency_limit_max_queue_ms > 0) {
+    deadline_ms = MonotonicMs() + FLAGS_store_concurrency_limit_max_queue_ms;
+  }
+
+  AdmitResult result;
+  std::vector<Waiter> expired;
+  {
+    LockGuard guard(&limit->mutex);
+    TakeExpiredWaiters(*limit, expired);
+    if (limit->inflight < static_cast<int64_t>(limit->limit)) {
+      limit->inflight++;
+      result = kAdmitted;
+    } else if (static_cast<int64_t>(limit->waiters.size()) >= FLAGS_store_concurrency_limit_queue_size) {
+      result = kRejected;
+    } else {
+      limit->waiters.push_back({deadline_ms, std::move(on_admit)});
+      result = kQueued;
+      if (actuator != nullptr) {
+        limit->actuator = actuator;
+      }
+      if (deadline_ms != kNoDeadline) {
+        ArmExpireTimerUnlocked(limit, deadline_ms);
+      }
+    }
+  }
+
+  FailExpiredWaiters(expired);
+  return result;
+}
+
+bool ConcurrencyLimiter::TryAcquire(const EndPoint& end_point) {
+  auto limit = GetOrCreateLimit(end_point);
+
+  LockGuard guard(&limit->mutex);
+  if (limit->inflight < static_cast<int64_t>(limit->limit)) {
+    limit->inflight++;
+    return true;
+  }
+
+  return false;
+}
+
+void ConcurrencyLimiter::Release(const EndPoint& end_point, bool overload, int64_t elapse_time_us) {
+  auto limit = GetOrCreateLimit(end_point);
+
+  std::vector<Waiter> admitted;
+  std::vector<Waiter> expired;
+  {
+    LockGuard guard(&limit->mutex);
+    TakeExpiredWaiters(*limit, expired);
+    limit->inflight = std::max(limit->inflight - 1, int64_t(0));
+
+    double min_limit = static_cast<double>(FLAGS_store_concurrency_limit_min);
+    double max_limit = static_cast<double>(FLAGS_store_concurrency_limit_max);
+    if (overload) {
+      // rpc sent before the last decrease saw the old limit, one burst of them only decrease once
+      int64_t now_us = MonotonicUs();
+      int64_t rtt_us = elapse_time_us > 0 ? elapse_time_us : limit->min_latency_us;
+      if (limit->last_decrease_us == 0 || now_us - rtt_us >= limit->last_decrease_us) {
+        limit->limit = std::max(limit->limit * kDecreaseRatio, min_limit);
+        limit->last_decrease_us = now_us;
+      }
+    } else if (elapse_time_us > 0) {
+      if (limit->min_latency_us == 0 || elapse_time_us < limit->min_latency_us) {
+        limit->min_latency_us = elapse_time_us;
+      } else {
+        limit->min_latency_us += (elapse_time_us - limit->min_latency_us) >> kMinLatencyDriftShift;
+      }
+
+      // queueing inside store show up as latency before EREQUEST_FULL, stop growing then
+      if (elapse_time_us <= limit->min_latency_us * FLAGS_store_concurrency_limit_latency_tolerance) {
+        limit->limit = std::min(limit->limit + 1.0 / limit->limit, max_limit);
+      }
+    }
+
+    while (!limit->waiters.empty() && limit->inflight < static_cast<int64_t>(limit->limit)) {
+      limit->inflight++;
+      admitted.push_back(std::move(limit->waiters.front()));
+      limit->waiters.pop_front();
+    }
+  }
+
+  FailExpiredWaiters(expired);
+  for (auto& waiter : admitted) {
+    waiter.on_admit(Status::OK());
+  }
+}
+
+void ConcurrencyLimiter::TakeExpiredWaiters(Limit& limit, std::vector<Waiter>& expired) {
+  auto iter = limit.waiters.begin();
+  while (iter != limit.waiters.end()) {
+    if (IsDeadlineExpired(iter->deadline_ms)) {
+      expired.push_back(std::move(*iter));
+      iter = limit.waiters.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+}
+
+void ConcurrencyLimiter::FailExpiredWaiters(std::vector<Waiter>& expired) {
+  for (auto& waiter : expired) {
+    waiter.on_admit(Status::TimedOut("deadline exceeded while waiting for concurrency limit"));
+  }
+}
+
+void ConcurrencyLimiter::ArmExpireTimerUnlocked(const std::shared_ptr<Limit>& limit, int64_t deadline_ms) {
+  if (limit->timer_deadline_ms != 0 && limit->timer_deadline_ms <= deadline_ms) {
+    return;
+  }
+
+  auto actuator = limit->actuator.lock();
+  if (actuator == nullptr) {
+    return;
+  }
+
+  limit->timer_deadline_ms = deadline_ms;
+  // one more ms so the deadline has surely passed when the timer fire
+  int64_t delay_ms = std::max(DeadlineRemainingMs(deadline_ms), int64_t(0)) + 1;
+  actuator->Schedule([limit, deadline_ms]() { OnExpireTimer(limit, deadline_ms); }, static_cast<int>(delay_ms));
+}
+
+void ConcurrencyLimiter::OnExpireTimer(const std::shared_ptr<Limit>& limit, int64_t deadline_ms) {
+  std::vector<Waiter> expired;
+  {
+    LockGuard guard(&limit->mutex);
+    TakeExpiredWaiters(*limit, expired);
+
+    // a timer for an earlier deadline replaced this one, that timer re-arm
+    if (limit->timer_deadline_ms == deadline_ms) {
+      limit->timer_deadline_ms = 0;
+      int64_t earliest_deadline_ms = kNoDeadline;
+      for (const auto& waiter : limit->waiters) {
+        if (waiter.deadline_ms != kNoDeadline &&
+            (earliest_deadline_ms == kNoDeadline || waiter.deadline_ms < earliest_deadline_ms)) {
+          earliest_deadline_ms = waiter.deadline_ms;
+        }
+      }
+      if (earliest_deadline_ms != kNoDeadline) {
+        ArmExpireTimerUnlocked(limit, earliest_deadline_ms);
+      }
+    }
+  }
+
+  FailExpiredWaiters(expired);
+}
+
+ConcurrencyLimitStats ConcurrencyLimiter::GetStats(const EndPoint& end_point) {
+  ConcurrencyLimitStats stats;
+
+  std::shared_ptr<Limit> limit;
+  {
+    ReadLockGuard guard(rw_lock_);
+    auto iter = limits_.find(end_point);
+    if (iter == limits_.end()) {
+      return stats;
+    }
+    limit = iter->second;
+  }
+
+  LockGuard guard(&limit->mutex);
+  stats.limit = static_cast<int64_t>(limit->limit);
+  stats.inflight = limit->inflight;
+  stats.queue_depth = static_cast<int64_t>(limit->waiters.size());
+  return stats;
+}
+
+std::map<EndPoint, ConcurrencyLimitStats> ConcurrencyLimiter::GetAllStats() {
+  std::vector<EndPoint> end_points;
+  {
+    ReadLockGuard guard(rw_lock_);
+    for (const auto& iter : limits_) {
+      end_points.push_back(iter.first);
+    }
+  }
+
+  std::map<EndPoint, ConcurrencyLimitStats> all_stats;
+  for (const auto& end_point : end_points) {
+    all_stats.emplace(end_point, GetStats(end_point));
+  }
+  return all_stats;
+}
+
+std::shared_ptr<ConcurrencyLimiter::Limit> ConcurrencyLimiter::GetOrCreateLimit(const EndPoint& end_point) {
+  {
+    ReadLockGuard guard(rw_lock_);
+    auto iter = limits_.find(end_point);
+    if (iter != limits_.end()) {
+      return iter->second;
+    }
+  }
+
+  WriteLockGuard guard(rw_lock_);
+  auto iter = limits_.find(end_point);
+  if (iter != limits_.end()) {
+    return iter->second;
+  }
+
+  auto limit = std::make_shared<Limit>();
+  int64_t init_limit = std::clamp(FLAGS_store_concurrency_limit_init, FLAGS_store_concurrency_limit_min,
+                                  FLAGS_store_concurrency_limit_max);
+  limit->limit = static_cast<double>(init_limit);
+  limits_.emplace(end_point, limit);
+  return limit;
+}
+
+}  // namespace sdk
+}  // namespace dingodb
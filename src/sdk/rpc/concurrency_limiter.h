@@ -0,0 +1,111 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_CONCURRENCY_LIMITER_H_
+#define DINGODB_SDK_CONCURRENCY_LIMITER_H_
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "dingosdk/status.h"
+#include "sdk/utils/actuator.h"
+#include "sdk/utils/mutex_lock.h"
+#include "sdk/utils/net_util.h"
+#include "sdk/utils/rw_lock.h"
+
+namespace dingodb {
+namespace sdk {
+
+struct ConcurrencyLimitStats {
+  int64_t limit{0};
+  int64_t inflight{0};
+  int64_t queue_depth{0};
+};
+
+// Client side admission control of store endpoint.
+// The concurrency limit of each endpoint follow AIMD: it is halved when the store reply EREQUEST_FULL or rpc timeout,
+// at most once per round trip so a burst of overloaded responses count as one signal,
+// and grows by about one per round trip on success unless latency rise above tolerance * min latency.
+// Rpc over the limit wait in a bounded queue and are rejected when the queue is full,
+// waiter whose deadline passed is failed with TimedOut by a timer armed on the actuator for the earliest deadline,
+// waiter without deadline queue at most store_concurrency_limit_max_queue_ms.
+class ConcurrencyLimiter {
+ public:
+  enum AdmitResult : uint8_t { kAdmitted, kQueued, kRejected };
+
+  ConcurrencyLimiter() = default;
+  ~ConcurrencyLimiter() = default;
+
+  ConcurrencyLimiter(const ConcurrencyLimiter&) = delete;
+  const ConcurrencyLimiter& operator=(const ConcurrencyLimiter&) = delete;
+
+  // kAdmitted: caller send rpc now, kQueued: on_admit will be called with ok when a slot is free,
+  // or with TimedOut when deadline_ms(see deadline.h) passed before that, the slot is not taken then.
+  // without actuator expired waiter is only failed on next acquire or release of the endpoint
+  AdmitResult Acquire(const EndPoint& end_point, int64_t deadline_ms, std::function<void(const Status&)> on_admit,
+                      const std::shared_ptr<Actuator>& actuator = nullptr);
+
+  // admit only when a slot is free now, for optional rpc like hedged request
+  bool TryAcquire(const EndPoint& end_point);
+
+  // must be called once for each admitted rpc
+  void Release(const EndPoint& end_point, bool overload, int64_t elapse_time_us);
+
+  ConcurrencyLimitStats GetStats(const EndPoint& end_point);
+
+  std::map<EndPoint, ConcurrencyLimitStats> GetAllStats();
+
+ private:
+  struct Waiter {
+    int64_t deadline_ms;
+    std::function<void(const Status&)> on_admit;
+  };
+
+  struct Limit {
+    Mutex mutex;
+    double limit{0};
+    int64_t inflight{0};
+    int64_t min_latency_us{0};
+    // monotonic time of the last multiplicative decrease, 0 means never
+    int64_t last_decrease_us{0};
+    std::deque<Waiter> waiters;
+    // deadline of the armed expire timer, 0 means no timer
+    int64_t timer_deadline_ms{0};
+    std::weak_ptr<Actuator> actuator;
+  };
+
+  // move waiters whose deadline passed to expired, must hold limit mutex
+  static void TakeExpiredWaiters(Limit& limit, std::vector<Waiter>& expired);
+
+  static void FailExpiredWaiters(std::vector<Waiter>& expired);
+
+  // arm expire timer unless one fire no later than deadline_ms, must hold limit mutex
+  static void ArmExpireTimerUnlocked(const std::shared_ptr<Limit>& limit, int64_t deadline_ms);
+
+  static void OnExpireTimer(const std::shared_ptr<Limit>& limit, int64_t deadline_ms);
+
+  std::shared_ptr<Limit> GetOrCreateLimit(const EndPoint& end_point);
+
+  RWLock rw_lock_;
+  std::map<EndPoint, std::shared_ptr<Limit>> limits_;
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_CONCURRENCY_LIMITER_H_
@@ -0,0 +1,124 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/rpc/endpoint_stats.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "sdk/common/param_config.h"
+#include "sdk/common/rand.h"
+
+namespace dingodb {
+namespace sdk {
+
+// new = old + (sample - old) / 2^kEwmaShift
+static const int kEwmaShift = 3;
+static const int kDeviationShift = 2;
+// failed rpc is recorded as kFailurePenaltyFactor times of current latency
+static const int64_t kFailurePenaltyFactor = 4;
+// endpoints within least latency * (1 + 1/2^kNearToleranceShift) are picked at random
+static const int kNearToleranceShift = 2;
+
+void EndPointStats::Record(const EndPoint& end_point, int64_t elapse_time_us, bool success) {
+  auto* stat = GetOrCreateStat(end_point);
+  int64_t old_value = stat->ewma_us.load(std::memory_order_relaxed);
+
+  int64_t sample = elapse_time_us;
+  if (!success) {
+    sample = std::min(std::max(elapse_time_us, old_value * kFailurePenaltyFactor), FLAGS_rpc_time_out_ms * 1000);
+  }
+  sample = std::max(sample, int64_t(1));
+
+  int64_t new_value;
+  do {
+    new_value = (old_value == 0) ? sample : old_value + ((sample - old_value) >> kEwmaShift);
+    new_value = std::max(new_value, int64_t(1));
+  } while (!stat->ewma_us.compare_exchange_weak(old_value, new_value, std::memory_order_relaxed));
+
+  // deviation is only a hint, lost update under contention is acceptable
+  if (old_value != 0) {
+    int64_t deviation = stat->deviation_us.load(std::memory_order_relaxed);
+    deviation += (std::abs(sample - old_value) - deviation) >> kDeviationShift;
+    stat->deviation_us.store(std::max(deviation, int64_t(0)), std::memory_order_relaxed);
+  }
+}
+
+int64_t EndPointStats::GetLatencyUs(const EndPoint& end_point) {
+  auto* stat = GetStat(end_point);
+  return stat == nullptr ? 0 : stat->ewma_us.load(std::memory_order_relaxed);
+}
+
+int64_t EndPointStats::GetTailLatencyUs(const EndPoint& end_point, int64_t factor) {
+  auto* stat = GetStat(end_point);
+  if (stat == nullptr) {
+    return 0;
+  }
+
+  return stat->ewma_us.load(std::memory_order_relaxed) + factor * stat->deviation_us.load(std::memory_order_relaxed);
+}
+
+EndPoint EndPointStats::PickNearest(const std::vector<EndPoint>& end_points) {
+  if (end_points.empty()) {
+    return EndPoint();
+  }
+
+  std::vector<int64_t> latencies;
+  latencies.reserve(end_points.size());
+  int64_t min_latency = INT64_MAX;
+  for (const auto& end_point : end_points) {
+    latencies.push_back(GetLatencyUs(end_point));
+    min_latency = std::min(min_latency, latencies.back());
+  }
+
+  int64_t max_latency = min_latency + (min_latency >> kNearToleranceShift);
+  std::vector<size_t> nears;
+  nears.reserve(end_points.size());
+  for (size_t i = 0; i < end_points.size(); i++) {
+    if (latencies[i] <= max_latency) {
+      nears.push_back(i);
+    }
+  }
+
+  return end_points[nears[RandHelper::RandUInt64() % nears.size()]];
+}
+
+EndPointStats::Stat* EndPointStats::GetStat(const EndPoint& end_point) {
+  auto& shard = shards_[EndPointShardIndex(end_point, kStatShardNum)];
+  ReadLockGuard guard(shard.rw_lock);
+  auto iter = shard.stats.find(end_point);
+  return iter == shard.stats.end() ? nullptr : iter->second.get();
+}
+
+EndPointStats::Stat* EndPointStats::GetOrCreateStat(const EndPoint& end_point) {
+  auto* stat = GetStat(end_point);
+  if (stat != nullptr) {
+    return stat;
+  }
+
+  auto& shard = shards_[EndPointShardIndex(end_point, kStatShardNum)];
+  WriteLockGuard guard(shard.rw_lock);
+  auto& slot = shard.stats[end_point];
+  if (slot == nullptr) {
+    slot = std::make_unique<Stat>();
+  }
+  return slot.get();
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,79 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_ENDPOINT_STATS_H_
+#define DINGODB_SDK_ENDPOINT_STATS_H_
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "sdk/utils/net_util.h"
+#include "sdk/utils/rw_lock.h"
+
+namespace dingodb {
+namespace sdk {
+
+// per endpoint rpc latency, smoothed by EWMA, used for pick replica
+class EndPointStats {
+ public:
+  EndPointStats() = default;
+  ~EndPointStats() = default;
+
+  EndPointStats(const EndPointStats&) = delete;
+  const EndPointStats& operator=(const EndPointStats&) = delete;
+
+  // failed rpc is recorded as a multiple of current latency, capped by rpc timeout,
+  // so broken endpoint is avoided but a few failures don't pin it at timeout for long
+  void Record(const EndPoint& end_point, int64_t elapse_time_us, bool success);
+
+  // return 0 if no sample
+  int64_t GetLatencyUs(const EndPoint& end_point);
+
+  // estimate high percentile latency as ewma + factor * mean deviation, like tcp rto, return 0 if no sample
+  int64_t GetTailLatencyUs(const EndPoint& end_point, int64_t factor);
+
+  // return a random endpoint among those close to the least latency, so near equal replicas share the load
+  // instead of all clients herding on one. endpoint without sample is preferred so it will be probed
+  EndPoint PickNearest(const std::vector<EndPoint>& end_points);
+
+ private:
+  struct Stat {
+    std::atomic<int64_t> ewma_us{0};
+    std::atomic<int64_t> deviation_us{0};
+  };
+
+  // endpoint -> stat, sharded by endpoint hash so rpc to different stores don't contend
+  struct StatShard {
+    RWLock rw_lock;
+    std::map<EndPoint, std::unique_ptr<Stat>> stats;
+  };
+
+  static const int kStatShardNum = 32;
+
+  // stat is never removed, pointer is valid for lifetime of EndPointStats
+  Stat* GetOrCreateStat(const EndPoint& end_point);
+
+  // return nullptr if no sample
+  Stat* GetStat(const EndPoint& end_point);
+
+  StatShard shards_[kStatShardNum];
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_ENDPOINT_STATS_H_
@@ -60,10 +60,18 @@ TsoServiceRpc::TsoServiceRpc(const std ::string& cmd) : UnaryRpc(cmd) {}
 TsoServiceRpc::~TsoServiceRpc() = default;
 std::unique_ptr<grpc::ClientAsyncResponseReader<pb::meta::TsoResponse>> TsoServiceRpc::Prepare(
     pb::meta::MetaService::Stub* stub, grpc::CompletionQueue* cq) {
-  return stub->AsyncTsoService(MutableContext(), request, cq);
+  return stub->AsyncTsoService(MutableContext(), *request, cq);
 }
-std ::string TsoServiceRpc::ConstMethod() {
-  return fmt ::format("{}.{}Rpc", pb::meta::MetaService::service_full_name(), "TsoService");
+void TsoServiceRpc::AsyncCall(pb::meta::MetaService::Stub* stub) {
+  stub->async()->TsoService(MutableContext(), request, response, [this](grpc::Status s) {
+    grpc_status = std::move(s);
+    OnRpcDone();
+  });
+}
+const char* TsoServiceRpc::ConstMethod() {
+  static const std::string kMethod =
+      fmt::format("{}.{}Rpc", pb::meta::MetaService::service_full_name(), "TsoService");
+  return kMethod.c_str();
 }
 
 }  // namespace sdk
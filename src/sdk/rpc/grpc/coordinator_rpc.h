@@ -66,10 +66,11 @@ class TsoServiceRpc final
   explicit TsoServiceRpc();
   explicit TsoServiceRpc(const std ::string& cmd);
   ~TsoServiceRpc() override;
-  std::string Method() const override { return ConstMethod(); }
+  const char* Method() const override { return ConstMethod(); }
   std::unique_ptr<grpc::ClientAsyncResponseReader<pb::meta::TsoResponse>> Prepare(pb::meta::MetaService::Stub* stub,
                                                                                   grpc::CompletionQueue* cq) override;
-  static std ::string ConstMethod();
+  void AsyncCall(pb::meta::MetaService::Stub* stub) override;
+  static const char* ConstMethod();
 };
 
 }  // namespace sdk
@@ -14,9 +14,21 @@
 
 #include "sdk/rpc/grpc/grpc_rpc_client.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
 #include "glog/logging.h"
 #include "grpcpp/grpcpp.h"
+#include "grpcpp/support/channel_arguments.h"
 #include "sdk/common/param_config.h"
+#include "sdk/rpc/grpc/grpc_stubs.h"
 #include "sdk/rpc/grpc/unary_rpc.h"
 #include "sdk/rpc/rpc.h"
 #include "sdk/utils/mutex_lock.h"
@@ -30,18 +42,7 @@ void GrpcRpcClient::Open() {
   if (!opened_) {
     for (int i = 0; i < FLAGS_grpc_poll_thread_num; ++i) {
       auto cq = std::make_unique<grpc::CompletionQueue>();
-      workers_.emplace_back(
-          [&](grpc::CompletionQueue* cq) -> void {
-            void* tag;
-            bool ok;
-            while (cq->Next(&tag, &ok)) {
-              CHECK(ok) << "expect ok is always true";
-              auto* rpc = static_cast<Rpc*>(tag);
-              rpc->OnRpcDone();
-            }
-          },
-          cq.get());
-
+      workers_.emplace_back(&GrpcRpcClient::PollCompletionQueue, cq.get(), i);
       cqs_.emplace_back(std::move(cq));
     }
 
@@ -64,35 +65,135 @@ void GrpcRpcClient::Close() {
   }
 }
 
+void GrpcRpcClient::PollCompletionQueue(grpc::CompletionQueue* cq, int index) {
+#ifdef __linux__
+  if (FLAGS_grpc_pin_poll_thread) {
+    int cpu_num = static_cast<int>(std::thread::hardware_concurrency());
+    if (cpu_num > 0) {
+      cpu_set_t cpu_set;
+      CPU_ZERO(&cpu_set);
+      CPU_SET(index % cpu_num, &cpu_set);
+      int ret = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+      LOG_IF(WARNING, ret != 0) << "Fail pin grpc poll thread " << index << " to cpu " << index % cpu_num
+                                << ", ret: " << ret;
+    }
+  }
+#endif
+
+  void* tag;
+  bool ok;
+  while (cq->Next(&tag, &ok)) {
+    CHECK(ok) << "expect ok is always true";
+    auto* rpc = static_cast<Rpc*>(tag);
+    rpc->OnRpcDone();
+  }
+}
+
 void GrpcRpcClient::SendRpc(Rpc& rpc, RpcCallback cb) {
   CHECK(opened_) << "grpc rpc client not opened";
   const auto& endpoint = rpc.GetEndPoint();
   CHECK(endpoint.IsValid()) << "rpc endpoint not valid: " << endpoint.ToString();
 
+  ChannelGroup* group = GetChannelGroup(endpoint);
+  size_t index = 0;
+  if (group->channels.size() > 1) {
+    index = group->next_index.fetch_add(1, std::memory_order_relaxed) % group->channels.size();
+  }
+
   auto ctx = std::make_unique<GrpcContext>();
+  uint64_t cq_index = next_cq_index_.fetch_add(1, std::memory_order_relaxed);
+  ctx->cq = cqs_[cq_index % cqs_.size()].get();
+  ctx->channel = group->channels[index];
+  ctx->stubs = group->stubs[index].get();
+  ctx->cb = std::move(cb);
+  ctx->endpoint = endpoint;
+
+  rpc.Call(ctx.release());
+}
+
+GrpcRpcClient::ChannelGroup* GrpcRpcClient::GetChannelGroup(const EndPoint& endpoint) {
+  size_t hash = EndPointHash(endpoint);
+  for (size_t i = 0; i < kGroupTableSize; ++i) {
+    ChannelGroup* group = group_table_[(hash + i) % kGroupTableSize].load(std::memory_order_acquire);
+    if (group == nullptr) {
+      break;
+    }
+    if (group->endpoint == endpoint) {
+      return group;
+    }
+  }
 
-  std::shared_ptr<grpc::Channel> channel;
+  return GetChannelGroupSlow(endpoint);
+}
+
+GrpcRpcClient::ChannelGroup* GrpcRpcClient::GetChannelGroupSlow(const EndPoint& endpoint) {
+  auto& shard = shards_[EndPointShardIndex(endpoint, kChannelShardNum)];
   {
-    LockGuard lg(&lock_);
-    auto ch = channel_map_.find(endpoint);
-    if (ch == channel_map_.end()) {
-      // TODO: maybe use custome channel
-      channel = grpc::CreateChannel(endpoint.StringAddr(), grpc::InsecureChannelCredentials());
-      channel_map_.insert(std::make_pair(endpoint, channel));
-    } else {
-      channel = CHECK_NOTNULL(ch->second);
+    ReadLockGuard guard(shard.rw_lock);
+    auto iter = shard.channel_groups.find(endpoint);
+    if (iter != shard.channel_groups.end()) {
+      return iter->second.get();
     }
+  }
 
-    ctx->cq = cqs_[next_cq_index_ % cqs_.size()].get();
-    next_cq_index_++;
+  auto new_group = NewChannelGroup(endpoint);
+
+  WriteLockGuard guard(shard.rw_lock);
+  auto iter = shard.channel_groups.find(endpoint);
+  if (iter == shard.channel_groups.end()) {
+    iter = shard.channel_groups.emplace(endpoint, std::move(new_group)).first;
+    PublishChannelGroup(iter->second.get());
   }
+  return iter->second.get();
+}
 
-  CHECK_NOTNULL(channel.get());
-  ctx->channel = std::move(channel);
-  ctx->cb = std::move(cb);
-  ctx->endpoint = endpoint;
+void GrpcRpcClient::PublishChannelGroup(ChannelGroup* group) {
+  LockGuard lg(&publish_lock_);
+  // keep probe sequence short, groups beyond stay reachable by slow path
+  if (group_table_used_ * 4 >= kGroupTableSize * 3) {
+    return;
+  }
 
-  rpc.Call(ctx.release());
+  size_t hash = EndPointHash(group->endpoint);
+  for (size_t i = 0; i < kGroupTableSize; ++i) {
+    auto& slot = group_table_[(hash + i) % kGroupTableSize];
+    if (slot.load(std::memory_order_relaxed) == nullptr) {
+      slot.store(group, std::memory_order_release);
+      group_table_used_++;
+      return;
+    }
+  }
+}
+
+std::unique_ptr<GrpcRpcClient::ChannelGroup> GrpcRpcClient::NewChannelGroup(const EndPoint& endpoint) {
+  int channel_num = std::max(m_options.channel_num_per_endpoint, 1);
+
+  auto group = std::make_unique<ChannelGroup>(endpoint);
+  group->channels.reserve(channel_num);
+  group->stubs.reserve(channel_num);
+  for (int i = 0; i < channel_num; ++i) {
+    grpc::ChannelArguments args;
+    // channels with same args share one subchannel(connection) in global subchannel pool, so make them differ
+    args.SetInt(GRPC_ARG_USE_LOCAL_SUBCHANNEL_POOL, 1);
+    args.SetInt("dingosdk.channel_index", i);
+    if (FLAGS_grpc_max_message_size > 0) {
+      args.SetMaxReceiveMessageSize(static_cast<int>(FLAGS_grpc_max_message_size));
+      args.SetMaxSendMessageSize(static_cast<int>(FLAGS_grpc_max_message_size));
+    }
+    if (FLAGS_grpc_keepalive_time_ms > 0) {
+      args.SetInt(GRPC_ARG_KEEPALIVE_TIME_MS, static_cast<int>(FLAGS_grpc_keepalive_time_ms));
+      args.SetInt(GRPC_ARG_KEEPALIVE_TIMEOUT_MS, static_cast<int>(FLAGS_grpc_keepalive_timeout_ms));
+      args.SetInt(GRPC_ARG_KEEPALIVE_PERMIT_WITHOUT_CALLS, 1);
+    }
+
+    auto channel = grpc::CreateCustomChannel(endpoint.StringAddr(), grpc::InsecureChannelCredentials(), args);
+    CHECK(channel != nullptr) << "Fail create channel endpoint:" << endpoint.ToString();
+
+    group->stubs.push_back(std::make_unique<GrpcStubs>(channel));
+    group->channels.push_back(std::move(channel));
+  }
+
+  return group;
 }
 
 RpcClient* NewRpcClient(const RpcClientOptions& options) {
@@ -15,16 +15,21 @@
 #ifndef DINGODB_SDK_GRPC_RPC_CLIENT_H_
 #define DINGODB_SDK_GRPC_RPC_CLIENT_H_
 
+#include <atomic>
 #include <cstdint>
 #include <map>
 #include <memory>
 #include <thread>
+#include <utility>
 #include <vector>
 
 #include "grpcpp/channel.h"
 #include "grpcpp/completion_queue.h"
+#include "sdk/rpc/grpc/grpc_stubs.h"
 #include "sdk/rpc/rpc_client.h"
 #include "sdk/utils/mutex_lock.h"
+#include "sdk/utils/net_util.h"
+#include "sdk/utils/rw_lock.h"
 
 namespace dingodb {
 namespace sdk {
@@ -40,14 +45,55 @@ class GrpcRpcClient : public RpcClient {
   void SendRpc(Rpc& rpc, RpcCallback cb) override;
 
  private:
+  // channels to one endpoint, each with its own subchannel, picked round robin
+  struct ChannelGroup {
+    explicit ChannelGroup(EndPoint p_endpoint) : endpoint(std::move(p_endpoint)) {}
+
+    const EndPoint endpoint;
+    std::vector<std::shared_ptr<grpc::Channel>> channels;
+    // stubs[i] is created with channels[i], both are immutable once the group is published
+    std::vector<std::unique_ptr<GrpcStubs>> stubs;
+    std::atomic<uint64_t> next_index{0};
+  };
+
+  // endpoints are spread over shards, so creating groups for different stores don't contend on one lock
+  struct ChannelShard {
+    RWLock rw_lock;
+    std::map<EndPoint, std::unique_ptr<ChannelGroup>> channel_groups;
+  };
+
+  static const int kChannelShardNum = 32;
+
+  // open addressing, store endpoints are usually far less than it
+  static const size_t kGroupTableSize = 1024;
+
   void Close();
 
+  // group is never removed, so raw pointer is valid as long as this.
+  // hit in group_table_ only do atomic loads, miss fall back to shards_
+  ChannelGroup* GetChannelGroup(const EndPoint& endpoint);
+
+  ChannelGroup* GetChannelGroupSlow(const EndPoint& endpoint);
+
+  // group is not cached when table is nearly full
+  void PublishChannelGroup(ChannelGroup* group);
+
+  std::unique_ptr<ChannelGroup> NewChannelGroup(const EndPoint& endpoint);
+
+  static void PollCompletionQueue(grpc::CompletionQueue* cq, int index);
+
   Mutex lock_;
   std::vector<std::unique_ptr<grpc::CompletionQueue>> cqs_;
   std::vector<std::thread> workers_;
-  std::map<EndPoint, std::shared_ptr<grpc::Channel>> channel_map_;
   bool opened_{false};
-  int64_t next_cq_index_{0};
+  std::atomic<uint64_t> next_cq_index_{0};
+
+  ChannelShard shards_[kChannelShardNum];
+  // slot is set once under publish_lock_ and never cleared
+  std::atomic<ChannelGroup*> group_table_[kGroupTableSize]{};
+  Mutex publish_lock_;
+  // protected by publish_lock_
+  size_t group_table_used_{0};
 };
 
 }  // namespace sdk
@@ -0,0 +1,63 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_GRPC_STUBS_H_
+#define DINGODB_SDK_GRPC_STUBS_H_
+
+#include <memory>
+#include <tuple>
+
+#include "grpcpp/channel.h"
+#include "proto/coordinator.grpc.pb.h"
+#include "proto/document.grpc.pb.h"
+#include "proto/index.grpc.pb.h"
+#include "proto/meta.grpc.pb.h"
+#include "proto/store.grpc.pb.h"
+#include "proto/version.grpc.pb.h"
+
+namespace dingodb {
+namespace sdk {
+
+// stubs of every service on one channel, created with the channel when its channel group is built and immutable
+// after, so the send path reads them without any lock. owned by the channel group of GrpcRpcClient
+class GrpcStubs {
+ public:
+  explicit GrpcStubs(const std::shared_ptr<grpc::Channel>& channel)
+      : stubs_(pb::coordinator::CoordinatorService::NewStub(channel), pb::meta::MetaService::NewStub(channel),
+               pb::store::StoreService::NewStub(channel), pb::index::IndexService::NewStub(channel),
+               pb::document::DocumentService::NewStub(channel), pb::version::VersionService::NewStub(channel)) {}
+
+  ~GrpcStubs() = default;
+
+  GrpcStubs(const GrpcStubs&) = delete;
+  const GrpcStubs& operator=(const GrpcStubs&) = delete;
+
+  template <class StubType>
+  StubType* Get() const {
+    return std::get<std::unique_ptr<StubType>>(stubs_).get();
+  }
+
+ private:
+  // a new service must be added here before its rpc can be sent
+  std::tuple<std::unique_ptr<pb::coordinator::CoordinatorService::Stub>,
+             std::unique_ptr<pb::meta::MetaService::Stub>, std::unique_ptr<pb::store::StoreService::Stub>,
+             std::unique_ptr<pb::index::IndexService::Stub>, std::unique_ptr<pb::document::DocumentService::Stub>,
+             std::unique_ptr<pb::version::VersionService::Stub>>
+      stubs_;
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_GRPC_STUBS_H_
@@ -18,7 +18,9 @@
 #include <fmt/format.h>
 #include <sys/stat.h>
 
+#include <chrono>
 #include <cstdint>
+#include <map>
 #include <memory>
 #include <string>
 
@@ -35,7 +37,9 @@
 #include "sdk/common/common.h"
 #include "sdk/common/param_config.h"
 #include "sdk/common/rand.h"
+#include "sdk/rpc/grpc/grpc_stubs.h"
 #include "sdk/rpc/rpc.h"
+#include "sdk/rpc/rpc_arena.h"
 #include "sdk/utils/mutex_lock.h"
 #include "sdk/utils/net_util.h"
 
@@ -47,6 +51,8 @@ struct GrpcContext : public RpcContext {
   ~GrpcContext() override = default;
 
   std::shared_ptr<grpc::Channel> channel;
+  // stubs of channel, owned by channel group of GrpcRpcClient which outlive the rpc
+  const GrpcStubs* stubs{nullptr};
   grpc::CompletionQueue* cq;
   EndPoint endpoint;
 };
@@ -55,27 +61,41 @@ template <class RequestType, class ResponseType, class ServiceType, class StubTy
 class UnaryRpc : public Rpc {
  public:
   UnaryRpc(const std::string& cmd) : Rpc(cmd) {
+    if (FLAGS_rpc_enable_arena) {
+      arena = NewRpcArena(GetArenaSizeHint());
+      request = google::protobuf::Arena::CreateMessage<RequestType>(arena.get());
+      response = google::protobuf::Arena::CreateMessage<ResponseType>(arena.get());
+    } else {
+      request = new RequestType;
+      response = new ResponseType;
+    }
     context = std::make_unique<grpc::ClientContext>();
     log_id = RandHelper::RandUInt64();
   }
 
-  ~UnaryRpc() override = default;
+  ~UnaryRpc() override {
+    // messages on arena are freed with arena
+    if (arena == nullptr) {
+      delete request;
+      delete response;
+    }
+  }
 
-  RequestType* MutableRequest() { return &request; }
+  RequestType* MutableRequest() { return request; }
 
-  const RequestType* Request() const { return &request; }
+  const RequestType* Request() const { return request; }
 
-  ResponseType* MutableResponse() { return &response; }
+  ResponseType* MutableResponse() { return response; }
 
-  const ResponseType* Response() const { return &response; }
+  const ResponseType* Response() const { return response; }
 
-  google::protobuf::Message* RawMutableRequest() override { return &request; }
+  google::protobuf::Message* RawMutableRequest() override { return request; }
 
-  const google::protobuf::Message* RawRequest() const override { return &request; }
+  const google::protobuf::Message* RawRequest() const override { return request; }
 
-  google::protobuf::Message* RawMutableResponse() override { return &response; }
+  google::protobuf::Message* RawMutableResponse() override { return response; }
 
-  const google::protobuf::Message* RawResponse() const override { return &response; }
+  const google::protobuf::Message* RawResponse() const override { return response; }
 
   std::string ServiceName() override { return ServiceType::service_full_name(); }
 
@@ -87,6 +107,13 @@ class UnaryRpc : public Rpc {
 
   uint64_t LogId() const override { return log_id; }
 
+  // learn arena usage of this rpc type, so later rpc start with one block large enough for the response
+  void UpdateArenaSizeHint() {
+    if (arena != nullptr) {
+      GetArenaSizeHint().Update(arena->SpaceUsed());
+    }
+  }
+
   void OnRpcDone() override {
     if (!grpc_status.ok()) {
       DINGO_LOG(WARNING) << fmt::format(
@@ -94,70 +121,74 @@ class UnaryRpc : public Rpc {
           context->peer(), static_cast<int>(grpc_status.error_code()), grpc_status.error_message());
       Status err = Status::NetworkError(grpc_status.error_code(), grpc_status.error_message());
       SetStatus(err);
+      // DEADLINE_EXCEEDED is caller side timeout, only UNAVAILABLE means peer is unreachable
+      transport_failure = grpc_status.error_code() == grpc::StatusCode::UNAVAILABLE;
     } else {
       DINGO_LOG(DEBUG) << fmt::format(
           "[sdk.rpc.{}] Success send rpc: {}, endpoint(peer): {}, request: {}, response: {}", log_id, Method(),
-          context->peer(), request.ShortDebugString(), response.ShortDebugString());
+          context->peer(), request->ShortDebugString(), response->ShortDebugString());
     }
 
-    int64_t end_time =
-        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch())
-            .count();
-    std::string str = fmt::format("request_id: {}, status: {}", log_id, status.ToString());
-    if ((end_time - start_time) > FLAGS_rpc_trace_full_info_threshold_us) {
-      // Default log all rpc info if elapse time greater than 1 second
-      str += fmt::format(", request: {}, response: {}", request.ShortDebugString(), response.ShortDebugString());
-      DINGO_LOG(INFO) << fmt::format("[sdk.trace.rpc][{}][{:.6f}s][endpoint({})] Full rpc info {}", Method(),
-                                     (end_time - start_time) / 1e6, context->peer(), str);
+    elapse_time_us = MonotonicUs() - start_time;
+    if (NeedTraceRpcPerformance(elapse_time_us)) {
+      TraceRpcPerformance(elapse_time_us, Method(), context->peer(), log_id, status, *request, *response);
     }
-    TraceRpcPerformance(end_time - start_time, Method(), context->peer(), str);
 
-    grpc_ctx->cb();
+    UpdateArenaSizeHint();
+
+    // callback may retry and replace grpc_ctx, so call it from stack
+    RpcCallback cb = std::move(grpc_ctx->cb);
+    cb();
   }
 
   void Reset() override {
-    response.Clear();
+    response->Clear();
     grpc_status = grpc::Status();
     status = Status::OK();
+    transport_failure = false;
     context->TryCancel();
     context = std::make_unique<grpc::ClientContext>();
+    if (timeout_ms > 0) {
+      context->set_deadline(std::chrono::system_clock::now() + std::chrono::milliseconds(timeout_ms));
+    }
   }
 
   virtual std::unique_ptr<grpc::ClientAsyncResponseReader<ResponseType>> Prepare(StubType* stub,
                                                                                  grpc::CompletionQueue* cq) = 0;
 
+  // send by callback api, done should set grpc_status and call OnRpcDone
+  virtual void AsyncCall(StubType* stub) = 0;
+
   void Call(RpcContext* ctx) override {
     grpc_ctx.reset(CHECK_NOTNULL(dynamic_cast<GrpcContext*>(ctx)));
     CHECK_NOTNULL(grpc_ctx->channel);
+    CHECK_NOTNULL(grpc_ctx->stubs);
     CHECK_NOTNULL(grpc_ctx->cq);
-    grpc::StubOptions options;
-
-    StubType* p_stub = nullptr;
-    {
-      LockGuard lg(&lk);
-      auto iter = stubs.find(grpc_ctx->endpoint);
-      if (iter == stubs.end()) {
-        auto stub = ServiceType::NewStub(grpc_ctx->channel);
-        p_stub = stub.get();
-        UnaryRpc::stubs.insert(std::make_pair(grpc_ctx->endpoint, std::move(stub)));
-      } else {
-        p_stub = iter->second.get();
-      }
-    }
+
+    StubType* p_stub = grpc_ctx->stubs->template Get<StubType>();
     CHECK_NOTNULL(p_stub);
 
     // Record the start time for performance tracing
-    start_time =
-        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch())
-            .count();
+    start_time = MonotonicUs();
 
-    auto reader = Prepare(p_stub, grpc_ctx->cq);
-    reader->Finish(&response, &grpc_status, (void*)this);
+    if (FLAGS_grpc_use_callback_api) {
+      AsyncCall(p_stub);
+    } else {
+      auto reader = Prepare(p_stub, grpc_ctx->cq);
+      reader->Finish(response, &grpc_status, (void*)this);
+    }
   }
 
  protected:
-  RequestType request;
-  ResponseType response;
+  static RpcArenaSizeHint& GetArenaSizeHint() {
+    static RpcArenaSizeHint hint;
+    return hint;
+  }
+
+  // NOTE: arena live across retries, response->Clear() keep memory of repeated fields for reuse
+  std::unique_ptr<google::protobuf::Arena> arena;
+  RequestType* request;
+  ResponseType* response;
   std::unique_ptr<grpc::ClientContext> context;
   grpc::Status grpc_status;
   std::unique_ptr<StubType> stub;
@@ -165,16 +196,8 @@ class UnaryRpc : public Rpc {
   uint64_t log_id{0};
 
   int64_t start_time{0};  // record the start time of the RPC call , use for trace
-
-  static std::map<EndPoint, std::unique_ptr<StubType>> stubs;
-  static Mutex lk;
 };
 
-template <class RequestType, class ResponseType, class ServiceType, class StubType>
-std::map<EndPoint, std::unique_ptr<StubType>> UnaryRpc<RequestType, ResponseType, ServiceType, StubType>::stubs;
-template <class RequestType, class ResponseType, class ServiceType, class StubType>
-Mutex UnaryRpc<RequestType, ResponseType, ServiceType, StubType>::lk;
-
 #define DECLARE_UNARY_RPC_INNER(NS, SERVICE, METHOD, REQ_RSP_PREFIX)                                                 \
   class METHOD##Rpc final                                                                                            \
       : public UnaryRpc<NS::REQ_RSP_PREFIX##Request, NS::REQ_RSP_PREFIX##Response, NS::SERVICE, NS::SERVICE::Stub> { \
@@ -184,10 +207,12 @@ Mutex UnaryRpc<RequestType, ResponseType, ServiceType, StubType>::lk;
     explicit METHOD##Rpc();                                                                                          \
     explicit METHOD##Rpc(const std::string& cmd);                                                                    \
     ~METHOD##Rpc() override;                                                                                         \
-    std::string Method() const override { return ConstMethod(); }                                                    \
+    const char* Method() const override { return ConstMethod(); }                                                    \
+    std::unique_ptr<Rpc> Clone() const override;                                                                     \
     std::unique_ptr<grpc::ClientAsyncResponseReader<NS::REQ_RSP_PREFIX##Response>> Prepare(                          \
         NS::SERVICE::Stub* stub, grpc::CompletionQueue* cq) override;                                                \
-    static std::string ConstMethod();                                                                                \
+    void AsyncCall(NS::SERVICE::Stub* stub) override;                                                                \
+    static const char* ConstMethod();                                                                                \
   };
 
 #define DECLARE_UNARY_RPC(NS, SERVICE, METHOD)                                                       \
@@ -199,10 +224,12 @@ Mutex UnaryRpc<RequestType, ResponseType, ServiceType, StubType>::lk;
     explicit METHOD##Rpc();                                                                          \
     explicit METHOD##Rpc(const std::string& cmd);                                                    \
     ~METHOD##Rpc() override;                                                                         \
-    std::string Method() const override { return ConstMethod(); }                                    \
+    const char* Method() const override { return ConstMethod(); }                                    \
+    std::unique_ptr<Rpc> Clone() const override;                                                     \
     std::unique_ptr<grpc::ClientAsyncResponseReader<NS::METHOD##Response>> Prepare(                  \
         NS::SERVICE::Stub* stub, grpc::CompletionQueue* cq) override;                                \
-    static std::string ConstMethod();                                                                \
+    void AsyncCall(NS::SERVICE::Stub* stub) override;                                                \
+    static const char* ConstMethod();                                                                \
   };
 
 #define DEFINE_UNAEY_RPC_INNER(NS, SERVICE, METHOD, REQ_RSP_PREFIX)                                    \
@@ -211,9 +238,24 @@ Mutex UnaryRpc<RequestType, ResponseType, ServiceType, StubType>::lk;
   METHOD##Rpc::~METHOD##Rpc() = default;                                                               \
   std::unique_ptr<grpc::ClientAsyncResponseReader<NS::REQ_RSP_PREFIX##Response>> METHOD##Rpc::Prepare( \
       NS::SERVICE::Stub* stub, grpc::CompletionQueue* cq) {                                            \
-    return stub->Async##METHOD(MutableContext(), request, cq);                                         \
+    return stub->Async##METHOD(MutableContext(), *request, cq);                                        \
   }                                                                                                    \
-  std::string METHOD##Rpc::ConstMethod() { return fmt::format("{}.{}Rpc", NS::SERVICE::service_full_name(), #METHOD); }
+  void METHOD##Rpc::AsyncCall(NS::SERVICE::Stub* stub) {                                               \
+    stub->async()->METHOD(MutableContext(), request, response, [this](grpc::Status s) {                \
+      grpc_status = std::move(s);                                                                      \
+      OnRpcDone();                                                                                     \
+    });                                                                                                \
+  }                                                                                                    \
+  std::unique_ptr<Rpc> METHOD##Rpc::Clone() const {                                                    \
+    auto rpc = std::make_unique<METHOD##Rpc>(cmd);                                                     \
+    rpc->MutableRequest()->CopyFrom(*request);                                                         \
+    return rpc;                                                                                        \
+  }                                                                                                    \
+  const char* METHOD##Rpc::ConstMethod() {                                                             \
+    static const std::string kMethod =                                                                 \
+        fmt::format("{}.{}Rpc", NS::SERVICE::service_full_name(), #METHOD);                            \
+    return kMethod.c_str();                                                                            \
+  }
 
 #define DEFINE_UNAEY_RPC(NS, SERVICE, METHOD)                                                  \
   METHOD##Rpc::METHOD##Rpc() : METHOD##Rpc("") {}                                              \
@@ -221,9 +263,24 @@ Mutex UnaryRpc<RequestType, ResponseType, ServiceType, StubType>::lk;
   METHOD##Rpc::~METHOD##Rpc() = default;                                                       \
   std::unique_ptr<grpc::ClientAsyncResponseReader<NS::METHOD##Response>> METHOD##Rpc::Prepare( \
       NS::SERVICE::Stub* stub, grpc::CompletionQueue* cq) {                                    \
-    return stub->Async##METHOD(MutableContext(), request, cq);                                 \
+    return stub->Async##METHOD(MutableContext(), *request, cq);                                \
   }                                                                                            \
-  std::string METHOD##Rpc::ConstMethod() { return fmt::format("{}.{}Rpc", NS::SERVICE::service_full_name(), #METHOD); }
+  void METHOD##Rpc::AsyncCall(NS::SERVICE::Stub* stub) {                                       \
+    stub->async()->METHOD(MutableContext(), request, response, [this](grpc::Status s) {        \
+      grpc_status = std::move(s);                                                              \
+      OnRpcDone();                                                                             \
+    });                                                                                        \
+  }                                                                                            \
+  std::unique_ptr<Rpc> METHOD##Rpc::Clone() const {                                            \
+    auto rpc = std::make_unique<METHOD##Rpc>(cmd);                                             \
+    rpc->MutableRequest()->CopyFrom(*request);                                                 \
+    return rpc;                                                                                \
+  }                                                                                            \
+  const char* METHOD##Rpc::ConstMethod() {                                                     \
+    static const std::string kMethod =                                                         \
+        fmt::format("{}.{}Rpc", NS::SERVICE::service_full_name(), #METHOD);                    \
+    return kMethod.c_str();                                                                    \
+  }
 
 }  // namespace sdk
 }  // namespace dingodb
@@ -0,0 +1,55 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/rpc/hedge_budget.h"
+
+#include <algorithm>
+
+namespace dingodb {
+namespace sdk {
+
+void HedgeBudget::OnRequest(int64_t budget_percent) {
+  requests_.fetch_add(1, std::memory_order_relaxed);
+
+  int64_t old_value = tokens_.load(std::memory_order_relaxed);
+  int64_t new_value;
+  do {
+    new_value = std::min(old_value + budget_percent, kMaxTokens);
+  } while (!tokens_.compare_exchange_weak(old_value, new_value, std::memory_order_relaxed));
+}
+
+bool HedgeBudget::TryAcquire() {
+  int64_t old_value = tokens_.load(std::memory_order_relaxed);
+  do {
+    if (old_value < kHedgeCost) {
+      budget_exhausted_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+  } while (!tokens_.compare_exchange_weak(old_value, old_value - kHedgeCost, std::memory_order_relaxed));
+
+  hedged_.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+HedgeMetrics HedgeBudget::GetMetrics() const {
+  HedgeMetrics metrics;
+  metrics.requests = requests_.load(std::memory_order_relaxed);
+  metrics.hedged = hedged_.load(std::memory_order_relaxed);
+  metrics.hedge_won = hedge_won_.load(std::memory_order_relaxed);
+  metrics.budget_exhausted = budget_exhausted_.load(std::memory_order_relaxed);
+  return metrics;
+}
+
+}  // namespace sdk
+}  // namespace dingodb
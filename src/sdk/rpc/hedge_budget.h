@@ -0,0 +1,66 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_HEDGE_BUDGET_H_
+#define DINGODB_SDK_HEDGE_BUDGET_H_
+
+#include <atomic>
+#include <cstdint>
+
+namespace dingodb {
+namespace sdk {
+
+struct HedgeMetrics {
+  int64_t requests{0};          // rpc eligible for hedge
+  int64_t hedged{0};            // duplicate rpc sent
+  int64_t hedge_won{0};         // duplicate rpc answered first
+  int64_t budget_exhausted{0};  // hedge skipped because of budget
+};
+
+// Token bucket limit hedged rpc to a percent of eligible rpc.
+// Each eligible rpc earn budget_percent tokens, each hedge cost 100 tokens, so hedges never exceed budget_percent% of
+// requests plus a small burst.
+class HedgeBudget {
+ public:
+  HedgeBudget() = default;
+  ~HedgeBudget() = default;
+
+  HedgeBudget(const HedgeBudget&) = delete;
+  const HedgeBudget& operator=(const HedgeBudget&) = delete;
+
+  void OnRequest(int64_t budget_percent);
+
+  bool TryAcquire();
+
+  void OnHedgeWon() { hedge_won_.fetch_add(1, std::memory_order_relaxed); }
+
+  HedgeMetrics GetMetrics() const;
+
+  static constexpr int64_t kHedgeCost = 100;
+  // allow a burst of hedges after idle
+  static constexpr int64_t kMaxTokens = 10 * kHedgeCost;
+
+ private:
+  std::atomic<int64_t> tokens_{kMaxTokens};
+
+  std::atomic<int64_t> requests_{0};
+  std::atomic<int64_t> hedged_{0};
+  std::atomic<int64_t> hedge_won_{0};
+  std::atomic<int64_t> budget_exhausted_{0};
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_HEDGE_BUDGET_H_
@@ -15,7 +15,9 @@
 #ifndef DINGODB_SDK_RPC_H_
 #define DINGODB_SDK_RPC_H_
 
+#include <chrono>
 #include <cstdint>
+#include <memory>
 #include <string>
 
 #include "dingosdk/status.h"
@@ -50,6 +52,20 @@ class Rpc {
 
   int GetRetryTimes() const { return retry_times; }
 
+  // elapse time of last call, set when rpc done
+  int64_t GetElapseTimeUs() const { return elapse_time_us; }
+
+  // result of this call is taken from a clone, e.g. hedged request
+  void SetElapseTimeUs(int64_t p_elapse_time_us) { elapse_time_us = p_elapse_time_us; }
+
+  // timeout of next call, take effect in Reset(), 0 means FLAGS_rpc_time_out_ms
+  void SetTimeoutMs(int64_t p_timeout_ms) { timeout_ms = p_timeout_ms; }
+
+  int64_t GetTimeoutMs() const { return timeout_ms; }
+
+  // last call fail to reach the peer, e.g. connect refused or reset, client side timeout is not included
+  bool IsTransportFailure() const { return transport_failure; }
+
   virtual google::protobuf::Message* RawMutableRequest() = 0;
 
   virtual const google::protobuf::Message* RawRequest() const = 0;
@@ -62,23 +78,39 @@ class Rpc {
 
   virtual std::string ServiceFullName() = 0;
 
-  virtual std::string Method() const = 0;
+  // interned name like "StoreService.KvGetRpc", same pointer for all rpc of a method and valid for process lifetime
+  virtual const char* Method() const = 0;
 
   virtual void Reset() = 0;
 
+  // context owned by the rpc and reused across retries, nullptr when transport allocate one per call
+  virtual RpcContext* MutableRpcContext() { return nullptr; }
+
   virtual void Call(RpcContext* ctx) = 0;
 
   virtual void OnRpcDone() = 0;
 
   virtual uint64_t LogId() const = 0;
 
+  // new rpc of the same method with a copy of request, used for hedged request, nullptr means not support
+  virtual std::unique_ptr<Rpc> Clone() const { return nullptr; }
+
   StatusCallback call_back;
 
  protected:
+  // for elapse time, not affected by wall clock adjustment
+  static int64_t MonotonicUs() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+
   std::string cmd;
   EndPoint end_point;
   Status status;
   int retry_times{0};
+  int64_t elapse_time_us{0};
+  int64_t timeout_ms{0};
+  bool transport_failure{false};
 };
 
 }  // namespace sdk
@@ -0,0 +1,61 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_RPC_ARENA_H_
+#define DINGODB_SDK_RPC_ARENA_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include "google/protobuf/arena.h"
+
+namespace dingodb {
+namespace sdk {
+
+// recent arena usage of one rpc type, used as initial block size of new arena,
+// so most response fit in one block
+class RpcArenaSizeHint {
+ public:
+  static const int64_t kMinBlockSize = 256;
+  static const int64_t kMaxBlockSize = 4 * 1024 * 1024;
+
+  RpcArenaSizeHint() = default;
+  ~RpcArenaSizeHint() = default;
+
+  size_t Get() const { return bytes_.load(std::memory_order_relaxed); }
+
+  // ewma with weight 1/8
+  void Update(int64_t used_bytes) {
+    int64_t old_value = bytes_.load(std::memory_order_relaxed);
+    int64_t new_value = old_value + ((used_bytes - old_value) >> 3);
+    bytes_.store(std::clamp(new_value, kMinBlockSize, kMaxBlockSize), std::memory_order_relaxed);
+  }
+
+ private:
+  std::atomic<int64_t> bytes_{kMinBlockSize};
+};
+
+inline std::unique_ptr<google::protobuf::Arena> NewRpcArena(const RpcArenaSizeHint& hint) {
+  google::protobuf::ArenaOptions options;
+  options.start_block_size = hint.Get();
+  options.max_block_size = std::max(options.start_block_size, options.max_block_size);
+  return std::make_unique<google::protobuf::Arena>(options);
+}
+
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_RPC_ARENA_H_
@@ -15,8 +15,14 @@
 #ifndef DINGODB_SDK_RPC_CLIENT_H_
 #define DINGODB_SDK_RPC_CLIENT_H_
 
+#include <string>
+
 #include "rpc.h"
 #include "sdk/common/param_config.h"
+#include "sdk/rpc/concurrency_limiter.h"
+#include "sdk/rpc/endpoint_stats.h"
+#include "sdk/rpc/hedge_budget.h"
+#include "sdk/rpc/rpc_metrics.h"
 #include "sdk/utils/callback.h"
 
 namespace dingodb {
@@ -26,11 +32,15 @@ struct RpcClientOptions {
   int32_t connect_timeout_ms;
   int32_t timeout_ms;
   int max_retry;
+  int channel_num_per_endpoint;
+  std::string connection_type;
 
   RpcClientOptions()
       : connect_timeout_ms(FLAGS_rpc_channel_timeout_ms),
         timeout_ms(FLAGS_rpc_channel_connect_timeout_ms),
-        max_retry(FLAGS_rpc_max_retry) {}
+        max_retry(FLAGS_rpc_max_retry),
+        channel_num_per_endpoint(FLAGS_rpc_channel_num_per_endpoint),
+        connection_type(FLAGS_rpc_channel_connection_type) {}
 };
 
 class RpcClient {
@@ -46,8 +56,20 @@ class RpcClient {
 
   virtual void SendRpc(Rpc& rpc, RpcCallback cb) = 0;
 
+  EndPointStats& GetEndPointStats() { return endpoint_stats_; }
+
+  HedgeBudget& GetHedgeBudget() { return hedge_budget_; }
+
+  ConcurrencyLimiter& GetConcurrencyLimiter() { return concurrency_limiter_; }
+
+  RpcMetrics& GetRpcMetrics() { return rpc_metrics_; }
+
  protected:
   RpcClientOptions m_options;
+  EndPointStats endpoint_stats_;
+  HedgeBudget hedge_budget_;
+  ConcurrencyLimiter concurrency_limiter_;
+  RpcMetrics rpc_metrics_;
 };
 
 RpcClient* NewRpcClient(const RpcClientOptions& options);
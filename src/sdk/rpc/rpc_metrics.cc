@@ -0,0 +1,137 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/rpc/rpc_metrics.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "fmt/format.h"
+#include "proto/error.pb.h"
+
+namespace dingodb {
+namespace sdk {
+
+void RpcMetrics::OnRpcDone(const char* method, const EndPoint& end_point, int64_t elapse_time_us, bool success) {
+  inflight_.fetch_sub(1, std::memory_order_relaxed);
+
+  Entry* entry = GetOrCreateEntry(method, end_point);
+  entry->latency.Record(elapse_time_us);
+  if (!success) {
+    entry->error_count.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void RpcMetrics::OnRetry(const Status& status) {
+  // errno of network error is the rpc framework error code, not pb::error::Errno
+  std::string error;
+  if (status.IsNetworkError()) {
+    error = fmt::format("NETWORK_ERROR_{}", status.Errno());
+  } else if (pb::error::Errno_IsValid(status.Errno())) {
+    error = pb::error::Errno_Name(static_cast<pb::error::Errno>(status.Errno()));
+  } else {
+    error = std::to_string(status.Errno());
+  }
+
+  LockGuard guard(&retry_mutex_);
+  retry_counts_[error]++;
+}
+
+void RpcMetrics::GetMetrics(ClientMetrics& metrics) {
+  std::vector<std::pair<Key, std::shared_ptr<Entry>>> entries;
+  {
+    ReadLockGuard guard(rw_lock_);
+    entries.assign(entries_.begin(), entries_.end());
+  }
+
+  metrics.rpcs.clear();
+  metrics.rpcs.reserve(entries.size());
+  for (const auto& [key, entry] : entries) {
+    RpcLatencyMetrics rpc;
+    rpc.method = key.first;
+    rpc.end_point = key.second.ToString();
+    rpc.error_count = entry->error_count.load(std::memory_order_relaxed);
+    rpc.latency = entry->latency.Snapshot();
+    metrics.rpcs.push_back(std::move(rpc));
+  }
+
+  {
+    LockGuard guard(&retry_mutex_);
+    metrics.retry_counts = retry_counts_;
+  }
+
+  metrics.inflight_rpc = GetInflight();
+}
+
+size_t RpcMetrics::EntryHash(const char* method, const EndPoint& end_point) {
+  size_t hash = std::hash<const void*>()(method);
+  return hash * 31 + EndPointHash(end_point);
+}
+
+RpcMetrics::Entry* RpcMetrics::GetOrCreateEntry(const char* method, const EndPoint& end_point) {
+  size_t hash = EntryHash(method, end_point);
+  for (size_t i = 0; i < kEntryTableSize; ++i) {
+    Entry* entry = entry_table_[(hash + i) % kEntryTableSize].load(std::memory_order_acquire);
+    if (entry == nullptr) {
+      break;
+    }
+    if (entry->method == method && entry->end_point == end_point) {
+      return entry;
+    }
+  }
+
+  return GetOrCreateEntrySlow(method, end_point);
+}
+
+void RpcMetrics::PublishEntryUnlocked(Entry* entry, size_t hash) {
+  // keep probe chains short, the rest are served from entries_
+  if (entry_table_used_ * 4 >= kEntryTableSize * 3) {
+    return;
+  }
+
+  for (size_t i = 0; i < kEntryTableSize; ++i) {
+    auto& slot = entry_table_[(hash + i) % kEntryTableSize];
+    if (slot.load(std::memory_order_relaxed) == nullptr) {
+      slot.store(entry, std::memory_order_release);
+      entry_table_used_++;
+      return;
+    }
+  }
+}
+
+RpcMetrics::Entry* RpcMetrics::GetOrCreateEntrySlow(const char* method, const EndPoint& end_point) {
+  Key key(method, end_point);
+  {
+    ReadLockGuard guard(rw_lock_);
+    auto iter = entries_.find(key);
+    if (iter != entries_.end()) {
+      return iter->second.get();
+    }
+  }
+
+  WriteLockGuard guard(rw_lock_);
+  auto iter = entries_.find(key);
+  if (iter != entries_.end()) {
+    return iter->second.get();
+  }
+
+  auto entry = std::make_shared<Entry>(method, end_point);
+  entries_.emplace(std::move(key), entry);
+  PublishEntryUnlocked(entry.get(), EntryHash(method, end_point));
+  return entry.get();
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,100 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_RPC_METRICS_H_
+#define DINGODB_SDK_RPC_METRICS_H_
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "dingosdk/metric.h"
+#include "dingosdk/status.h"
+#include "sdk/utils/latency_histogram.h"
+#include "sdk/utils/mutex_lock.h"
+#include "sdk/utils/net_util.h"
+#include "sdk/utils/rw_lock.h"
+
+namespace dingodb {
+namespace sdk {
+
+// latency histogram of each (method, store endpoint), retry counts by error and in-flight store rpc
+class RpcMetrics {
+ public:
+  RpcMetrics() = default;
+  ~RpcMetrics() = default;
+
+  RpcMetrics(const RpcMetrics&) = delete;
+  const RpcMetrics& operator=(const RpcMetrics&) = delete;
+
+  void OnRpcStart() { inflight_.fetch_add(1, std::memory_order_relaxed); }
+
+  // must be called once for each OnRpcStart, method is the interned name from Rpc::Method()
+  void OnRpcDone(const char* method, const EndPoint& end_point, int64_t elapse_time_us, bool success);
+
+  // status is the error which cause the retry
+  void OnRetry(const Status& status);
+
+  int64_t GetInflight() const { return inflight_.load(std::memory_order_relaxed); }
+
+  // fill rpcs, retry_counts and inflight_rpc
+  void GetMetrics(ClientMetrics& metrics);
+
+ private:
+  struct Entry {
+    Entry(const char* p_method, EndPoint p_end_point) : method(p_method), end_point(std::move(p_end_point)) {}
+
+    const char* const method;
+    const EndPoint end_point;
+    LatencyHistogram latency;
+    std::atomic<int64_t> error_count{0};
+  };
+
+  // method name is interned, compare by pointer so lookup in rpc done path never build a string
+  using Key = std::pair<const char*, EndPoint>;
+
+  // open addressing, method x store endpoint is usually far less than it
+  static const size_t kEntryTableSize = 1024;
+
+  // entry is never removed, so raw pointer is valid as long as this.
+  // hit in entry_table_ only do atomic loads, miss fall back to entries_
+  Entry* GetOrCreateEntry(const char* method, const EndPoint& end_point);
+
+  Entry* GetOrCreateEntrySlow(const char* method, const EndPoint& end_point);
+
+  // must hold write lock of rw_lock_, entry is not cached when table is nearly full
+  void PublishEntryUnlocked(Entry* entry, size_t hash);
+
+  static size_t EntryHash(const char* method, const EndPoint& end_point);
+
+  RWLock rw_lock_;
+  std::map<Key, std::shared_ptr<Entry>> entries_;
+  // slot is set once under write lock of rw_lock_ and never cleared
+  std::atomic<Entry*> entry_table_[kEntryTableSize]{};
+  // protected by rw_lock_
+  size_t entry_table_used_{0};
+
+  Mutex retry_mutex_;
+  std::map<std::string, int64_t> retry_counts_;
+
+  std::atomic<int64_t> inflight_{0};
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_RPC_METRICS_H_
@@ -15,8 +15,12 @@
 
 #include <fmt/format.h>
 
+#include <algorithm>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <utility>
+#include <vector>
 
 #include "common/logging.h"
 #include "dingosdk/status.h"
@@ -26,18 +30,81 @@
 #include "proto/error.pb.h"
 #include "sdk/client_stub.h"
 #include "sdk/common/common.h"
+#include "sdk/common/deadline.h"
 #include "sdk/common/helper.h"
 #include "sdk/common/param_config.h"
+#include "sdk/common/rand.h"
 #include "sdk/utils/async_util.h"
+#include "sdk/utils/mutex_lock.h"
 
 namespace dingodb {
 namespace sdk {
 
+enum ReadPolicy : uint8_t { kReadLeader, kReadAnyReplica, kReadNearestReplica };
+
+static ReadPolicy GetReadPolicy() {
+  const std::string& policy = FLAGS_store_read_policy;
+  if (policy == "any") {
+    return kReadAnyReplica;
+  } else if (policy == "nearest") {
+    return kReadNearestReplica;
+  }
+  return kReadLeader;
+}
+
+struct HedgeContext {
+  Mutex mutex;
+  // valid until finished is set
+  StoreRpcController* controller{nullptr};
+  std::shared_ptr<RpcClient> rpc_client;
+  std::unique_ptr<Rpc> primary;
+  std::unique_ptr<Rpc> hedge;
+  // concurrency limit slot held by each clone, released by its own callback
+  EndPoint primary_limit_end_point;
+  EndPoint hedge_limit_end_point;
+  int inflight{0};
+  bool hedge_sent{false};
+  bool finished{false};
+};
+
+static void SendRpc(RpcClient& rpc_client, Rpc& rpc, RpcCallback cb) {
+  rpc_client.GetRpcMetrics().OnRpcStart();
+  rpc_client.SendRpc(rpc, std::move(cb));
+}
+
+// release the concurrency limit slot held by rpc, if any
+static void ReleaseConcurrencyLimit(RpcClient& rpc_client, EndPoint& limit_end_point, Rpc& rpc) {
+  if (!limit_end_point.IsValid()) {
+    return;
+  }
+
+  // timeout and store busy mean overload, other errors say nothing about load.
+  // timeout clipped by caller deadline only says the caller ran out of time, not that the store is slow
+  Status status = rpc.GetStatus();
+  bool deadline_timeout = !rpc.IsTransportFailure() && rpc.GetTimeoutMs() > 0 &&
+                          rpc.GetTimeoutMs() < FLAGS_rpc_time_out_ms;
+  bool overload = (status.IsNetworkError() && !deadline_timeout) ||
+                  (status.ok() && GetRpcResponseError(rpc).errcode() == pb::error::Errno::EREQUEST_FULL);
+  rpc_client.GetConcurrencyLimiter().Release(limit_end_point, overload, rpc.GetElapseTimeUs());
+  limit_end_point = EndPoint();
+}
+
+// every rpc sent by SendRpc must be recorded once
+static void RecordRpcDone(RpcClient& rpc_client, Rpc& rpc) {
+  bool success = rpc.GetStatus().ok();
+  rpc_client.GetEndPointStats().Record(rpc.GetEndPoint(), rpc.GetElapseTimeUs(), success);
+  rpc_client.GetRpcMetrics().OnRpcDone(rpc.Method(), rpc.GetEndPoint(), rpc.GetElapseTimeUs(), success);
+}
+
 StoreRpcController::StoreRpcController(const ClientStub& stub, Rpc& rpc, RegionPtr region)
-    : stub_(stub), rpc_(rpc), region_(std::move(region)), rpc_retry_times_(0) {}
+    : stub_(stub),
+      rpc_(rpc),
+      region_(std::move(region)),
+      rpc_retry_times_(0),
+      call_ctx_(CurrentCallContext()) {}
 
 StoreRpcController::StoreRpcController(const ClientStub& stub, Rpc& rpc)
-    : stub_(stub), rpc_(rpc), region_(nullptr), rpc_retry_times_(0) {}
+    : stub_(stub), rpc_(rpc), region_(nullptr), rpc_retry_times_(0), call_ctx_(CurrentCallContext()) {}
 
 StoreRpcController::~StoreRpcController() = default;
 
@@ -52,10 +119,23 @@ Status StoreRpcController::Call() {
 
 void StoreRpcController::AsyncCall(StatusCallback cb) {
   call_back_.swap(cb);
+  if (NeedTrace(call_ctx_)) {
+    span_ = Span::Start(rpc_.Method(), call_ctx_);
+    span_.SetRegionId(region_ != nullptr ? region_->RegionId() : 0);
+    call_ctx_ = span_.ChildContext(call_ctx_);
+  }
+
   DoAsyncCall();
 }
 
 void StoreRpcController::DoAsyncCall() {
+  if (IsDeadlineExpired(call_ctx_.deadline_ms)) {
+    status_ = Status::TimedOut(fmt::format("deadline exceeded before send, retry({}) last status({})", rpc_retry_times_,
+                                           status_.ToString()));
+    FireCallback();
+    return;
+  }
+
   if (!PreCheck()) {
     FireCallback();
     return;
@@ -82,8 +162,11 @@ bool StoreRpcController::PreCheck() {
 
 bool StoreRpcController::PrepareRpc() {
   if (NeedPickLeader()) {
+    replica_read_ = NeedPickReadReplica();
+
     EndPoint next_leader;
-    if (!PickNextLeader(next_leader)) {
+    bool picked = replica_read_ ? PickReadReplica(next_leader) : PickNextLeader(next_leader);
+    if (!picked) {
       status_ = Status::Aborted("not found leader");
       return false;
     }
@@ -92,6 +175,9 @@ bool StoreRpcController::PrepareRpc() {
     rpc_.SetEndPoint(next_leader);
   }
 
+  if (call_ctx_.deadline_ms != kNoDeadline) {
+    rpc_.SetTimeoutMs(ClipTimeoutMs(FLAGS_rpc_time_out_ms, call_ctx_.deadline_ms));
+  }
   rpc_.Reset();
 
   return true;
@@ -100,21 +186,235 @@ bool StoreRpcController::PrepareRpc() {
 void StoreRpcController::SendStoreRpc() {
   CHECK(region_.get() != nullptr) << "region should not nullptr.";
 
-  MaybeDelay();
-  stub_.GetRpcClient()->SendRpc(rpc_, [this] { SendStoreRpcCallBack(); });
+  // attempt span include the time waiting for concurrency limit
+  attempt_span_ = Span::Start("rpc_attempt", call_ctx_);
+  attempt_span_.SetLogId(rpc_.LogId());
+  attempt_span_.SetRegionId(region_->RegionId());
+
+  if (FLAGS_store_enable_concurrency_limit) {
+    EndPoint end_point = rpc_.GetEndPoint();
+    auto result = stub_.GetRpcClient()->GetConcurrencyLimiter().Acquire(
+        end_point, call_ctx_.deadline_ms, [this, end_point](const Status& status) {
+          if (!status.ok()) {
+            // deadline passed in queue, sending it now only waste a slot of the store
+            status_ = status;
+            attempt_span_.End(status_);
+            FireCallback();
+            return;
+          }
+
+          limit_end_point_ = end_point;
+          DoSendStoreRpc();
+        },
+        stub_.GetActuator());
+
+    if (result == ConcurrencyLimiter::kQueued) {
+      return;
+    } else if (result == ConcurrencyLimiter::kRejected) {
+      status_ = Status::ServiceUnavailable(pb::error::EREQUEST_FULL,
+                                           fmt::format("store({}) concurrency limit queue is full", end_point.ToString()));
+      attempt_span_.End(status_);
+      FireCallback();
+      return;
+    }
+
+    limit_end_point_ = end_point;
+  }
+
+  DoSendStoreRpc();
+}
+
+void StoreRpcController::DoSendStoreRpc() {
+  hedge_attempt_ = false;
+  if (NeedHedge()) {
+    SendStoreRpcWithHedge();
+    return;
+  }
+
+  SendRpc(*stub_.GetRpcClient(), rpc_, [this] { SendStoreRpcCallBack(); });
+}
+
+bool StoreRpcController::NeedHedge() {
+  // duplicate is sent to another replica, so only replica read can be hedged
+  return FLAGS_store_enable_hedge_read && replica_read_ && region_->ReplicaEndPoint().size() > 1;
+}
+
+void StoreRpcController::SendStoreRpcWithHedge() {
+  auto rpc_client = stub_.GetRpcClient();
+  int64_t tail_us =
+      rpc_client->GetEndPointStats().GetTailLatencyUs(rpc_.GetEndPoint(), FLAGS_store_hedge_deviation_factor);
+  std::unique_ptr<Rpc> primary = (tail_us > 0) ? rpc_.Clone() : nullptr;
+  if (primary == nullptr) {
+    // no latency sample yet or rpc not support clone
+    SendRpc(*rpc_client, rpc_, [this] { SendStoreRpcCallBack(); });
+    return;
+  }
+
+  rpc_client->GetHedgeBudget().OnRequest(FLAGS_store_hedge_budget_percent);
+
+  auto ctx = std::make_shared<HedgeContext>();
+  ctx->controller = this;
+  ctx->rpc_client = rpc_client;
+  primary->SetEndPoint(rpc_.GetEndPoint());
+  primary->SetTimeoutMs(rpc_.GetTimeoutMs());
+  primary->Reset();
+  ctx->primary = std::move(primary);
+  ctx->inflight = 1;
+  // primary clone take over the slot acquired for rpc_
+  ctx->primary_limit_end_point = limit_end_point_;
+  limit_end_point_ = EndPoint();
+
+  int64_t delay_ms = std::max((tail_us + 999) / 1000, FLAGS_store_hedge_min_delay_ms);
+  stub_.GetActuator()->Schedule([ctx] { SendHedgeRpc(ctx); }, delay_ms);
+
+  // NOTE: controller may be done inside SendRpc, don't touch this after it
+  Rpc* rpc = ctx->primary.get();
+  SendRpc(*rpc_client, *rpc, [ctx, rpc] { HedgeRpcCallback(ctx, rpc); });
+}
+
+void StoreRpcController::SendHedgeRpc(const std::shared_ptr<HedgeContext>& ctx) {
+  Rpc* hedge = nullptr;
+  {
+    LockGuard guard(&ctx->mutex);
+    if (ctx->finished || ctx->hedge_sent) {
+      return;
+    }
+
+    auto* controller = ctx->controller;
+    EndPoint end_point;
+    if (!controller->PickHedgeEndPoint(ctx->primary->GetEndPoint(), end_point)) {
+      return;
+    }
+
+    // hedge never wait for a slot, a busy replica is a bad hedge target anyway
+    auto& limiter = ctx->rpc_client->GetConcurrencyLimiter();
+    if (FLAGS_store_enable_concurrency_limit && !limiter.TryAcquire(end_point)) {
+      return;
+    }
+
+    if (!ctx->rpc_client->GetHedgeBudget().TryAcquire()) {
+      if (FLAGS_store_enable_concurrency_limit) {
+        limiter.Release(end_point, false, 0);
+      }
+      return;
+    }
+
+    if (FLAGS_store_enable_concurrency_limit) {
+      ctx->hedge_limit_end_point = end_point;
+    }
+
+    ctx->hedge = controller->rpc_.Clone();
+    ctx->hedge->SetEndPoint(end_point);
+    ctx->hedge->SetTimeoutMs(ClipTimeoutMs(FLAGS_rpc_time_out_ms, controller->call_ctx_.deadline_ms));
+    ctx->hedge->Reset();
+    ctx->hedge_sent = true;
+    ctx->inflight++;
+    hedge = ctx->hedge.get();
+
+    DINGO_LOG(DEBUG) << fmt::format("[sdk.rpc.{}] method:{} hedge read region({}) from {} to {}.",
+                                    controller->rpc_.LogId(), controller->rpc_.Method(),
+                                    controller->region_->RegionId(), ctx->primary->GetEndPoint().ToString(),
+                                    end_point.ToString());
+  }
+
+  SendRpc(*ctx->rpc_client, *hedge, [ctx, hedge] { HedgeRpcCallback(ctx, hedge); });
+}
+
+void StoreRpcController::HedgeRpcCallback(const std::shared_ptr<HedgeContext>& ctx, Rpc* rpc) {
+  RecordRpcDone(*ctx->rpc_client, *rpc);
+  ReleaseConcurrencyLimit(*ctx->rpc_client,
+                          rpc == ctx->primary.get() ? ctx->primary_limit_end_point : ctx->hedge_limit_end_point, *rpc);
+
+  StoreRpcController* controller = nullptr;
+  {
+    LockGuard guard(&ctx->mutex);
+    ctx->inflight--;
+    if (ctx->finished) {
+      return;
+    }
+
+    // an error is not an answer while the other rpc is still in flight
+    bool answered = rpc->GetStatus().ok() && GetRpcResponseError(*rpc).errcode() == pb::error::Errno::OK;
+    if (!answered && ctx->inflight > 0) {
+      return;
+    }
+
+    ctx->finished = true;
+    controller = ctx->controller;
+  }
+
+  if (rpc != ctx->primary.get()) {
+    ctx->rpc_client->GetHedgeBudget().OnHedgeWon();
+  }
+
+  controller->HedgeRpcDone(*rpc);
+}
+
+void StoreRpcController::HedgeRpcDone(Rpc& winner) {
+  rpc_.SetEndPoint(winner.GetEndPoint());
+  rpc_.SetStatus(winner.GetStatus());
+  rpc_.SetElapseTimeUs(winner.GetElapseTimeUs());
+  rpc_.RawMutableResponse()->CopyFrom(*winner.RawResponse());
+  hedge_attempt_ = true;
+
+  SendStoreRpcCallBack();
+}
+
+bool StoreRpcController::PickHedgeEndPoint(const EndPoint& exclude, EndPoint& end_point) {
+  auto meta_cache = stub_.GetMetaCache();
+  std::vector<EndPoint> candidates;
+  for (const auto& replica : region_->ReplicaEndPoint()) {
+    if (replica != exclude && meta_cache->IsEndPointHealthy(replica)) {
+      candidates.push_back(replica);
+    }
+  }
+
+  if (candidates.empty()) {
+    return false;
+  }
+
+  end_point = stub_.GetRpcClient()->GetEndPointStats().PickNearest(candidates);
+  return end_point.IsValid();
+}
+
+bool StoreRpcController::GetBackoffType(const Status& status, BackoffType& type) {
+  if (status.IsNotLeader() || status.IsNoLeader() || status.IsRaftNotConsistentRead() || status.IsRaftCommitLog()) {
+    type = kBackoffNotLeader;
+  } else if (status.IsRemoteError() || status.IsTxnMemLockConflict()) {
+    type = kBackoffRequestFull;
+  } else if (status.IsNetworkError()) {
+    type = kBackoffNetwork;
+  } else {
+    return false;
+  }
+
+  return true;
 }
 
-void StoreRpcController::MaybeDelay() {
-  if (NeedDelay(status_)) {
-    auto delay_ms = FLAGS_store_rpc_retry_delay_ms;
-    SleepUs(delay_ms * 1000);
+int64_t StoreRpcController::NextBackoffDelayMs() {
+  BackoffType type;
+  if (!GetBackoffType(status_, type)) {
+    return 0;
   }
+
+  int attempt = backoff_attempts_[type]++;
+  return FullJitterBackoffMs(BackoffBaseMs(type), FLAGS_store_rpc_retry_delay_ms, attempt);
 }
 
 void StoreRpcController::SendStoreRpcCallBack() {
   Status status = rpc_.GetStatus();
+  attempt_span_.SetEndPoint(rpc_.GetEndPoint());
+  attempt_span_.End(status);
+  ReleaseConcurrencyLimit(*stub_.GetRpcClient(), limit_end_point_, rpc_);
+  if (!hedge_attempt_) {
+    RecordRpcDone(*stub_.GetRpcClient(), rpc_);
+  }
   if (!status.ok()) {
     region_->MarkFollower(rpc_.GetEndPoint());
+    // timeout may come from caller deadline, it says nothing about the store
+    if (rpc_.IsTransportFailure()) {
+      stub_.GetMetaCache()->RecordEndPointFailure(rpc_.GetEndPoint());
+    }
     DINGO_LOG(WARNING) << fmt::format("[sdk.rpc.{}] method:{} ,connect to store fail, region({}) status({}).",
                                       rpc_.LogId(), rpc_.Method(), region_->RegionId(), status.ToString());
     status_ = status;
@@ -122,8 +422,14 @@ void StoreRpcController::SendStoreRpcCallBack() {
     return;
   }
 
+  // replica read success means nothing about leader
   auto end_point = rpc_.GetEndPoint();
-  region_->MarkLeader(end_point);
+  stub_.GetMetaCache()->MarkEndPointHealthy(end_point);
+  // only a cached leader losing leadership says other regions may have moved too
+  bool was_cached_leader = !replica_read_ && region_->IsLeader(end_point);
+  if (!replica_read_) {
+    region_->MarkLeader(end_point);
+  }
 
   auto error = GetRpcResponseError(rpc_);
   if (error.errcode() == pb::error::Errno::OK) {
@@ -145,6 +451,10 @@ void StoreRpcController::SendStoreRpcCallBack() {
         status_ = Status::NoLeader(error.errcode(), error.errmsg());
       } else {
         region_->MarkLeader(endpoint);
+        // leadership usually moves in bulk, e.g. store restart, let sibling regions try the hint first
+        if (was_cached_leader) {
+          stub_.GetMetaCache()->PropagateLeaderHint(rpc_.GetEndPoint(), endpoint);
+        }
         msg += fmt::format(", leader({}).", endpoint.ToString());
         status_ = Status::NotLeader(error.errcode(), error.errmsg());
       }
@@ -199,7 +509,7 @@ void StoreRpcController::SendStoreRpcCallBack() {
 }
 
 void StoreRpcController::RetrySendRpcOrFireCallback() {
-  if (rpc_.Method() == "StoreService.TxnPrewriteRpc") {
+  if (std::string_view(rpc_.Method()) == "StoreService.TxnPrewriteRpc") {
     DINGO_LOG(DEBUG) << fmt::format("[sdk.rpc.{}]method:{} , store rpc done, region({}) status({}).", rpc_.LogId(),
                                     rpc_.Method(), region_->RegionId(), status_.ToString());
     // prewrite task execute retry
@@ -210,7 +520,27 @@ void StoreRpcController::RetrySendRpcOrFireCallback() {
   if (!status_.IsOK() && (IsUniversalNeedRetryError(status_) || IsTxnNeedRetryError(status_))) {
     if (rpc_retry_times_ < FLAGS_store_rpc_max_retry) {
       rpc_retry_times_++;
-      DoAsyncCall();
+      stub_.GetRpcClient()->GetRpcMetrics().OnRetry(status_);
+      int64_t delay_ms = NextBackoffDelayMs();
+      if (DeadlineRemainingMs(call_ctx_.deadline_ms) <= delay_ms) {
+        // no budget left for another attempt after backoff, fail now instead of sleeping to the deadline
+        status_ = Status::TimedOut(
+            fmt::format("deadline exceeded, retry({}) last status({})", rpc_retry_times_, status_.ToString()));
+        FireCallback();
+        return;
+      }
+
+      if (delay_ms > 0) {
+        // never sleep in rpc callback, it would park the rpc worker for the whole delay
+        stub_.GetActuator()->Schedule(
+            [this, backoff_span = Span::Start("backoff", call_ctx_)]() mutable {
+              backoff_span.End(Status::OK());
+              DoAsyncCall();
+            },
+            delay_ms);
+      } else {
+        DoAsyncCall();
+      }
       return;
 
     } else {
@@ -228,20 +558,54 @@ void StoreRpcController::FireCallback() {
                                       status_.ToString());
   }
 
+  span_.End(status_);
+
   if (call_back_) {
     StatusCallback cb;
     call_back_.swap(cb);
+    // caller may send next rpc in callback, e.g. scan, keep it under the same deadline and trace
+    CallContextGuard guard(call_ctx_);
     cb(status_);
   }
 }
 
 bool StoreRpcController::PickNextLeader(EndPoint& leader) {
+  auto meta_cache = stub_.GetMetaCache();
+  size_t replica_num = region_->ReplicaEndPoint().size();
+
+  // skip unhealthy replica when leader is unknown, use it anyway if all replicas are unhealthy
   EndPoint tmp_leader;
-  region_->GetLeader(tmp_leader);
+  for (size_t i = 0; i <= replica_num; ++i) {
+    region_->GetLeader(tmp_leader);
+    if (meta_cache->IsEndPointHealthy(tmp_leader)) {
+      break;
+    }
+  }
+
   leader = tmp_leader;
   return true;
 }
 
+// not leader error means replica can't serve read, go back to leader
+bool StoreRpcController::NeedPickReadReplica() {
+  return read_only_ && !status_.IsNotLeader() && !status_.IsNoLeader() && GetReadPolicy() != kReadLeader;
+}
+
+bool StoreRpcController::PickReadReplica(EndPoint& end_point) {
+  auto end_points = region_->ReplicaEndPoint();
+  if (end_points.empty()) {
+    return false;
+  }
+
+  if (GetReadPolicy() == kReadAnyReplica) {
+    end_point = end_points[RandHelper::RandUInt64() % end_points.size()];
+  } else {
+    end_point = stub_.GetRpcClient()->GetEndPointStats().PickNearest(end_points);
+  }
+
+  return end_point.IsValid();
+}
+
 void StoreRpcController::ResetRegion(RegionPtr region) {
   if (region_) {
     if (!(EpochCompare(region_->GetEpoch(), region->GetEpoch()) > 0)) {
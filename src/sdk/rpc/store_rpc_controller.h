@@ -15,16 +15,22 @@
 #ifndef DINGODB_SDK_STORE_RPC_CONTROLLER_H_
 #define DINGODB_SDK_STORE_RPC_CONTROLLER_H_
 
+#include <memory>
+
 #include "dingosdk/status.h"
 #include "proto/error.pb.h"
 #include "sdk/client_stub.h"
+#include "sdk/common/backoff.h"
+#include "sdk/common/call_context.h"
+#include "sdk/common/tracer.h"
 #include "sdk/utils/callback.h"
 #include "sdk/utils/net_util.h"
 
 namespace dingodb {
 namespace sdk {
 
-// TODO: support backoff strategy
+struct HedgeContext;
+
 class StoreRpcController {
  public:
   explicit StoreRpcController(const ClientStub& stub, Rpc& rpc);
@@ -40,6 +46,10 @@ class StoreRpcController {
 
   void ResetRegion(RegionPtr region);
 
+  // read only rpc may be sent to follower according to FLAGS_store_read_policy,
+  // fallback to leader when replica reply not leader
+  void SetReadOnly(bool read_only) { read_only_ = read_only; }
+
   static bool IsUniversalNeedRetryError(const Status& status) {
     return status.IsNetworkError() || status.IsRemoteError() || status.IsNotLeader() || status.IsNoLeader() ||
            status.IsRaftNotConsistentRead() || status.IsRaftCommitLog();
@@ -47,11 +57,6 @@ class StoreRpcController {
 
   static bool IsTxnNeedRetryError(const Status& status) { return status.IsTxnMemLockConflict(); }
 
-  static bool NeedDelay(const Status& status) {
-    return status.IsRemoteError() || status.IsNoLeader() || status.IsTxnMemLockConflict() || status.IsNetworkError() ||
-           status.IsNotLeader();
-  }
-
  private:
   void DoAsyncCall();
 
@@ -59,13 +64,25 @@ class StoreRpcController {
   bool PreCheck();
   bool PrepareRpc();
   void SendStoreRpc();
+  void DoSendStoreRpc();
   void SendStoreRpcCallBack();
   void RetrySendRpcOrFireCallback();
   void FireCallback();
 
+  // hedged replica read, both rpc are clones of rpc_ so the slower one can finish after controller is done
+  bool NeedHedge();
+  void SendStoreRpcWithHedge();
+  bool PickHedgeEndPoint(const EndPoint& exclude, EndPoint& end_point);
+  void HedgeRpcDone(Rpc& winner);
+  static void SendHedgeRpc(const std::shared_ptr<HedgeContext>& ctx);
+  static void HedgeRpcCallback(const std::shared_ptr<HedgeContext>& ctx, Rpc* rpc);
+
   // backoff
-  void MaybeDelay();
+  int64_t NextBackoffDelayMs();
+  static bool GetBackoffType(const Status& status, BackoffType& type);
   bool PickNextLeader(EndPoint& leader);
+  bool PickReadReplica(EndPoint& end_point);
+  bool NeedPickReadReplica();
 
   RegionPtr ProcessStoreRegionInfo(const pb::error::StoreRegionInfo& store_region_info);
 
@@ -82,8 +99,21 @@ class StoreRpcController {
   Rpc& rpc_;
   RegionPtr region_;
   int rpc_retry_times_;
+  // retry attempts of each error class
+  int backoff_attempts_[kBackoffTypeCount]{};
   Status status_;
   StatusCallback call_back_;
+  bool read_only_{false};
+  // current rpc is sent by read policy, the endpoint may be not leader
+  bool replica_read_{false};
+  // result of current rpc is copied from a hedge clone, stats is already recorded
+  bool hedge_attempt_{false};
+  // endpoint which current rpc hold a concurrency limit slot of, invalid if not hold
+  EndPoint limit_end_point_;
+  // captured from caller when construct, span_ become parent of new spans once started
+  CallContext call_ctx_;
+  Span span_;
+  Span attempt_span_;
 };
 
 }  // namespace sdk
@@ -61,56 +61,49 @@ Status TxnImpl::Begin() {
   return status;
 }
 
-Status TxnImpl::Get(const std::string& key, std::string& value) {
-  if (key.empty()) {
-    return Status::InvalidArgument("param key is empty");
-  }
-
+bool TxnImpl::GetFromBuffer(const std::string& key, std::string& value, Status& status) {
   TxnMutation mutation;
   Status ret = buffer_->Get(key, mutation);
-  if (ret.ok()) {
-    switch (mutation.type) {
-      case kPut:
-        value = mutation.value;
-        return Status::OK();
-      case kDelete:
-        return Status::NotFound("");
-      case kPutIfAbsent:
-        // NOTE: directy return is ok?
-        value = mutation.value;
-        return Status::OK();
-      default:
-        CHECK(false) << "unknow mutation type, mutation: " << mutation.ToString();
-    }
+  if (!ret.ok()) {
+    return false;
   }
 
-  return DoTxnGet(key, value);
-}
-
-Status TxnImpl::BatchGet(const std::vector<std::string>& keys, std::vector<KVPair>& kvs) {
-  for (const auto& key : keys) {
-    if (key.empty()) {
-      return Status::InvalidArgument("param key is empty");
-    }
+  switch (mutation.type) {
+    case kPut:
+      value = mutation.value;
+      status = Status::OK();
+      break;
+    case kDelete:
+      status = Status::NotFound("");
+      break;
+    case kPutIfAbsent:
+      // NOTE: directy return is ok?
+      value = mutation.value;
+      status = Status::OK();
+      break;
+    default:
+      CHECK(false) << "unknow mutation type, mutation: " << mutation.ToString();
   }
 
-  std::vector<std::string> not_found_keys;
-  std::vector<KVPair> result_kvs;
-  result_kvs.reserve(keys.size());
-  Status status;
+  return true;
+}
+
+void TxnImpl::BatchGetFromBuffer(const std::vector<std::string>& keys, std::vector<KVPair>& kvs,
+                                 std::vector<std::string>& not_found_keys) {
+  kvs.reserve(keys.size());
   for (const auto& key : keys) {
     TxnMutation mutation;
-    status = buffer_->Get(key, mutation);
+    Status status = buffer_->Get(key, mutation);
     if (status.IsOK()) {
       switch (mutation.type) {
         case kPut:
-          result_kvs.push_back({key, mutation.value});
+          kvs.push_back({key, mutation.value});
           continue;
         case kDelete:
           continue;
         case kPutIfAbsent:
           // NOTE: use this value is ok?
-          result_kvs.push_back({key, mutation.value});
+          kvs.push_back({key, mutation.value});
           continue;
         default:
           CHECK(false) << "unknow mutation type, mutation:" << mutation.ToString();
@@ -120,7 +113,33 @@ Status TxnImpl::BatchGet(const std::vector<std::string>& keys, std::vector<KVPai
       not_found_keys.push_back(key);
     }
   }
+}
 
+Status TxnImpl::Get(const std::string& key, std::string& value) {
+  if (key.empty()) {
+    return Status::InvalidArgument("param key is empty");
+  }
+
+  Status status;
+  if (GetFromBuffer(key, value, status)) {
+    return status;
+  }
+
+  return DoTxnGet(key, value);
+}
+
+Status TxnImpl::BatchGet(const std::vector<std::string>& keys, std::vector<KVPair>& kvs) {
+  for (const auto& key : keys) {
+    if (key.empty()) {
+      return Status::InvalidArgument("param key is empty");
+    }
+  }
+
+  std::vector<std::string> not_found_keys;
+  std::vector<KVPair> result_kvs;
+  BatchGetFromBuffer(keys, result_kvs, not_found_keys);
+
+  Status status;
   if (!not_found_keys.empty()) {
     std::vector<KVPair> remote_kvs;
     status = DoTxnBatchGet(not_found_keys, remote_kvs);
@@ -216,6 +235,75 @@ Status TxnImpl::Scan(const std::string& start_key, const std::string& end_key, u
 
 Status TxnImpl::Rollback() { return DoRollback(); }
 
+// block on an async commit phase, the phase itself is a callback chain and holds no thread while rpcs are in flight
+template <class Fn>
+static Status WaitAsync(Fn&& fn) {
+  Status status;
+  Synchronizer sync;
+  fn(sync.AsStatusCallBack(status));
+  sync.Wait();
+  return status;
+}
+
+void TxnImpl::AsyncGet(std::string key, std::string& value, StatusCallback cb) {
+  if (key.empty()) {
+    cb(Status::InvalidArgument("param key is empty"));
+    return;
+  }
+
+  Status status;
+  if (GetFromBuffer(key, value, status)) {
+    cb(status);
+    return;
+  }
+
+  auto owned_key = std::make_shared<std::string>(std::move(key));
+  AsyncRunTask(new TxnGetTask(stub_, *owned_key, value, shared_from_this()), std::move(cb), owned_key);
+}
+
+void TxnImpl::AsyncBatchGet(std::vector<std::string> keys, std::vector<KVPair>& kvs, StatusCallback cb) {
+  for (const auto& key : keys) {
+    if (key.empty()) {
+      cb(Status::InvalidArgument("param key is empty"));
+      return;
+    }
+  }
+
+  struct BatchGetContext {
+    std::vector<KVPair> result_kvs;
+    std::vector<std::string> not_found_keys;
+    std::vector<KVPair> remote_kvs;
+  };
+  auto ctx = std::make_shared<BatchGetContext>();
+  BatchGetFromBuffer(keys, ctx->result_kvs, ctx->not_found_keys);
+
+  if (ctx->not_found_keys.empty()) {
+    kvs = std::move(ctx->result_kvs);
+    cb(Status::OK());
+    return;
+  }
+
+  auto* task = new TxnBatchGetTask(stub_, ctx->not_found_keys, ctx->remote_kvs, shared_from_this());
+  AsyncRunTask(task, [ctx, &kvs, cb = std::move(cb)](Status status) {
+    ctx->result_kvs.insert(ctx->result_kvs.end(), std::make_move_iterator(ctx->remote_kvs.begin()),
+                           std::make_move_iterator(ctx->remote_kvs.end()));
+    kvs = std::move(ctx->result_kvs);
+    cb(std::move(status));
+  });
+}
+
+void TxnImpl::AsyncPreWriteAndCommit(StatusCallback cb) {
+  AsyncDoPreCommit([shared_this = shared_from_this(), cb = std::move(cb)](Status status) {
+    if (!status.ok() || shared_this->is_one_pc_.load()) {
+      cb(status);
+      return;
+    }
+    shared_this->AsyncDoCommit(cb);
+  });
+}
+
+void TxnImpl::AsyncRollback(StatusCallback cb) { AsyncDoRollback(std::move(cb)); }
+
 bool TxnImpl::IsNeedRetry(int& times) {
   bool retry = times++ < FLAGS_txn_op_max_retry;
   if (retry) {
@@ -423,14 +511,7 @@ Status TxnImpl::DoScan(const std::string& start_key, const std::string& end_key,
 }
 
 Status TxnImpl::PreWriteAndCommit() {
-  Status s = DoPreCommit();
-  if (!s.ok()) {
-    return s;
-  } else if (s.ok() && is_one_pc_.load()) {
-    return Status::OK();
-  }
-  s = DoCommit();
-  return s;
+  return WaitAsync([this](StatusCallback cb) { AsyncPreWriteAndCommit(std::move(cb)); });
 }
 
 void TxnImpl::ScheduleHeartBeat() {
@@ -464,12 +545,18 @@ void TxnImpl::DoHeartBeat(int64_t start_ts, std::string primary_key) {
 }
 
 Status TxnImpl::DoPreCommit() {
+  return WaitAsync([this](StatusCallback cb) { AsyncDoPreCommit(std::move(cb)); });
+}
+
+void TxnImpl::AsyncDoPreCommit(StatusCallback cb) {
   State state = state_.load();
   if (state == kPreCommitted) {
     DINGO_LOG(INFO) << fmt::format("[sdk.txn.{}] already precommitted.", ID());
-    return Status::OK();
+    cb(Status::OK());
+    return;
   } else if (state != kActive) {
-    return Status::IllegalState("state is not active, state:" + std::string(StateName(state)));
+    cb(Status::IllegalState("state is not active, state:" + std::string(StateName(state))));
+    return;
   }
 
   if (buffer_->IsEmpty()) {
@@ -477,7 +564,8 @@ Status TxnImpl::DoPreCommit() {
     is_one_pc_ = true;
     Cleanup();
     DINGO_LOG(INFO) << fmt::format("[sdk.txn.{}] precommit success, no mutation.", ID());
-    return Status::OK();
+    cb(Status::OK());
+    return;
   }
 
   state_.store(kPreCommitting);
@@ -486,77 +574,97 @@ Status TxnImpl::DoPreCommit() {
       << "primary key must in mutations, primary key:" << buffer_->GetPrimaryKey();
 
   // check whether 1pc
-  std::set<int64_t> region_ids;
-  auto meta_cache = stub_.GetMetaCache();
+  std::vector<std::string_view> keys;
+  keys.reserve(buffer_->Mutations().size());
   for (const auto& [key, mutation] : buffer_->Mutations()) {
-    std::shared_ptr<Region> tmp;
-    Status s = meta_cache->LookupRegionByKey(mutation.key, tmp);
-    if (!s.ok()) {
-      DINGO_LOG(ERROR) << fmt::format("[sdk.txn.{}] precommit lookup region fail, key({}) status({}).", ID(),
-                                      StringToHex(mutation.key), s.ToString());
-      return s;
-    }
-    region_ids.insert(tmp->RegionId());
+    keys.emplace_back(mutation.key);
   }
 
-  is_one_pc_.store((region_ids.size() == 1) && (buffer_->Mutations().size() <= FLAGS_txn_max_batch_count));
+  std::vector<RegionKeyGroup> groups;
+  Status s = stub_.GetMetaCache()->LookupRegionsByKeys(keys, groups);
+  if (!s.ok()) {
+    DINGO_LOG(ERROR) << fmt::format("[sdk.txn.{}] precommit lookup region fail, key count({}) status({}).", ID(),
+                                    keys.size(), s.ToString());
+    cb(s);
+    return;
+  }
+
+  is_one_pc_.store((groups.size() == 1) && (buffer_->Mutations().size() <= FLAGS_txn_max_batch_count));
 
   use_async_commit_.store(buffer_->MutationsSize() < FLAGS_txn_max_async_commit_count && FLAGS_enable_txn_async_commit);
 
   use_concurrent_precommit_.store(FLAGS_enable_txn_concurrent_prewrite);
 
-  Status status = is_one_pc_.load() ? PreCommit1PC() : PreCommit2PC();
+  StatusCallback done = [shared_this = shared_from_this(), cb = std::move(cb)](Status status) {
+    if (!status.ok()) {
+      cb(status);
+      return;
+    }
 
-  if (!status.ok()) {
-    return status;
-  }
+    if (shared_this->is_one_pc_) {
+      shared_this->state_.store(kFinshed);
+      shared_this->Cleanup();
+    } else {
+      shared_this->state_.store(kPreCommitted);
+    }
 
-  if (is_one_pc_) {
-    state_.store(kFinshed);
-    Cleanup();
+    cb(Status::OK());
+  };
+
+  if (is_one_pc_.load()) {
+    AsyncPreCommit1PC(std::move(done));
   } else {
-    state_.store(kPreCommitted);
+    AsyncPreCommit2PC(std::move(done));
   }
+}
 
-  return Status::OK();
+void TxnImpl::AsyncPrewrite(std::shared_ptr<PrewriteContext> ctx, StatusCallback cb) {
+  auto* task = new TxnPrewriteTask(stub_, buffer_->GetPrimaryKey(), ctx->mutations, shared_from_this(),
+                                   ctx->ordinary_keys, ctx->is_one_pc, ctx->use_async_commit, ctx->min_commit_ts);
+  AsyncRunTask(task, std::move(cb), ctx);
 }
 
-Status TxnImpl::PreCommit1PC() {
+void TxnImpl::ApplyPrewriteResult(const PrewriteContext& ctx) {
+  if (!ctx.use_async_commit) {
+    use_async_commit_.store(false);
+  } else {
+    UpdateAsyncCommitTs(ctx.min_commit_ts);
+  }
+}
+
+void TxnImpl::AsyncPreCommit1PC(StatusCallback cb) {
   // 1pc
   DINGO_LOG(DEBUG) << fmt::format("[sdk.txn.{}] precommit use 1pc optimization.", ID());
-  std::map<std::string, const TxnMutation*> mutations_map;
-
+  auto ctx = std::make_shared<PrewriteContext>();
   for (const auto& [key, mutation] : buffer_->Mutations()) {
-    mutations_map.emplace(std::make_pair(key, &mutation));
+    ctx->mutations.emplace(std::make_pair(key, &mutation));
   }
 
-  bool is_one_pc = is_one_pc_.load();
-  CHECK(is_one_pc) << fmt::format("[sdk.txn.{}] precommit 1pc but is_one_pc is false.", ID());
+  ctx->is_one_pc = is_one_pc_.load();
+  CHECK(ctx->is_one_pc) << fmt::format("[sdk.txn.{}] precommit 1pc but is_one_pc is false.", ID());
   // prefer 1pc instead async commit
-  bool use_async_commit = false;
-  std::map<std::string, const TxnMutation*> placeholder_map;
-  uint64_t min_commit_ts = 0;
-  TxnPrewriteTask task(stub_, buffer_->GetPrimaryKey(), mutations_map, shared_from_this(), placeholder_map, is_one_pc,
-                       use_async_commit, min_commit_ts);
-
-  Status status = task.Run();
-
-  if (!is_one_pc && (status.ok() || status.IsInvalidArgument())) {
-    // downgrade to 2pc
-    DINGO_LOG(INFO) << fmt::format("[sdk.txn.{}] downgrade to 2pc precommit.", ID());
-    is_one_pc_.store(false);
-    use_async_commit_.store(false);
-    return PreCommit2PC();
-  }
+  ctx->use_async_commit = false;
+
+  AsyncPrewrite(ctx, [shared_this = shared_from_this(), ctx, cb = std::move(cb)](Status status) {
+    if (!ctx->is_one_pc && (status.ok() || status.IsInvalidArgument())) {
+      // downgrade to 2pc
+      DINGO_LOG(INFO) << fmt::format("[sdk.txn.{}] downgrade to 2pc precommit.", shared_this->ID());
+      shared_this->is_one_pc_.store(false);
+      shared_this->use_async_commit_.store(false);
+      shared_this->AsyncPreCommit2PC(cb);
+      return;
+    }
 
-  if (!status.ok()) {
-    DINGO_LOG(WARNING) << fmt::format("[sdk.txn.{}] 1pc precommit key fail, status({}).", ID(), status.ToString());
-  }
+    if (!status.ok()) {
+      DINGO_LOG(WARNING) << fmt::format("[sdk.txn.{}] 1pc precommit key fail, status({}).", shared_this->ID(),
+                                        status.ToString());
+    }
 
-  return status;
+    cb(status);
+  });
 }
 
-Status TxnImpl::PreCommit2PC() {
+void TxnImpl::AsyncPreCommit2PC(StatusCallback cb) {
   DINGO_LOG(DEBUG) << fmt::format("[sdk.txn.{}] precommit primary key, pk({}).", ID(),
                                   StringToHex(buffer_->GetPrimaryKey()));
 
@@ -565,107 +673,85 @@ Status TxnImpl::PreCommit2PC() {
 
   if (use_concurrent_precommit_.load()) {
     DINGO_LOG(DEBUG) << fmt::format("[sdk.txn.{}] precommit use concurrent prewrite.", ID());
-    return PreCommit2PCConcurrent();
+    AsyncPreCommit2PCConcurrent(std::move(cb));
   } else {
     DINGO_LOG(DEBUG) << fmt::format("[sdk.txn.{}] precommit use sequential prewrite.", ID());
-    return PreCommit2PCSequential();
+    AsyncPreCommit2PCSequential(std::move(cb));
   }
 }
 
-Status TxnImpl::PreCommit2PCSequential() {
+void TxnImpl::AsyncPreCommit2PCSequential(StatusCallback cb) {
+  auto primary = std::make_shared<PrewriteContext>();
   // primary key map
-  std::map<std::string, const TxnMutation*> mutations_map_primary_key;
-  mutations_map_primary_key.emplace(
+  primary->mutations.emplace(
       std::make_pair(buffer_->GetPrimaryKey(), &buffer_->Mutations().at(buffer_->GetPrimaryKey())));
   // ordinary keys map
-  std::map<std::string, const TxnMutation*> mutations_map_ordinary_keys;
   for (const auto& [key, mutation] : buffer_->Mutations()) {
     if (key == buffer_->GetPrimaryKey()) {
       continue;
     }
-    mutations_map_ordinary_keys.emplace(std::make_pair(key, &mutation));
+    primary->ordinary_keys.emplace(std::make_pair(key, &mutation));
   }
+  primary->is_one_pc = false;
+  primary->use_async_commit = use_async_commit_.load();
 
   // precommit primary key
   DINGO_LOG(DEBUG) << fmt::format("[sdk.txn.{}] precommit primary key.", ID());
-  bool is_one_pc = false;
-  bool use_async_commit = use_async_commit_.load();
-  uint64_t min_commit_ts = 0;
-  TxnPrewriteTask task_primary(stub_, buffer_->GetPrimaryKey(), mutations_map_primary_key, shared_from_this(),
-                               mutations_map_ordinary_keys, is_one_pc, use_async_commit, min_commit_ts);
-
-  Status status = task_primary.Run();
-
-  if (!status.ok()) {
-    DINGO_LOG(WARNING) << fmt::format("[sdk.txn.{}] 2pc precommit primary key fail, status({}).", ID(),
-                                      status.ToString());
-    return status;
-  }
-
-  if (!use_async_commit) {
-    use_async_commit_.store(false);
-  } else {
-    UpdateAsyncCommitTs(min_commit_ts);
-  }
-
-  // precommit ordinary keys
-  DINGO_LOG(DEBUG) << fmt::format("[sdk.txn.{}] precommit ordinary keys.", ID());
-  min_commit_ts = 0;
-  TxnPrewriteTask task_ordinary(stub_, buffer_->GetPrimaryKey(), mutations_map_ordinary_keys, shared_from_this(),
-                                mutations_map_ordinary_keys, is_one_pc, use_async_commit, min_commit_ts);
-  status = task_ordinary.Run();
-  if (!status.ok()) {
-    DINGO_LOG(WARNING) << fmt::format("[sdk.txn.{}] 2pc precommit ordinary keys fail, status({}).", ID(),
-                                      status.ToString());
-    return status;
-  }
-
-  if (!use_async_commit) {
-    use_async_commit_.store(false);
-  } else {
-    UpdateAsyncCommitTs(min_commit_ts);
-  }
+  AsyncPrewrite(primary, [shared_this = shared_from_this(), primary, cb = std::move(cb)](Status status) {
+    if (!status.ok()) {
+      DINGO_LOG(WARNING) << fmt::format("[sdk.txn.{}] 2pc precommit primary key fail, status({}).", shared_this->ID(),
+                                        status.ToString());
+      cb(status);
+      return;
+    }
+    shared_this->ApplyPrewriteResult(*primary);
+
+    // precommit ordinary keys
+    DINGO_LOG(DEBUG) << fmt::format("[sdk.txn.{}] precommit ordinary keys.", shared_this->ID());
+    auto ordinary = std::make_shared<PrewriteContext>();
+    ordinary->mutations = primary->ordinary_keys;
+    ordinary->ordinary_keys = primary->ordinary_keys;
+    ordinary->is_one_pc = false;
+    ordinary->use_async_commit = primary->use_async_commit;
+
+    shared_this->AsyncPrewrite(ordinary, [shared_this, ordinary, cb](Status status) {
+      if (!status.ok()) {
+        DINGO_LOG(WARNING) << fmt::format("[sdk.txn.{}] 2pc precommit ordinary keys fail, status({}).",
+                                          shared_this->ID(), status.ToString());
+        cb(status);
+        return;
+      }
 
-  return Status::OK();
+      shared_this->ApplyPrewriteResult(*ordinary);
+      cb(Status::OK());
+    });
+  });
 }
 
-Status TxnImpl::PreCommit2PCConcurrent() {
-  // all keys map
-  std::map<std::string, const TxnMutation*> mutations_map_all_keys;
-  // ordinary keys map for async commit
-  std::map<std::string, const TxnMutation*> mutations_map_ordinary_keys;
-  bool use_async_commit = use_async_commit_.load();
+void TxnImpl::AsyncPreCommit2PCConcurrent(StatusCallback cb) {
+  auto ctx = std::make_shared<PrewriteContext>();
+  ctx->is_one_pc = false;
+  ctx->use_async_commit = use_async_commit_.load();
   for (const auto& [key, mutation] : buffer_->Mutations()) {
-    if (key == buffer_->GetPrimaryKey()) {
-      mutations_map_all_keys.emplace(std::make_pair(key, &mutation));
-      continue;
-    }
-    mutations_map_all_keys.emplace(std::make_pair(key, &mutation));
-    if (use_async_commit) {
+    // all keys map
+    ctx->mutations.emplace(std::make_pair(key, &mutation));
+    if (key != buffer_->GetPrimaryKey() && ctx->use_async_commit) {
       // for async commit, need to save ordinary keys info
-      mutations_map_ordinary_keys.emplace(std::make_pair(key, &mutation));
+      ctx->ordinary_keys.emplace(std::make_pair(key, &mutation));
     }
   }
 
-  bool is_one_pc = false;
-  uint64_t min_commit_ts = 0;
-  TxnPrewriteTask task_primary(stub_, buffer_->GetPrimaryKey(), mutations_map_all_keys, shared_from_this(),
-                               mutations_map_ordinary_keys, is_one_pc, use_async_commit, min_commit_ts);
-
-  Status status = task_primary.Run();
-  if (!status.ok()) {
-    DINGO_LOG(WARNING) << fmt::format("[sdk.txn.{}] 2pc concurrent precommit keys fail, status({}).", ID(),
-                                      status.ToString());
-    return status;
-  }
-
-  if (!use_async_commit) {
-    use_async_commit_.store(false);
-  } else {
-    UpdateAsyncCommitTs(min_commit_ts);
-  }
+  AsyncPrewrite(ctx, [shared_this = shared_from_this(), ctx, cb = std::move(cb)](Status status) {
+    if (!status.ok()) {
+      DINGO_LOG(WARNING) << fmt::format("[sdk.txn.{}] 2pc concurrent precommit keys fail, status({}).",
+                                        shared_this->ID(), status.ToString());
+      cb(status);
+      return;
+    }
 
-  return Status::OK();
+    shared_this->ApplyPrewriteResult(*ctx);
+    cb(Status::OK());
+  });
 }
 
 void TxnImpl::UpdateAsyncCommitTs(uint64_t min_commit_ts) {
@@ -674,27 +760,29 @@ void TxnImpl::UpdateAsyncCommitTs(uint64_t min_commit_ts) {
   commit_ts_.store(min_commit_ts);
 }
 
-Status TxnImpl::CommitPrimaryKey() {
+void TxnImpl::AsyncCommitPrimaryKey(int64_t retry_count, StatusCallback cb) {
   std::vector<std::string> keys = {buffer_->GetPrimaryKey()};
-  Status status;
-  int64_t retry_count = 0;
-  do {
-    TxnCommitTask task(stub_, keys, shared_from_this(), true);
-    status = task.Run();
+  auto* task = new TxnCommitTask(stub_, keys, shared_from_this(), true);
+  AsyncRunTask(task, [shared_this = shared_from_this(), retry_count, cb = std::move(cb)](Status status) {
     if (status.IsTxnCommitTsExpired()) {
       int64_t commit_ts;
-      Status s = stub_.GetTsoProvider()->GenTs(2, commit_ts);
+      Status s = shared_this->stub_.GetTsoProvider()->GenTs(2, commit_ts);
       if (!s.ok()) {
-        DINGO_LOG(ERROR) << fmt::format("[sdk.txn.{}] commit primary key regen ts fail, status({}).", ID(),
-                                        s.ToString());
-        return s;
+        DINGO_LOG(ERROR) << fmt::format("[sdk.txn.{}] commit primary key regen ts fail, status({}).",
+                                        shared_this->ID(), s.ToString());
+        cb(s);
+        return;
+      }
+      shared_this->commit_ts_.store(commit_ts);
+
+      if (retry_count + 1 < FLAGS_txn_op_max_retry) {
+        shared_this->AsyncCommitPrimaryKey(retry_count + 1, cb);
+        return;
       }
-      commit_ts_.store(commit_ts);
     }
-    retry_count++;
-  } while (status.IsTxnCommitTsExpired() && retry_count < FLAGS_txn_op_max_retry);
 
-  return status;
+    cb(status);
+  });
 }
 
 Status TxnImpl::CommitOrdinaryKey() {
@@ -738,14 +826,20 @@ void TxnImpl::DoCommitKeys(std::vector<std::string> keys) {
 }
 
 Status TxnImpl::DoCommit() {
+  return WaitAsync([this](StatusCallback cb) { AsyncDoCommit(std::move(cb)); });
+}
+
+void TxnImpl::AsyncDoCommit(StatusCallback cb) {
   State state = state_.load();
   if (state == kCommitted || state == kFinshed) {
     DINGO_LOG(INFO) << fmt::format("[sdk.txn.{}] already committed.", ID());
     state_.store(kFinshed);
-    return Status::OK();
+    cb(Status::OK());
+    return;
   } else if (state != kPreCommitted) {
-    return Status::IllegalState(
-        fmt::format("forbid commit, state {}, expect {}", StateName(state), StateName(kPreCommitted)));
+    cb(Status::IllegalState(
+        fmt::format("forbid commit, state {}, expect {}", StateName(state), StateName(kPreCommitted))));
+    return;
   }
 
   CHECK(!buffer_->IsEmpty()) << fmt::format("[sdk.txn.{}] buffer is empty.", ID());
@@ -759,7 +853,11 @@ Status TxnImpl::DoCommit() {
 
   if (commit_ts == 0) {
     // only init once, if commit_ts_ not set, get a new one
-    DINGO_RETURN_NOT_OK(stub_.GetTsoProvider()->GenTs(2, commit_ts));
+    Status s = stub_.GetTsoProvider()->GenTs(2, commit_ts);
+    if (!s.ok()) {
+      cb(s);
+      return;
+    }
     commit_ts_.store(commit_ts);
   }
 
@@ -774,40 +872,33 @@ Status TxnImpl::DoCommit() {
     if (!status.ok()) {
       DINGO_LOG(WARNING) << fmt::format("[sdk.txn.{}] async commit keys fail, status({}).", ID(), status.ToString());
     }
+    cb(Status::OK());
+    return;
+  }
 
-  } else {
-    DINGO_LOG(DEBUG) << fmt::format("[sdk.txn.{}] commit use normal commit, commit_ts({}).", ID(), commit_ts);
-    // commit primary key
-    Status status = CommitPrimaryKey();
+  DINGO_LOG(DEBUG) << fmt::format("[sdk.txn.{}] commit use normal commit, commit_ts({}).", ID(), commit_ts);
+  // commit primary key
+  AsyncCommitPrimaryKey(0, [shared_this = shared_from_this(), cb = std::move(cb)](Status status) {
     if (!status.ok()) {
-      DINGO_LOG(WARNING) << fmt::format("[sdk.txn.{}] commit primary key fail, status({}).", ID(), status.ToString());
+      DINGO_LOG(WARNING) << fmt::format("[sdk.txn.{}] commit primary key fail, status({}).", shared_this->ID(),
+                                        status.ToString());
       // commit primary key fail, maybe network error, so state is uncertain, set to precommitted
-      state_.store(kPreCommitted);
-      return status;
+      shared_this->state_.store(kPreCommitted);
+      cb(status);
+      return;
     }
 
-    state_.store(kCommitted);
+    shared_this->state_.store(kCommitted);
 
     // commit ordinary keys
-    status = CommitOrdinaryKey();
+    status = shared_this->CommitOrdinaryKey();
     if (!status.IsOK()) {
-      DINGO_LOG(WARNING) << fmt::format("[sdk.txn.{}] commit ordinary keys fail, status({}).", ID(), status.ToString());
+      DINGO_LOG(WARNING) << fmt::format("[sdk.txn.{}] commit ordinary keys fail, status({}).", shared_this->ID(),
+                                        status.ToString());
     }
-  }
-
-  return Status::OK();
-}
 
-Status TxnImpl::RollbackPrimaryKey() {
-  std::vector<std::string> keys;
-  std::string pk = buffer_->GetPrimaryKey();
-  keys.push_back(pk);
-  TxnBatchRollbackTask task(stub_, std::move(keys), shared_from_this());
-  Status status = task.Run();
-  if (!status.ok()) {
-    DINGO_LOG(WARNING) << fmt::format("[sdk.txn.{}] 1pc rollback key fail, status({}).", ID(), status.ToString());
-  }
-  return status;
+    cb(Status::OK());
+  });
 }
 
 Status TxnImpl::RollbackOrdinaryKey() {
@@ -844,12 +935,17 @@ void TxnImpl::DoRollbackOrdinaryKey(std::vector<std::string> keys) {
 }
 
 Status TxnImpl::DoRollback() {
+  return WaitAsync([this](StatusCallback cb) { AsyncDoRollback(std::move(cb)); });
+}
+
+void TxnImpl::AsyncDoRollback(StatusCallback cb) {
   // TODO: client txn status maybe inconsistence with server
   // so we should check txn status first and then take action
   // TODO: maybe support rollback when txn is active
   State state = state_.load();
   if (state != kPreCommitting && state != kPreCommitted) {
-    return Status::IllegalState(fmt::format("forbid rollback, state {}", StateName(state)));
+    cb(Status::IllegalState(fmt::format("forbid rollback, state {}", StateName(state))));
+    return;
   }
 
   if (is_one_pc_) {
@@ -857,29 +953,36 @@ Status TxnImpl::DoRollback() {
     DINGO_LOG(INFO) << fmt::format("[sdk.txn.{}] 1pc txn, no need rollback.", ID());
     state_.store(kFinshed);
     Cleanup();
-    return Status::OK();
+    cb(Status::OK());
+    return;
   }
 
   state_.store(kRollbacking);
 
   // rollback primary key
-  auto status = RollbackPrimaryKey();
-
-  if (!status.IsOK()) {
-    state_.store(kRollbackfailed);
-    Cleanup();
-    return status;
-  }
+  std::vector<std::string> keys = {buffer_->GetPrimaryKey()};
+  auto* task = new TxnBatchRollbackTask(stub_, std::move(keys), shared_from_this());
+  AsyncRunTask(task, [shared_this = shared_from_this(), cb = std::move(cb)](Status status) {
+    if (!status.IsOK()) {
+      DINGO_LOG(WARNING) << fmt::format("[sdk.txn.{}] 1pc rollback key fail, status({}).", shared_this->ID(),
+                                        status.ToString());
+      shared_this->state_.store(kRollbackfailed);
+      shared_this->Cleanup();
+      cb(status);
+      return;
+    }
 
-  state_.store(kRollbacked);
+    shared_this->state_.store(kRollbacked);
 
-  // rollback ordinary keys
-  status = RollbackOrdinaryKey();
-  if (!status.IsOK()) {
-    DINGO_LOG(WARNING) << fmt::format("[sdk.txn.{}] rollback ordinary keys fail, status({}).", ID(), status.ToString());
-  }
+    // rollback ordinary keys
+    status = shared_this->RollbackOrdinaryKey();
+    if (!status.IsOK()) {
+      DINGO_LOG(WARNING) << fmt::format("[sdk.txn.{}] rollback ordinary keys fail, status({}).", shared_this->ID(),
+                                        status.ToString());
+    }
 
-  return Status::OK();
+    cb(Status::OK());
+  });
 }
 
 void TxnImpl::CheckStateActive() const {
@@ -17,6 +17,7 @@
 
 #include <atomic>
 #include <cstdint>
+#include <map>
 #include <memory>
 #include <string>
 #include <string_view>
@@ -125,6 +126,16 @@ class TxnImpl : public std::enable_shared_from_this<TxnImpl> {
 
   Status Rollback();
 
+  // async variants, output buffers must stay valid until cb
+  void AsyncGet(std::string key, std::string& value, StatusCallback cb);
+
+  void AsyncBatchGet(std::vector<std::string> keys, std::vector<KVPair>& kvs, StatusCallback cb);
+
+  // commit phases are chained on task callbacks, no thread is held while rpcs are in flight
+  void AsyncPreWriteAndCommit(StatusCallback cb);
+
+  void AsyncRollback(StatusCallback cb);
+
   void ScheduleHeartBeat();
 
   bool IsOnePc() const { return is_one_pc_.load(); }
@@ -194,6 +205,12 @@ class TxnImpl : public std::enable_shared_from_this<TxnImpl> {
   Status LookupRegion(const std::string_view& key, RegionPtr& region);
   Status LookupRegion(std::string_view start_key, std::string_view end_key, std::shared_ptr<Region>& region);
 
+  // return true and set status when key is in buffer
+  bool GetFromBuffer(const std::string& key, std::string& value, Status& status);
+  // keys not in buffer are put into not_found_keys
+  void BatchGetFromBuffer(const std::vector<std::string>& keys, std::vector<KVPair>& kvs,
+                          std::vector<std::string>& not_found_keys);
+
   // txn get
   Status DoTxnGet(const std::string& key, std::string& value);
 
@@ -204,27 +221,40 @@ class TxnImpl : public std::enable_shared_from_this<TxnImpl> {
   static Status ProcessScanState(ScanState& scan_state, uint64_t limit, std::vector<KVPair>& out_kvs);
   Status DoScan(const std::string& start_key, const std::string& end_key, uint64_t limit, std::vector<KVPair>& out_kvs);
 
-  // txn precommit
+  // input and output of one TxnPrewriteTask, live until the task is done
+  struct PrewriteContext {
+    std::map<std::string, const TxnMutation*> mutations;
+    std::map<std::string, const TxnMutation*> ordinary_keys;
+    bool is_one_pc{false};
+    bool use_async_commit{false};
+    uint64_t min_commit_ts{0};
+  };
+
+  // txn precommit, Do* block on the Async* version
   Status DoPreCommit();
-  Status PreCommit1PC();
-  Status PreCommit2PC();
-  Status PreCommit2PCConcurrent();
-  Status PreCommit2PCSequential();
+  void AsyncDoPreCommit(StatusCallback cb);
+  void AsyncPreCommit1PC(StatusCallback cb);
+  void AsyncPreCommit2PC(StatusCallback cb);
+  void AsyncPreCommit2PCConcurrent(StatusCallback cb);
+  void AsyncPreCommit2PCSequential(StatusCallback cb);
+  void AsyncPrewrite(std::shared_ptr<PrewriteContext> ctx, StatusCallback cb);
+  void ApplyPrewriteResult(const PrewriteContext& ctx);
 
   void UpdateAsyncCommitTs(uint64_t min_commit_ts);
 
   // txn commit
-  Status CommitPrimaryKey();
+  void AsyncCommitPrimaryKey(int64_t retry_count, StatusCallback cb);
   Status CommitOrdinaryKey();
   Status AsyncCommitKeys();
   void DoCommitKeys(std::vector<std::string> keys);
   Status DoCommit();
+  void AsyncDoCommit(StatusCallback cb);
 
   // txn rollback
-  Status RollbackPrimaryKey();
   Status RollbackOrdinaryKey();
   void DoRollbackOrdinaryKey(std::vector<std::string> keys);
   Status DoRollback();
+  void AsyncDoRollback(StatusCallback cb);
 
   void DoHeartBeat(int64_t start_ts, std::string primary_key);
 
@@ -40,7 +40,7 @@ TxnRegionScannerImpl::TxnRegionScannerImpl(const ClientStub& stub, RegionPtr reg
       end_key_(std::move(end_key)),
       opened_(false),
       has_more_(false),
-      batch_size_(FLAGS_scan_batch_size) {}
+      batch_sizer_(FLAGS_scan_batch_size) {}
 
 TxnRegionScannerImpl::~TxnRegionScannerImpl() { Close(); }
 
@@ -76,7 +76,7 @@ std::unique_ptr<TxnScanRpc> TxnRegionScannerImpl::GenTxnScanRpc(uint64_t resolve
 
   auto* stream_meta = rpc->MutableRequest()->mutable_stream_meta();
   stream_meta->set_stream_id(stream_id_);
-  stream_meta->set_limit(batch_size_);
+  stream_meta->set_limit(batch_sizer_.BatchSize());
 
   return std::move(rpc);
 }
@@ -120,12 +120,16 @@ Status TxnRegionScannerImpl::NextBatch(std::vector<KVPair>& kvs) {
 
   const auto* response = rpc->Response();
 
+  int64_t bytes = 0;
   for (const auto& kv : response->kvs()) {
+    bytes += kv.key().size() + kv.value().size();
     DINGO_LOG(DEBUG) << fmt::format("[sdk.txn.{}] scan region({}) key({}) value({}).", txn_start_ts_,
                                     region->RegionId(), StringToHex(kv.key()), StringToHex(kv.value()));
     kvs.push_back({kv.key(), kv.value()});
   }
 
+  batch_sizer_.OnResponse(response->kvs_size(), bytes);
+
   has_more_ = response->stream_meta().has_more();
   stream_id_ = response->stream_meta().stream_id();
 
@@ -133,16 +137,7 @@ Status TxnRegionScannerImpl::NextBatch(std::vector<KVPair>& kvs) {
 }
 
 Status TxnRegionScannerImpl::SetBatchSize(int64_t size) {
-  uint64_t to_size = size;
-  if (size <= kMinScanBatchSize) {
-    to_size = kMinScanBatchSize;
-  }
-
-  if (size > kMaxScanBatchSize) {
-    to_size = kMaxScanBatchSize;
-  }
-
-  batch_size_ = to_size;
+  batch_sizer_.Fix(size);
   return Status::OK();
 }
 
@@ -23,6 +23,7 @@
 #include "dingosdk/status.h"
 #include "sdk/region_scanner.h"
 #include "sdk/rpc/store_rpc.h"
+#include "sdk/utils/scan_batch_sizer.h"
 
 namespace dingodb {
 namespace sdk {
@@ -57,7 +58,7 @@ class TxnRegionScannerImpl : public RegionScanner {
 
   Status SetBatchSize(int64_t size) override;
 
-  int64_t GetBatchSize() const override { return batch_size_; }
+  int64_t GetBatchSize() const override { return batch_sizer_.BatchSize(); }
 
   bool TEST_IsOpen() {  // NOLINT
     return opened_;
@@ -72,7 +73,7 @@ class TxnRegionScannerImpl : public RegionScanner {
   int64_t txn_start_ts_;
   std::string start_key_;
   std::string end_key_;
-  int64_t batch_size_;
+  ScanBatchSizer batch_sizer_;
   bool opened_;
   bool has_more_;
   std::string stream_id_;
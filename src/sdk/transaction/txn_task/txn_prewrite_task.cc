@@ -17,11 +17,13 @@
 #include <fmt/format.h>
 #include <glog/logging.h>
 
+#include <algorithm>
 #include <cstdint>
 
 #include "common/logging.h"
 #include "dingosdk/status.h"
 #include "sdk/common/common.h"
+#include "sdk/common/deadline.h"
 #include "sdk/common/helper.h"
 #include "sdk/common/param_config.h"
 #include "sdk/region.h"
@@ -69,29 +71,36 @@ void TxnPrewriteTask::DoAsync() {
   std::unordered_map<int64_t, std::shared_ptr<Region>> region_id_to_region;
   std::unordered_map<int64_t, std::vector<const TxnMutation*>> region_id_to_mutations;
 
-  auto meta_cache = stub.GetMetaCache();
-  for (const auto& [_, mutation] : next_batch) {
-    std::shared_ptr<Region> tmp;
-    Status s = meta_cache->LookupRegionByKey(mutation->key, tmp);
-    if (!s.ok()) {
-      DoAsyncDone(s);
-      return;
-    }
-    auto iter = region_id_to_region.find(tmp->RegionId());
-    if (iter == region_id_to_region.end()) {
-      region_id_to_region.emplace(std::make_pair(tmp->RegionId(), tmp));
-    }
+  std::vector<std::string_view> keys;
+  std::vector<const TxnMutation*> mutations;
+  keys.reserve(next_batch.size());
+  mutations.reserve(next_batch.size());
+  for (const auto& [key, mutation] : next_batch) {
+    keys.emplace_back(key);
+    mutations.push_back(mutation);
+  }
 
-    if (region_id_to_mutations.find(tmp->RegionId()) == region_id_to_mutations.end()) {
-      region_id_to_mutations[tmp->RegionId()] = {mutation};
-    } else {
-      if (primary_key_ != mutation->key) {
-        region_id_to_mutations[tmp->RegionId()].push_back(mutation);
+  std::vector<RegionKeyGroup> groups;
+  Status s = stub.GetMetaCache()->LookupRegionsByKeys(keys, groups);
+  if (!s.ok()) {
+    DoAsyncDone(s);
+    return;
+  }
+
+  for (const auto& group : groups) {
+    auto region_id = group.region->RegionId();
+    region_id_to_region.emplace(std::make_pair(region_id, group.region));
+
+    auto& region_mutations = region_id_to_mutations[region_id];
+    for (auto index : group.key_indexes) {
+      const auto* mutation = mutations[index];
+      if (region_mutations.empty() || primary_key_ != mutation->key) {
+        region_mutations.push_back(mutation);
       } else {
         // If primary key is in the mutations, we need to put it at the front of the mutations list
-        const auto* front = region_id_to_mutations[tmp->RegionId()].front();
-        region_id_to_mutations[tmp->RegionId()][0] = mutation;
-        region_id_to_mutations[tmp->RegionId()].push_back(front);
+        const auto* front = region_mutations.front();
+        region_mutations[0] = mutation;
+        region_mutations.push_back(front);
       }
     }
   }
@@ -309,7 +318,13 @@ void TxnPrewriteTask::TxnPrewriteRpcCallback(const Status& status, TxnPrewriteRp
 }
 
 void TxnPrewriteTask::BackoffAndRetry() {
-  stub.GetTxnActuator()->Schedule([this] { DoAsync(); }, FLAGS_txn_prewrite_delay_ms);
+  stub.GetTxnActuator()->Schedule(
+      [this, backoff_span = Span::Start("backoff", call_ctx_)]() mutable {
+        backoff_span.End(Status::OK());
+        CallContextGuard ctx_guard(call_ctx_);
+        DoAsync();
+      },
+      std::min(FLAGS_txn_prewrite_delay_ms, DeadlineRemainingMs(call_ctx_.deadline_ms)));
 }
 
 bool TxnPrewriteTask::IsRetryError() {
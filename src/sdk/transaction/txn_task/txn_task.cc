@@ -14,9 +14,12 @@
 
 #include "sdk/transaction/txn_task/txn_task.h"
 
+#include <algorithm>
+
 #include "dingosdk/status.h"
 #include "proto/error.pb.h"
 #include "sdk/common/common.h"
+#include "sdk/common/deadline.h"
 #include "sdk/common/param_config.h"
 #include "sdk/utils/async_util.h"
 
@@ -36,6 +39,12 @@ void TxnTask::AsyncRun(StatusCallback cb) {
     WriteLockGuard guard(rw_lock_);
     call_back_.swap(cb);
   }
+  if (NeedTrace(call_ctx_)) {
+    span_ = Span::Start(Name(), call_ctx_);
+    call_ctx_ = span_.ChildContext(call_ctx_);
+  }
+
+  CallContextGuard ctx_guard(call_ctx_);
   Status status = Init();
   if (status.ok()) {
     DoAsync();
@@ -59,6 +68,12 @@ void TxnTask::DoAsyncDone(const Status& status) {
 }
 
 void TxnTask::FailOrRetry() {
+  if (IsDeadlineExpired(call_ctx_.deadline_ms)) {
+    status_ = Status::TimedOut(fmt::format("Fail task:{} deadline exceeded, last err:{}", Name(), status_.ToString()));
+    FireCallback();
+    return;
+  }
+
   if (NeedRetry()) {
     BackoffAndRetry();
   } else {
@@ -84,6 +99,12 @@ bool TxnTask::NeedRetry() {
 }
 
 void TxnTask::DoAsyncRetry() {
+  if (IsDeadlineExpired(call_ctx_.deadline_ms)) {
+    status_ = Status::TimedOut(fmt::format("Fail task:{} deadline exceeded, last op : txn resolve lock", Name()));
+    FireCallback();
+    return;
+  }
+
   retry_count_++;
   if (retry_count_ < FLAGS_txn_op_max_retry) {
     BackoffAndRetry();
@@ -95,7 +116,13 @@ void TxnTask::DoAsyncRetry() {
 }
 
 void TxnTask::BackoffAndRetry() {
-  stub.GetTxnActuator()->Schedule([this] { DoAsync(); }, FLAGS_txn_op_delay_ms);
+  stub.GetTxnActuator()->Schedule(
+      [this, backoff_span = Span::Start("backoff", call_ctx_)]() mutable {
+        backoff_span.End(Status::OK());
+        CallContextGuard ctx_guard(call_ctx_);
+        DoAsync();
+      },
+      std::min(FLAGS_txn_op_delay_ms, DeadlineRemainingMs(call_ctx_.deadline_ms)));
 }
 
 void TxnTask::FireCallback() {
@@ -111,6 +138,8 @@ void TxnTask::FireCallback() {
     call_back_.swap(cb);
   }
 
+  span_.End(status_);
+  CallContextGuard ctx_guard(call_ctx_);
   cb(status_);
 }
 
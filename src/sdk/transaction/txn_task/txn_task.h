@@ -17,6 +17,8 @@
 
 #include "dingosdk/status.h"
 #include "sdk/client_stub.h"
+#include "sdk/common/call_context.h"
+#include "sdk/common/tracer.h"
 #include "sdk/utils/callback.h"
 #include "sdk/utils/rw_lock.h"
 
@@ -25,7 +27,7 @@ namespace sdk {
 
 class TxnTask {
  public:
-  TxnTask(const ClientStub& stub) : stub(stub) {}
+  TxnTask(const ClientStub& stub) : stub(stub), call_ctx_(CurrentCallContext()) {}
   virtual ~TxnTask() = default;
 
   Status Run();
@@ -50,6 +52,10 @@ class TxnTask {
   virtual bool IsRetryError();
   virtual bool NeedRetry();
 
+  // captured from caller when construct, span_ become parent of new spans once started
+  CallContext call_ctx_;
+  Span span_;
+
  private:
   void FailOrRetry();
   void FireCallback();
@@ -0,0 +1,114 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_AUTO_BATCHER_H_
+#define DINGODB_SDK_AUTO_BATCHER_H_
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "sdk/utils/mutex_lock.h"
+
+namespace dingodb {
+namespace sdk {
+
+// Groups concurrent requests into batches.
+// The first submitter of a batch becomes the leader, it waits at most window_us for other submitters (or until the
+// batch is full), then runs batch_func on the whole batch in its own thread and wakes up the others.
+// Items are owned by the submitters, they are valid until Submit return.
+template <typename Item>
+class AutoBatcher {
+ public:
+  using BatchFunc = std::function<void(std::vector<Item*>& items)>;
+
+  AutoBatcher(int64_t window_us, int64_t max_batch_size, BatchFunc batch_func)
+      : window_us_(window_us), max_batch_size_(max_batch_size), batch_func_(std::move(batch_func)) {}
+
+  ~AutoBatcher() = default;
+
+  AutoBatcher(const AutoBatcher&) = delete;
+  AutoBatcher& operator=(const AutoBatcher&) = delete;
+
+  // block until the batch which contains item is executed
+  void Submit(Item* item) {
+    std::shared_ptr<Batch> batch;
+    {
+      LockGuard guard(&mutex_);
+      bool leader = false;
+      if (open_batch_ == nullptr) {
+        open_batch_ = std::make_shared<Batch>(&mutex_);
+        leader = true;
+      }
+
+      batch = open_batch_;
+      batch->items.push_back(item);
+      if (static_cast<int64_t>(batch->items.size()) >= max_batch_size_) {
+        // batch is full, no one can join it any more
+        open_batch_.reset();
+        batch->cond.NotifyAll();
+      }
+
+      if (!leader) {
+        while (!batch->done) {
+          batch->cond.Wait();
+        }
+        return;
+      }
+
+      auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(window_us_);
+      while (open_batch_ == batch) {
+        auto now = std::chrono::steady_clock::now();
+        if (now >= deadline) {
+          break;
+        }
+        batch->cond.WaitFor(std::chrono::duration_cast<std::chrono::microseconds>(deadline - now).count());
+      }
+
+      if (open_batch_ == batch) {
+        open_batch_.reset();
+      }
+    }
+
+    batch_func_(batch->items);
+
+    LockGuard guard(&mutex_);
+    batch->done = true;
+    batch->cond.NotifyAll();
+  }
+
+ private:
+  struct Batch {
+    explicit Batch(Mutex* mutex) : cond(mutex) {}
+
+    std::vector<Item*> items;
+    bool done{false};
+    CondVar cond;
+  };
+
+  const int64_t window_us_;
+  const int64_t max_batch_size_;
+  const BatchFunc batch_func_;
+
+  Mutex mutex_;
+  std::shared_ptr<Batch> open_batch_;
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_AUTO_BATCHER_H_
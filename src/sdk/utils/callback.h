@@ -16,6 +16,8 @@
 #define DINGODB_SDK_CALL_BACK_H_
 
 #include <functional>
+#include <memory>
+#include <utility>
 
 #include "dingosdk/status.h"
 
@@ -24,7 +26,17 @@ namespace sdk {
 
 using RpcCallback = std::function<void()>;
 
-using StatusCallback = std::function<void(Status)>;
+// StatusCallback is defined in dingosdk/status.h for async public api
+
+// Run a task created by new in background for async public api, the task is deleted before cb.
+// Inputs the task hold reference of are kept in owned and released after cb.
+template <class Task, class... Owned>
+void AsyncRunTask(Task* task, StatusCallback cb, std::shared_ptr<Owned>... owned) {
+  task->AsyncRun([task, cb = std::move(cb), owned...](Status status) {
+    delete task;
+    cb(std::move(status));
+  });
+}
 
 }  // namespace sdk
 }  // namespace dingodb
@@ -0,0 +1,131 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/utils/epoch_reclaimer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <utility>
+
+#include "glog/logging.h"
+
+namespace dingodb {
+namespace sdk {
+
+// one per live thread, records are never freed and reused after their thread exit
+struct alignas(64) EpochThreadRecord {
+  // epoch pinned by the owner thread, 0 means not in any guard
+  std::atomic<uint64_t> epoch{0};
+  std::atomic<bool> in_use{true};
+  // only accessed by the owner thread, nested guards pin once
+  uint32_t depth{0};
+  EpochThreadRecord* next{nullptr};
+};
+
+namespace {
+
+// start from 1, 0 is reserved for not pinned
+std::atomic<uint64_t> g_epoch{1};
+std::atomic<EpochThreadRecord*> g_records{nullptr};
+
+EpochThreadRecord* AcquireRecord() {
+  for (auto* record = g_records.load(std::memory_order_acquire); record != nullptr; record = record->next) {
+    bool expected = false;
+    if (!record->in_use.load(std::memory_order_relaxed) &&
+        record->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+      return record;
+    }
+  }
+
+  auto* record = new EpochThreadRecord();
+  EpochThreadRecord* head = g_records.load(std::memory_order_relaxed);
+  do {
+    record->next = head;
+  } while (!g_records.compare_exchange_weak(head, record, std::memory_order_release, std::memory_order_relaxed));
+  return record;
+}
+
+struct LocalRecordHolder {
+  LocalRecordHolder() : record(AcquireRecord()) {}
+
+  ~LocalRecordHolder() {
+    CHECK_EQ(record->depth, 0) << "thread exit inside epoch guard";
+    record->in_use.store(false, std::memory_order_release);
+  }
+
+  EpochThreadRecord* record;
+};
+
+EpochThreadRecord* LocalRecord() {
+  static thread_local LocalRecordHolder holder;
+  return holder.record;
+}
+
+uint64_t MinPinnedEpoch() {
+  uint64_t min_epoch = std::numeric_limits<uint64_t>::max();
+  for (auto* record = g_records.load(std::memory_order_acquire); record != nullptr; record = record->next) {
+    uint64_t epoch = record->epoch.load(std::memory_order_seq_cst);
+    if (epoch != 0) {
+      min_epoch = std::min(min_epoch, epoch);
+    }
+  }
+  return min_epoch;
+}
+
+}  // namespace
+
+EpochReclaimer::Guard::Guard() : record_(LocalRecord()) {
+  if (record_->depth++ == 0) {
+    // seq_cst pairs with the writer: either writer see this pin, or this reader see the new pointer
+    record_->epoch.store(g_epoch.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+  }
+}
+
+EpochReclaimer::Guard::~Guard() {
+  if (--record_->depth == 0) {
+    record_->epoch.store(0, std::memory_order_release);
+  }
+}
+
+EpochReclaimer::~EpochReclaimer() {
+  for (auto& retired : retired_) {
+    retired.deleter();
+  }
+}
+
+void EpochReclaimer::RetireImpl(std::function<void()> deleter) {
+  // reader pinned an epoch >= this one load pointer after the swap, so never see the retired object
+  uint64_t epoch = g_epoch.fetch_add(1, std::memory_order_seq_cst) + 1;
+  retired_.push_back({epoch, std::move(deleter)});
+  Reclaim();
+}
+
+void EpochReclaimer::Reclaim() {
+  if (retired_.empty()) {
+    return;
+  }
+
+  uint64_t min_epoch = MinPinnedEpoch();
+  auto iter = std::stable_partition(retired_.begin(), retired_.end(),
+                                    [min_epoch](const Retired& retired) { return retired.epoch > min_epoch; });
+  for (auto it = iter; it != retired_.end(); ++it) {
+    it->deleter();
+  }
+  retired_.erase(iter, retired_.end());
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,80 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_EPOCH_RECLAIMER_H_
+#define DINGODB_SDK_EPOCH_RECLAIMER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace dingodb {
+namespace sdk {
+
+struct EpochThreadRecord;
+
+// Epoch based reclamation for objects published through a raw atomic pointer.
+// Reader pins the global epoch in a slot owned by its thread, so the read path takes no lock and writes no shared
+// cache line. Writer swaps the pointer, retires the old object and deletes it once no reader pinned before the swap.
+// NOTE: never block inside a Guard, bthread may be migrated to another pthread and leave the slot pinned.
+class EpochReclaimer {
+ public:
+  // nested guards in one thread are allowed
+  class Guard {
+   public:
+    Guard();
+    ~Guard();
+
+    Guard(const Guard&) = delete;
+    const Guard& operator=(const Guard&) = delete;
+
+   private:
+    EpochThreadRecord* record_;
+  };
+
+  EpochReclaimer() = default;
+
+  // no reader may still hold object retired by this reclaimer
+  ~EpochReclaimer();
+
+  EpochReclaimer(const EpochReclaimer&) = delete;
+  const EpochReclaimer& operator=(const EpochReclaimer&) = delete;
+
+  // ptr is already unreachable for new readers, calls must be serialized by caller
+  template <typename T>
+  void Retire(const T* ptr) {
+    RetireImpl([ptr]() { delete ptr; });
+  }
+
+  // delete retired objects no reader can see any more, calls must be serialized by caller
+  void Reclaim();
+
+  size_t RetiredCount() const { return retired_.size(); }
+
+ private:
+  struct Retired {
+    uint64_t epoch;
+    std::function<void()> deleter;
+  };
+
+  void RetireImpl(std::function<void()> deleter);
+
+  std::vector<Retired> retired_;
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_EPOCH_RECLAIMER_H_
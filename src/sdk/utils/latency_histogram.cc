@@ -0,0 +1,95 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/utils/latency_histogram.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace dingodb {
+namespace sdk {
+
+int LatencyHistogram::BucketIndex(int64_t value) {
+  value = std::clamp(value, int64_t(0), (int64_t(1) << (kMaxValueBits + 1)) - 1);
+  if (value < kSubBuckets) {
+    return static_cast<int>(value);
+  }
+
+  int msb = 63 - __builtin_clzll(static_cast<uint64_t>(value));
+  int shift = msb - kSubBucketBits;
+  int sub = static_cast<int>((value >> shift) & (kSubBuckets - 1));
+  return (shift + 1) * kSubBuckets + sub;
+}
+
+int64_t LatencyHistogram::BucketUpperBound(int index) {
+  int group = index / kSubBuckets;
+  int64_t sub = index % kSubBuckets;
+  if (group == 0) {
+    return sub;
+  }
+
+  return ((kSubBuckets + sub + 1) << (group - 1)) - 1;
+}
+
+void LatencyHistogram::Record(int64_t value_us) {
+  value_us = std::max(value_us, int64_t(0));
+  buckets_[BucketIndex(value_us)].fetch_add(1, std::memory_order_relaxed);
+  count_.fetch_add(1, std::memory_order_relaxed);
+  sum_.fetch_add(value_us, std::memory_order_relaxed);
+
+  int64_t old_max = max_.load(std::memory_order_relaxed);
+  while (value_us > old_max && !max_.compare_exchange_weak(old_max, value_us, std::memory_order_relaxed)) {
+  }
+}
+
+LatencyMetrics LatencyHistogram::Snapshot() const {
+  std::array<int64_t, kBucketCount> buckets;
+  int64_t count = 0;
+  for (int i = 0; i < kBucketCount; ++i) {
+    buckets[i] = buckets_[i].load(std::memory_order_relaxed);
+    count += buckets[i];
+  }
+
+  LatencyMetrics metrics;
+  if (count == 0) {
+    return metrics;
+  }
+
+  metrics.count = count;
+  metrics.avg_us = sum_.load(std::memory_order_relaxed) / count;
+  metrics.max_us = max_.load(std::memory_order_relaxed);
+  metrics.p50_us = Percentile(buckets, count, 0.5);
+  metrics.p90_us = Percentile(buckets, count, 0.9);
+  metrics.p99_us = Percentile(buckets, count, 0.99);
+  metrics.p999_us = Percentile(buckets, count, 0.999);
+  return metrics;
+}
+
+int64_t LatencyHistogram::Percentile(const std::array<int64_t, kBucketCount>& buckets, int64_t count,
+                                     double percent) const {
+  int64_t rank = std::max(static_cast<int64_t>(std::ceil(percent * count)), int64_t(1));
+  int64_t seen = 0;
+  for (int i = 0; i < kBucketCount; ++i) {
+    seen += buckets[i];
+    if (seen >= rank) {
+      // upper bound of the bucket may exceed the real max
+      return std::min(BucketUpperBound(i), max_.load(std::memory_order_relaxed));
+    }
+  }
+
+  return max_.load(std::memory_order_relaxed);
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,66 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_LATENCY_HISTOGRAM_H_
+#define DINGODB_SDK_LATENCY_HISTOGRAM_H_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+#include "dingosdk/metric.h"
+
+namespace dingodb {
+namespace sdk {
+
+// Lock-free log-linear histogram like HdrHistogram.
+// Values in [2^k, 2^(k+1)) are split into kSubBuckets linear buckets, so percentiles have relative error below
+// 1/kSubBuckets, values below kSubBuckets are exact. Record is a few relaxed atomic adds.
+class LatencyHistogram {
+ public:
+  LatencyHistogram() = default;
+  ~LatencyHistogram() = default;
+
+  LatencyHistogram(const LatencyHistogram&) = delete;
+  const LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+  void Record(int64_t value_us);
+
+  // NOTE: not atomic with concurrent Record, counts may be off by the records in flight
+  LatencyMetrics Snapshot() const;
+
+  static int BucketIndex(int64_t value);
+
+  // max value falling in the bucket
+  static int64_t BucketUpperBound(int index);
+
+  static constexpr int kSubBucketBits = 3;
+  static constexpr int kSubBuckets = 1 << kSubBucketBits;
+  // values over 2^kMaxValueBits us(about 12 days) fall in the last bucket
+  static constexpr int kMaxValueBits = 40;
+  static constexpr int kBucketCount = (kMaxValueBits - kSubBucketBits + 2) * kSubBuckets;
+
+ private:
+  int64_t Percentile(const std::array<int64_t, kBucketCount>& buckets, int64_t count, double percent) const;
+
+  std::array<std::atomic<int64_t>, kBucketCount> buckets_{};
+  std::atomic<int64_t> count_{0};
+  std::atomic<int64_t> sum_{0};
+  std::atomic<int64_t> max_{0};
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_LATENCY_HISTOGRAM_H_
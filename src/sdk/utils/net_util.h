@@ -15,7 +15,9 @@
 #ifndef DINGODB_SDK_UTILS_NET_UTIL_H
 #define DINGODB_SDK_UTILS_NET_UTIL_H
 
+#include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <string>
 
 namespace dingodb {
@@ -28,7 +30,7 @@ class EndPoint {
 
   EndPoint(const std::string& host, uint16_t port) : host_(host), port_(port) {}
 
-  std::string Host() const { return host_; }
+  const std::string& Host() const { return host_; }
   void SetHost(const std::string& host) { host_ = host; }
 
   uint16_t Port() const { return port_; }
@@ -66,6 +68,16 @@ class EndPoint {
   uint16_t port_;
 };
 
+inline size_t EndPointHash(const EndPoint& end_point) {
+  size_t hash = std::hash<std::string>()(end_point.Host());
+  return hash * 31 + end_point.Port();
+}
+
+// shard of tables keyed by endpoint, endpoints of one host spread over shards by port
+inline size_t EndPointShardIndex(const EndPoint& end_point, size_t shard_num) {
+  return EndPointHash(end_point) % shard_num;
+}
+
 }  // namespace sdk
 }  // namespace dingodb
 
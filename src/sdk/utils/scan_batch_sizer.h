@@ -0,0 +1,65 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_SCAN_BATCH_SIZER_H_
+#define DINGODB_SDK_SCAN_BATCH_SIZER_H_
+
+#include <algorithm>
+#include <cstdint>
+
+#include "sdk/common/param_config.h"
+
+namespace dingodb {
+namespace sdk {
+
+// Pick fetch count of next scan batch so one response carry about FLAGS_scan_batch_bytes.
+// Average kv size is learned from responses, the count shrink at once when kvs get larger and at most double per
+// batch when they get smaller, so one outlier batch does not blow up the next response.
+// A size set by Fix is used as is, same as before byte budget was added.
+// NOTE: not thread safe, a region scanner has at most one batch in flight.
+class ScanBatchSizer {
+ public:
+  explicit ScanBatchSizer(int64_t init_size)
+      : batch_size_(std::clamp(init_size, kMinScanBatchSize, kMaxAdaptiveScanBatchSize)) {}
+
+  int64_t BatchSize() const { return batch_size_; }
+
+  void Fix(int64_t size) {
+    batch_size_ = std::clamp(size, kMinScanBatchSize, kMaxScanBatchSize);
+    fixed_ = true;
+  }
+
+  void OnResponse(int64_t kv_count, int64_t bytes) {
+    if (fixed_ || FLAGS_scan_batch_bytes <= 0 || kv_count <= 0) {
+      return;
+    }
+
+    double sample = std::max(1.0, static_cast<double>(bytes) / kv_count);
+    avg_kv_bytes_ = avg_kv_bytes_ == 0 ? sample : (avg_kv_bytes_ * 3 + sample) / 4;
+
+    auto target = static_cast<int64_t>(FLAGS_scan_batch_bytes / avg_kv_bytes_);
+    batch_size_ = std::clamp(target, kMinScanBatchSize, std::min(batch_size_ * 2, kMaxAdaptiveScanBatchSize));
+  }
+
+ private:
+  int64_t batch_size_;
+  bool fixed_{false};
+  // ewma of key + value bytes
+  double avg_kv_bytes_{0};
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_SCAN_BATCH_SIZER_H_
@@ -85,45 +85,36 @@ void VectorAddTask::DoAsync() {
     return;
   }
 
-  std::unordered_map<int64_t, std::shared_ptr<Region>> region_id_to_region;
-  std::unordered_map<int64_t, std::vector<int64_t>> region_vectors_to_ids;
-
-  auto meta_cache = stub.GetMetaCache();
-
+  std::vector<std::string> range_keys;
+  std::vector<int64_t> idxs;
+  range_keys.reserve(next_batch.size());
+  idxs.reserve(next_batch.size());
   for (const auto& [id, idx] : next_batch) {
-    std::shared_ptr<Region> tmp;
-    Status s = meta_cache->LookupRegionByKey(vector_helper::VectorIdToRangeKey(*vector_index_, id), tmp);
-    if (!s.ok()) {
-      // TODO: continue
-      DoAsyncDone(s);
-      return;
-    };
-
-    auto iter = region_id_to_region.find(tmp->RegionId());
-    if (iter == region_id_to_region.end()) {
-      region_id_to_region.emplace(std::make_pair(tmp->RegionId(), tmp));
-    }
+    range_keys.push_back(vector_helper::VectorIdToRangeKey(*vector_index_, id));
+    idxs.push_back(idx);
+  }
 
-    region_vectors_to_ids[tmp->RegionId()].push_back(id);
+  std::vector<std::string_view> keys(range_keys.begin(), range_keys.end());
+  std::vector<RegionKeyGroup> groups;
+  Status s = stub.GetMetaCache()->LookupRegionsByKeys(keys, groups);
+  if (!s.ok()) {
+    // TODO: continue
+    DoAsyncDone(s);
+    return;
   }
 
   controllers_.clear();
   rpcs_.clear();
 
-  for (const auto& entry : region_vectors_to_ids) {
-    auto region_id = entry.first;
-
-    auto iter = region_id_to_region.find(region_id);
-    CHECK(iter != region_id_to_region.end());
-    auto region = iter->second;
+  for (const auto& group : groups) {
+    const auto& region = group.region;
 
     auto rpc = std::make_unique<VectorAddRpc>();
-    FillRpcContext(*rpc->MutableRequest()->mutable_context(), region_id, region->GetEpoch());
+    FillRpcContext(*rpc->MutableRequest()->mutable_context(), region->RegionId(), region->GetEpoch());
     rpc->MutableRequest()->set_is_update(false);
 
-    for (const auto& id : entry.second) {
-      int64_t idx = vector_id_to_idx_[id];
-      FillVectorWithIdPB(rpc->MutableRequest()->add_vectors(), vectors_[idx]);
+    for (auto index : group.key_indexes) {
+      FillVectorWithIdPB(rpc->MutableRequest()->add_vectors(), vectors_[idxs[index]]);
     }
 
     StoreRpcController controller(stub, *rpc, region);
@@ -132,12 +123,12 @@ void VectorAddTask::DoAsync() {
     rpcs_.push_back(std::move(rpc));
   }
 
-  DCHECK_EQ(rpcs_.size(), region_vectors_to_ids.size());
+  DCHECK_EQ(rpcs_.size(), groups.size());
   DCHECK_EQ(rpcs_.size(), controllers_.size());
 
-  sub_tasks_count_.store(region_vectors_to_ids.size());
+  sub_tasks_count_.store(groups.size());
 
-  for (auto i = 0; i < region_vectors_to_ids.size(); i++) {
+  for (auto i = 0; i < groups.size(); i++) {
     auto& controller = controllers_[i];
 
     controller.AsyncCall(
@@ -101,6 +101,7 @@ void VectorBatchQueryTask::DoAsync() {
     }
 
     StoreRpcController controller(stub, *rpc, region);
+    controller.SetReadOnly(true);
     controllers_.push_back(controller);
 
     rpcs_.push_back(std::move(rpc));
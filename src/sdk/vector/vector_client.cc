@@ -13,12 +13,17 @@
 // limitations under the License.
 
 #include <cstdint>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "dingosdk/status.h"
 #include "dingosdk/vector.h"
 #include "sdk/client_stub.h"
+#include "sdk/common/deadline.h"
+#include "sdk/common/param_config.h"
+#include "sdk/utils/callback.h"
 #include "sdk/vector/diskann/vector_diskann_build_by_index_task.h"
 #include "sdk/vector/diskann/vector_diskann_build_by_region_task.h"
 #include "sdk/vector/diskann/vector_diskann_count_memory_task.h"
@@ -39,6 +44,7 @@
 #include "sdk/vector/vector_get_index_metrics_task.h"
 #include "sdk/vector/vector_index_cache.h"
 #include "sdk/vector/vector_scan_query_task.h"
+#include "sdk/vector/vector_search_auto_batcher.h"
 #include "sdk/vector/vector_search_task.h"
 #include "sdk/vector/vector_update_auto_increment_task.h"
 #include "sdk/vector/vector_upsert_task.h"
@@ -81,6 +87,11 @@ Status VectorClient::UpsertByIndexName(int64_t schema_id, const std::string& ind
 Status VectorClient::SearchByIndexId(int64_t index_id, const SearchParam& search_param,
                                      const std::vector<VectorWithId>& target_vectors,
                                      std::vector<SearchResult>& out_result) {
+  // batch run under deadline of the leader caller, so call with its own deadline bypass it
+  if (FLAGS_enable_auto_batch && GetCurrentDeadlineMs() == kNoDeadline) {
+    return stub_.GetVectorSearchAutoBatcher()->Search(index_id, search_param, target_vectors, out_result);
+  }
+
   VectorSearchTask task(stub_, index_id, search_param, target_vectors, out_result);
   return task.Run();
 }
@@ -127,6 +138,35 @@ Status VectorClient::BatchQueryByIndexName(int64_t schema_id, const std::string&
   return task.Run();
 }
 
+void VectorClient::AsyncAddByIndexId(int64_t index_id, std::vector<VectorWithId>& vectors, StatusCallback cb) {
+  AsyncRunTask(new VectorAddTask(stub_, index_id, vectors), std::move(cb));
+}
+
+void VectorClient::AsyncUpsertByIndexId(int64_t index_id, std::vector<VectorWithId>& vectors, StatusCallback cb) {
+  AsyncRunTask(new VectorUpsertTask(stub_, index_id, vectors), std::move(cb));
+}
+
+void VectorClient::AsyncSearchByIndexId(int64_t index_id, SearchParam search_param,
+                                        std::vector<VectorWithId> target_vectors, std::vector<SearchResult>& out_result,
+                                        StatusCallback cb) {
+  auto owned_param = std::make_shared<SearchParam>(std::move(search_param));
+  auto owned_vectors = std::make_shared<std::vector<VectorWithId>>(std::move(target_vectors));
+  AsyncRunTask(new VectorSearchTask(stub_, index_id, *owned_param, *owned_vectors, out_result), std::move(cb),
+               owned_param, owned_vectors);
+}
+
+void VectorClient::AsyncDeleteByIndexId(int64_t index_id, std::vector<int64_t> vector_ids,
+                                        std::vector<DeleteResult>& out_result, StatusCallback cb) {
+  auto owned_ids = std::make_shared<std::vector<int64_t>>(std::move(vector_ids));
+  AsyncRunTask(new VectorDeleteTask(stub_, index_id, *owned_ids, out_result), std::move(cb), owned_ids);
+}
+
+void VectorClient::AsyncBatchQueryByIndexId(int64_t index_id, QueryParam query_param, QueryResult& out_result,
+                                            StatusCallback cb) {
+  auto owned_param = std::make_shared<QueryParam>(std::move(query_param));
+  AsyncRunTask(new VectorBatchQueryTask(stub_, index_id, *owned_param, out_result), std::move(cb), owned_param);
+}
+
 Status VectorClient::GetBorderByIndexId(int64_t index_id, bool is_max, int64_t& out_vector_id) {
   VectorGetBorderTask task(stub_, index_id, is_max, out_vector_id);
   return task.Run();
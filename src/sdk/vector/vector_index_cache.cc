@@ -21,6 +21,7 @@
 #include "glog/logging.h"
 #include "proto/meta.pb.h"
 #include "sdk/client_stub.h"
+#include "sdk/common/tracer.h"
 #include "sdk/rpc/coordinator_rpc.h"
 
 namespace dingodb {
@@ -71,6 +72,7 @@ Status VectorIndexCache::GetVectorIndexById(int64_t index_id, std::shared_ptr<Ve
     }
   }
 
+  ScopedSpan span("vector_index_cache.load");
   return SlowGetVectorIndexById(index_id, out_vector_index);
 }
 
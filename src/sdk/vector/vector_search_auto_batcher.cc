@@ -0,0 +1,134 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/vector/vector_search_auto_batcher.h"
+
+#include <cstddef>
+#include <utility>
+
+#include "fmt/core.h"
+#include "glog/logging.h"
+#include "sdk/client_stub.h"
+#include "sdk/vector/vector_search_task.h"
+
+namespace dingodb {
+namespace sdk {
+
+VectorSearchAutoBatcher::VectorSearchAutoBatcher(const ClientStub& stub, int64_t window_us, int64_t max_batch_size)
+    : VectorSearchAutoBatcher(
+          [&stub](int64_t index_id, const SearchParam& search_param, const std::vector<VectorWithId>& target_vectors,
+                  std::vector<SearchResult>& out_result) {
+            VectorSearchTask task(stub, index_id, search_param, target_vectors, out_result);
+            return task.Run();
+          },
+          window_us, max_batch_size) {}
+
+VectorSearchAutoBatcher::VectorSearchAutoBatcher(SearchFunc search_func, int64_t window_us, int64_t max_batch_size)
+    : search_func_(std::move(search_func)),
+      batcher_(window_us, max_batch_size, [this](std::vector<SearchItem*>& items) { BatchSearch(items); }) {}
+
+Status VectorSearchAutoBatcher::Search(int64_t index_id, const SearchParam& search_param,
+                                       const std::vector<VectorWithId>& target_vectors,
+                                       std::vector<SearchResult>& out_result) {
+  if (target_vectors.empty()) {
+    return Status::InvalidArgument("target_vectors is empty");
+  }
+
+  SearchItem item{index_id, &search_param, &target_vectors, &out_result, Status::OK()};
+  batcher_.Submit(&item);
+  return item.status;
+}
+
+bool VectorSearchAutoBatcher::IsSameSearchParam(const SearchParam& lhs, const SearchParam& rhs) {
+  return lhs.topk == rhs.topk && lhs.with_vector_data == rhs.with_vector_data &&
+         lhs.with_scalar_data == rhs.with_scalar_data && lhs.selected_keys == rhs.selected_keys &&
+         lhs.with_table_data == rhs.with_table_data && lhs.enable_range_search == rhs.enable_range_search &&
+         lhs.radius == rhs.radius && lhs.filter_source == rhs.filter_source && lhs.filter_type == rhs.filter_type &&
+         lhs.is_negation == rhs.is_negation && lhs.is_sorted == rhs.is_sorted && lhs.vector_ids == rhs.vector_ids &&
+         lhs.use_brute_force == rhs.use_brute_force && lhs.extra_params == rhs.extra_params &&
+         lhs.langchain_expr_json == rhs.langchain_expr_json && lhs.beamwidth == rhs.beamwidth &&
+         lhs.is_scalar_speed_up_with_document == rhs.is_scalar_speed_up_with_document &&
+         lhs.query_string == rhs.query_string;
+}
+
+void VectorSearchAutoBatcher::BatchSearch(std::vector<SearchItem*>& items) {
+  // usually all items in one batch are compatible, so the quadratic grouping is cheap
+  std::vector<std::vector<SearchItem*>> groups;
+  for (auto* item : items) {
+    bool found = false;
+    for (auto& group : groups) {
+      const auto* first = group.front();
+      if (first->index_id == item->index_id && IsSameSearchParam(*first->search_param, *item->search_param)) {
+        group.push_back(item);
+        found = true;
+        break;
+      }
+    }
+
+    if (!found) {
+      groups.push_back({item});
+    }
+  }
+
+  for (const auto& group : groups) {
+    SearchGroup(group);
+  }
+}
+
+void VectorSearchAutoBatcher::SearchGroup(const std::vector<SearchItem*>& group) {
+  const auto* first = group.front();
+  if (group.size() == 1) {
+    group.front()->status =
+        search_func_(first->index_id, *first->search_param, *first->target_vectors, *first->out_result);
+    return;
+  }
+
+  size_t total = 0;
+  for (const auto* item : group) {
+    total += item->target_vectors->size();
+  }
+
+  std::vector<VectorWithId> target_vectors;
+  target_vectors.reserve(total);
+  for (const auto* item : group) {
+    target_vectors.insert(target_vectors.end(), item->target_vectors->begin(), item->target_vectors->end());
+  }
+
+  std::vector<SearchResult> out_result;
+  Status s = search_func_(first->index_id, *first->search_param, target_vectors, out_result);
+  if (s.ok() && out_result.size() != total) {
+    s = Status::Incomplete(fmt::format("search result size:{} not match target size:{}", out_result.size(), total));
+  }
+
+  if (!s.ok()) {
+    for (auto* item : group) {
+      item->status = s;
+    }
+    return;
+  }
+
+  // results are in the same order as target vectors
+  size_t offset = 0;
+  for (auto* item : group) {
+    size_t count = item->target_vectors->size();
+    for (size_t i = 0; i < count; i++) {
+      item->out_result->push_back(std::move(out_result[offset + i]));
+    }
+    offset += count;
+    item->status = Status::OK();
+  }
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,72 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_VECTOR_SEARCH_AUTO_BATCHER_H_
+#define DINGODB_SDK_VECTOR_SEARCH_AUTO_BATCHER_H_
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "dingosdk/status.h"
+#include "dingosdk/vector.h"
+#include "sdk/utils/auto_batcher.h"
+
+namespace dingodb {
+namespace sdk {
+
+class ClientStub;
+
+// Merge concurrent searches of the same index with the same SearchParam into one VectorSearchTask with multiple
+// target vectors, so each partition region get one VectorSearchRpc instead of one per caller.
+class VectorSearchAutoBatcher {
+ public:
+  // run one merged search, out_result must be in the same order as target_vectors
+  using SearchFunc = std::function<Status(int64_t index_id, const SearchParam& search_param,
+                                          const std::vector<VectorWithId>& target_vectors,
+                                          std::vector<SearchResult>& out_result)>;
+
+  VectorSearchAutoBatcher(const ClientStub& stub, int64_t window_us, int64_t max_batch_size);
+
+  // only for test, replace VectorSearchTask
+  VectorSearchAutoBatcher(SearchFunc search_func, int64_t window_us, int64_t max_batch_size);
+
+  ~VectorSearchAutoBatcher() = default;
+
+  Status Search(int64_t index_id, const SearchParam& search_param, const std::vector<VectorWithId>& target_vectors,
+                std::vector<SearchResult>& out_result);
+
+  static bool IsSameSearchParam(const SearchParam& lhs, const SearchParam& rhs);
+
+ private:
+  struct SearchItem {
+    int64_t index_id;
+    const SearchParam* search_param;
+    const std::vector<VectorWithId>* target_vectors;
+    std::vector<SearchResult>* out_result;
+    Status status;
+  };
+
+  void BatchSearch(std::vector<SearchItem*>& items);
+
+  void SearchGroup(const std::vector<SearchItem*>& group);
+
+  SearchFunc search_func_;
+  AutoBatcher<SearchItem> batcher_;
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_VECTOR_SEARCH_AUTO_BATCHER_H_
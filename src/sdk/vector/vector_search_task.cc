@@ -138,6 +138,7 @@ void VectorSearchTask::SubTaskCallback(Status status, VectorSearchPartTask* sub_
 }
 
 void VectorSearchTask::ConstructResultUnlocked() {
+  ScopedSpan span("merge_result", GetCallContext());
   for (const auto& vector_with_id : target_vectors_) {
     VectorWithId tmp;
     {
@@ -206,6 +207,7 @@ void VectorSearchPartTask::DoAsync() {
     FillVectorSearchRpcRequest(rpc->MutableRequest(), region);
     region_id_to_region_index_[region->RegionId()] = i;
     StoreRpcController controller(stub, *rpc, region);
+    controller.SetReadOnly(true);
     controllers_.push_back(controller);
 
     rpcs_.push_back(std::move(rpc));
@@ -306,6 +308,7 @@ void VectorSearchPartTask::SearchByBruteForce() {
       FillVectorWithIdPB(rpc->MutableRequest()->add_vector_with_ids(), vector_id, false);
     }
     StoreRpcController controller(stub, *rpc, region);
+    controller.SetReadOnly(true);
     nodata_controllers_.push_back(controller);
     nodata_rpcs_.push_back(std::move(rpc));
   }
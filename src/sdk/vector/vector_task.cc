@@ -14,10 +14,13 @@
 
 #include "sdk/vector/vector_task.h"
 
+#include <algorithm>
+
 #include "common/logging.h"
 #include "sdk/common/param_config.h"
 #include "sdk/utils/async_util.h"
 #include "sdk/common/common.h"
+#include "sdk/common/deadline.h"
 
 namespace dingodb {
 namespace sdk {
@@ -37,6 +40,12 @@ void VectorTask::AsyncRun(StatusCallback cb) {
     call_back_.swap(cb);
   }
 
+  if (NeedTrace(call_ctx_)) {
+    span_ = Span::Start(Name(), call_ctx_);
+    call_ctx_ = span_.ChildContext(call_ctx_);
+  }
+
+  CallContextGuard ctx_guard(call_ctx_);
   Status status = Init();
   if (status.ok()) {
     DoAsync();
@@ -60,6 +69,12 @@ void VectorTask::DoAsyncDone(const Status& status) {
 }
 
 void VectorTask::FailOrRetry() {
+  if (IsDeadlineExpired(call_ctx_.deadline_ms)) {
+    status_ = Status::TimedOut(fmt::format("Fail task:{} deadline exceeded, last err:{}", Name(), status_.ToString()));
+    FireCallback();
+    return;
+  }
+
   if (NeedRetry()) {
     BackoffAndRetry();
   } else {
@@ -90,9 +105,15 @@ bool VectorTask::NeedRetry() {
 }
 
 void VectorTask::BackoffAndRetry() {
-  auto delay = retry_count_ * FLAGS_vector_op_delay_ms;
+  int64_t delay = std::min(retry_count_ * FLAGS_vector_op_delay_ms, DeadlineRemainingMs(call_ctx_.deadline_ms));
   DINGO_LOG(INFO) << "Task:" << Name() << " will retry after " << delay << "ms";
-  stub.GetActuator()->Schedule([this] { DoAsync(); }, delay);
+  stub.GetActuator()->Schedule(
+      [this, backoff_span = Span::Start("backoff", call_ctx_)]() mutable {
+        backoff_span.End(Status::OK());
+        CallContextGuard ctx_guard(call_ctx_);
+        DoAsync();
+      },
+      delay);
 }
 
 void VectorTask::FireCallback() {
@@ -109,6 +130,8 @@ void VectorTask::FireCallback() {
     call_back_.swap(cb);
   }
 
+  span_.End(status_);
+  CallContextGuard ctx_guard(call_ctx_);
   cb(status_);
 }
 
@@ -18,6 +18,8 @@
 #include "dingosdk/status.h"
 #include "dingosdk/vector.h"
 #include "sdk/client_stub.h"
+#include "sdk/common/call_context.h"
+#include "sdk/common/tracer.h"
 #include "sdk/utils/callback.h"
 #include "sdk/utils/rw_lock.h"
 
@@ -26,7 +28,7 @@ namespace sdk {
 
 class VectorTask {
  public:
-  VectorTask(const ClientStub& stub) : stub(stub) {}
+  VectorTask(const ClientStub& stub) : stub(stub), call_ctx_(CurrentCallContext()) {}
   virtual ~VectorTask() = default;
 
   Status Run();
@@ -46,6 +48,8 @@ class VectorTask {
 
   virtual bool NeedRetry();
 
+  const CallContext& GetCallContext() const { return call_ctx_; }
+
  private:
   void FailOrRetry();
 
@@ -56,6 +60,9 @@ class VectorTask {
   RWLock rw_lock_;
   StatusCallback call_back_;
   int retry_count_{0};
+  // captured from caller when construct, span_ become parent of new spans once started
+  CallContext call_ctx_;
+  Span span_;
 };
 
 }  // namespace sdk
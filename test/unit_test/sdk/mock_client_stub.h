@@ -41,6 +41,8 @@ class MockClientStub final : public ClientStub {
   MOCK_METHOD(std::shared_ptr<AutoIncrementerManager>, GetAutoIncrementerManager, (), (const, override));
   MOCK_METHOD(std::shared_ptr<TsoProvider>, GetTsoProvider, (), (const, override));
   MOCK_METHOD(TxnManager*, GetTxnManager, (), (const, override));
+  MOCK_METHOD(std::shared_ptr<RawKvAutoBatcher>, GetRawKvAutoBatcher, (), (const, override));
+  MOCK_METHOD(std::shared_ptr<VectorSearchAutoBatcher>, GetVectorSearchAutoBatcher, (), (const, override));
 
   // std::shared_ptr<AutoIncrementerManager>  auto_increment_manager_;
 };
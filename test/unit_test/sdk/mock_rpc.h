@@ -42,7 +42,7 @@ class MockRpc final : public Rpc {
 
   MOCK_METHOD(std::string, ServiceFullName, (), (override));
 
-  MOCK_METHOD(std::string, Method, (), (const, override));
+  MOCK_METHOD(const char*, Method, (), (const, override));
 
   MOCK_METHOD(void, Call, (void* channel, RpcCallback cb), (override));
 
@@ -12,9 +12,18 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 #include <cstdint>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
 #include <cstdio>
+#include <deque>
+#include <functional>
+#include <future>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -27,9 +36,12 @@
 #include "mock_region_scanner.h"
 #include "proto/error.pb.h"
 #include "sdk/common/common.h"
+#include "sdk/common/param_config.h"
+#include "sdk/rawkv/raw_kv_auto_batcher.h"
 #include "sdk/rpc/coordinator_rpc.h"
 #include "sdk/rpc/store_rpc.h"
 #include "sdk/utils/callback.h"
+#include "sdk/utils/scoped_cleanup.h"
 #include "test_base.h"
 #include "test_common.h"
 
@@ -83,6 +95,144 @@ TEST_F(SDKRawKVTest, Get) {
   EXPECT_EQ(value, "pong");
 }
 
+TEST_F(SDKRawKVTest, AutoBatchGet) {
+  // large window, batch is sent when it is full
+  RawKvAutoBatcher batcher(*stub, 10 * 1000 * 1000, 3);
+
+  EXPECT_CALL(*rpc_client, SendRpc).WillOnce([&](Rpc& rpc, std::function<void()> cb) {
+    auto* batch_get_rpc = dynamic_cast<KvBatchGetRpc*>(&rpc);
+    CHECK_NOTNULL(batch_get_rpc);
+
+    // duplicate key is merged
+    EXPECT_EQ(2, batch_get_rpc->Request()->keys_size());
+    for (const auto& key : batch_get_rpc->Request()->keys()) {
+      auto* kv = batch_get_rpc->MutableResponse()->add_kvs();
+      kv->set_key(key);
+      kv->set_value(key + "_value");
+    }
+
+    cb();
+  });
+
+  std::vector<std::string> keys{"a", "b", "b"};
+  std::vector<std::string> values(keys.size());
+  std::vector<Status> status(keys.size());
+  std::vector<std::thread> threads;
+  threads.reserve(keys.size());
+  for (int i = 0; i < keys.size(); i++) {
+    threads.emplace_back([&, i]() { status[i] = batcher.Get(keys[i], values[i]); });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (int i = 0; i < keys.size(); i++) {
+    EXPECT_TRUE(status[i].IsOK());
+    EXPECT_EQ(values[i], keys[i] + "_value");
+  }
+}
+
+TEST_F(SDKRawKVTest, AutoBatchGetMissingKeySameAsGet) {
+  // unbatched get of a missing key leave out_value untouched
+  EXPECT_CALL(*rpc_client, SendRpc).WillOnce([&](Rpc& rpc, std::function<void()> cb) {
+    auto* kv_get_rpc = dynamic_cast<KvGetRpc*>(&rpc);
+    CHECK_NOTNULL(kv_get_rpc);
+    cb();
+  });
+
+  std::string unbatched_value = "stale";
+  Status got = raw_kv->Get("b", unbatched_value);
+  EXPECT_TRUE(got.IsOK());
+
+  RawKvAutoBatcher batcher(*stub, 10 * 1000 * 1000, 2);
+
+  EXPECT_CALL(*rpc_client, SendRpc).WillOnce([&](Rpc& rpc, std::function<void()> cb) {
+    auto* batch_get_rpc = dynamic_cast<KvBatchGetRpc*>(&rpc);
+    CHECK_NOTNULL(batch_get_rpc);
+
+    // only "a" exists
+    auto* kv = batch_get_rpc->MutableResponse()->add_kvs();
+    kv->set_key("a");
+    kv->set_value("a_value");
+
+    cb();
+  });
+
+  std::vector<std::string> keys{"a", "b"};
+  std::vector<std::string> values{"stale", "stale"};
+  std::vector<Status> status(keys.size());
+  std::vector<std::thread> threads;
+  threads.reserve(keys.size());
+  for (int i = 0; i < keys.size(); i++) {
+    threads.emplace_back([&, i]() { status[i] = batcher.Get(keys[i], values[i]); });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_TRUE(status[0].IsOK());
+  EXPECT_EQ(values[0], "a_value");
+  EXPECT_TRUE(status[1].IsOK());
+  EXPECT_EQ(values[1], unbatched_value);
+  EXPECT_EQ(values[1], "stale");
+}
+
+TEST_F(SDKRawKVTest, AutoBatchPut) {
+  RawKvAutoBatcher batcher(*stub, 10 * 1000 * 1000, 3);
+
+  EXPECT_CALL(*rpc_client, SendRpc).WillOnce([&](Rpc& rpc, std::function<void()> cb) {
+    auto* kv_batch_put_rpc = dynamic_cast<KvBatchPutRpc*>(&rpc);
+    CHECK_NOTNULL(kv_batch_put_rpc);
+
+    EXPECT_EQ(2, kv_batch_put_rpc->Request()->kvs_size());
+    auto* error = kv_batch_put_rpc->MutableResponse()->mutable_error();
+    error->set_errcode(pb::error::EINTERNAL);
+
+    cb();
+  });
+
+  std::vector<std::string> keys{"a", "b", "b"};
+  std::vector<Status> status(keys.size());
+  std::vector<std::thread> threads;
+  threads.reserve(keys.size());
+  for (int i = 0; i < keys.size(); i++) {
+    threads.emplace_back([&, i]() { status[i] = batcher.Put(keys[i], "pong"); });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // all callers in batch get the batch status
+  for (const auto& s : status) {
+    EXPECT_FALSE(s.IsOK());
+  }
+}
+
+TEST_F(SDKRawKVTest, AutoBatchGetEnabled) {
+  FLAGS_enable_auto_batch = true;
+  SCOPED_CLEANUP({ FLAGS_enable_auto_batch = false; });
+
+  EXPECT_CALL(*rpc_client, SendRpc).WillOnce([&](Rpc& rpc, std::function<void()> cb) {
+    auto* batch_get_rpc = dynamic_cast<KvBatchGetRpc*>(&rpc);
+    CHECK_NOTNULL(batch_get_rpc);
+
+    EXPECT_EQ(1, batch_get_rpc->Request()->keys_size());
+    auto* kv = batch_get_rpc->MutableResponse()->add_kvs();
+    kv->set_key("b");
+    kv->set_value("pong");
+
+    cb();
+  });
+
+  std::string value;
+  Status got = raw_kv->Get("b", value);
+  EXPECT_TRUE(got.IsOK());
+  EXPECT_EQ(value, "pong");
+}
+
 TEST_F(SDKRawKVTest, BatchGetSuccess) {
   std::vector<std::string> keys;
   keys.emplace_back("b");
@@ -124,6 +274,40 @@ TEST_F(SDKRawKVTest, BatchGetSuccess) {
   }
 }
 
+TEST_F(SDKRawKVTest, AsyncBatchGet) {
+  std::vector<std::string> keys{"b", "d", "f"};
+  std::vector<KVPair> kvs;
+
+  EXPECT_CALL(*rpc_client, SendRpc).WillRepeatedly([&](Rpc& rpc, std::function<void()> cb) {
+    auto* batch_get_rpc = dynamic_cast<KvBatchGetRpc*>(&rpc);
+    CHECK_NOTNULL(batch_get_rpc);
+
+    for (const auto& key : batch_get_rpc->Request()->keys()) {
+      auto* kv = batch_get_rpc->MutableResponse()->add_kvs();
+      kv->set_key(key);
+      kv->set_value(key);
+    }
+
+    cb();
+  });
+
+  // keys are moved in, kvs is owned by caller until callback
+  std::future<Status> future =
+      AsyncToFuture([&](StatusCallback cb) { raw_kv->AsyncBatchGet(std::move(keys), kvs, std::move(cb)); });
+  Status got = future.get();
+  EXPECT_TRUE(got.IsOK());
+  EXPECT_EQ(3, kvs.size());
+
+  for (const auto& kv : kvs) {
+    EXPECT_EQ(kv.key, kv.value);
+  }
+
+  std::vector<KVPair> scan_kvs;
+  Status scan_status;
+  raw_kv->AsyncScan("d", "b", 0, scan_kvs, [&](Status s) { scan_status = s; });
+  EXPECT_TRUE(scan_status.IsInvalidArgument());
+}
+
 TEST_F(SDKRawKVTest, BatchGetPartialFail) {
   std::vector<std::string> keys;
   keys.emplace_back("b");
@@ -298,6 +482,106 @@ TEST_F(SDKRawKVTest, BatchPutPartialFail) {
   EXPECT_FALSE(put.IsOK());
 }
 
+TEST_F(SDKRawKVTest, BatchPutSplitByCountAndBytes) {
+  FLAGS_raw_kv_batch_write_max_count = 2;
+  FLAGS_raw_kv_batch_write_max_bytes = 10;
+  FLAGS_raw_kv_batch_write_window_per_store = 1;
+  SCOPED_CLEANUP({
+    FLAGS_raw_kv_batch_write_max_count = 4096;
+    FLAGS_raw_kv_batch_write_max_bytes = 4 * 1024 * 1024;
+    FLAGS_raw_kv_batch_write_window_per_store = 4;
+  });
+
+  // region A2C get b1 b2 | b3 | b4, b3 alone exceed max bytes, region C2E get d1
+  std::vector<KVPair> kvs;
+  kvs.push_back({"b1", "b1"});
+  kvs.push_back({"b2", "b2"});
+  kvs.push_back({"b3", "b3333333333"});
+  kvs.push_back({"b4", "b4"});
+  kvs.push_back({"d1", "d1"});
+
+  std::map<std::string, int> put_keys;
+  int rpc_count = 0;
+  EXPECT_CALL(*rpc_client, SendRpc).WillRepeatedly([&](Rpc& rpc, std::function<void()> cb) {
+    auto* kv_batch_put_rpc = dynamic_cast<KvBatchPutRpc*>(&rpc);
+    CHECK_NOTNULL(kv_batch_put_rpc);
+
+    rpc_count++;
+    EXPECT_LE(kv_batch_put_rpc->Request()->kvs_size(), 2);
+    for (const auto& kv : kv_batch_put_rpc->Request()->kvs()) {
+      put_keys[kv.key()]++;
+      // chunk with b4 fail, the others still go out
+      if (kv.key() == "b4") {
+        auto* error = kv_batch_put_rpc->MutableResponse()->mutable_error();
+        error->set_errcode(pb::error::EINTERNAL);
+      }
+    }
+
+    cb();
+  });
+
+  Status put = raw_kv->BatchPut(kvs);
+  EXPECT_FALSE(put.IsOK());
+  EXPECT_EQ(rpc_count, 4);
+  EXPECT_EQ(put_keys.size(), kvs.size());
+  for (const auto& [key, count] : put_keys) {
+    EXPECT_EQ(count, 1);
+  }
+}
+
+TEST_F(SDKRawKVTest, BatchPutBoundInFlightPerStore) {
+  FLAGS_raw_kv_batch_write_max_count = 1;
+  FLAGS_raw_kv_batch_write_window_per_store = 2;
+  SCOPED_CLEANUP({
+    FLAGS_raw_kv_batch_write_max_count = 4096;
+    FLAGS_raw_kv_batch_write_window_per_store = 4;
+  });
+
+  // all keys in region A2C, one rpc per key to the same store
+  std::vector<KVPair> kvs;
+  for (int i = 1; i <= 6; i++) {
+    std::string key = "b" + std::to_string(i);
+    kvs.push_back({key, key});
+  }
+
+  // callbacks are deferred, so rpcs pile up unless the window holds them back
+  std::mutex mutex;
+  std::condition_variable cond;
+  std::deque<std::function<void()>> pending;
+  int in_flight = 0;
+  int max_in_flight = 0;
+  int rpc_count = 0;
+  EXPECT_CALL(*rpc_client, SendRpc).WillRepeatedly([&](Rpc& rpc, std::function<void()> cb) {
+    auto* kv_batch_put_rpc = dynamic_cast<KvBatchPutRpc*>(&rpc);
+    CHECK_NOTNULL(kv_batch_put_rpc);
+
+    std::lock_guard<std::mutex> guard(mutex);
+    rpc_count++;
+    in_flight++;
+    max_in_flight = std::max(max_in_flight, in_flight);
+    pending.push_back(std::move(cb));
+    cond.notify_all();
+  });
+
+  auto put_future = std::async(std::launch::async, [&]() { return raw_kv->BatchPut(kvs); });
+
+  for (int done = 0; done < kvs.size(); done++) {
+    std::function<void()> cb;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      ASSERT_TRUE(cond.wait_for(lock, std::chrono::seconds(10), [&]() { return !pending.empty(); }));
+      cb = std::move(pending.front());
+      pending.pop_front();
+      in_flight--;
+    }
+    cb();
+  }
+
+  EXPECT_TRUE(put_future.get().IsOK());
+  EXPECT_EQ(rpc_count, kvs.size());
+  EXPECT_EQ(max_in_flight, FLAGS_raw_kv_batch_write_window_per_store);
+}
+
 TEST_F(SDKRawKVTest, PutIfAbsent) {
   std::string key = "d";
   std::string value = "d";
@@ -1421,5 +1705,328 @@ TEST_F(SDKRawKVTest, ScanRegionDiscontinuousWithLimit) {
     EXPECT_EQ(kv.key, kv.value);
   }
 }
+
+using BatchHook = std::function<void(const ScannerOptions& options, int batch_index, StatusCallback cb)>;
+
+// fake region scanner factory, the scanner of a region return keys of fake_datas[region start key] within its scan
+// range, batch_size kvs each batch, value is the key or empty when key only. hook decide when and how a batch returns,
+// default return ok at once
+static std::function<Status(const ScannerOptions&, std::shared_ptr<RegionScanner>&)> FakeRegionScannerFactory(
+    const std::map<std::string, std::vector<std::string>>& fake_datas, int batch_size, BatchHook hook = nullptr) {
+  return [fake_datas, batch_size, hook](const ScannerOptions& options, std::shared_ptr<RegionScanner>& scanner) {
+    auto mock_scanner =
+        std::make_shared<MockRegionScanner>(options.stub, options.region, options.start_key, options.end_key);
+
+    auto datas = std::make_shared<std::vector<std::string>>();
+    auto iter = fake_datas.find(options.region->GetRange().start_key);
+    if (iter != fake_datas.end()) {
+      for (const auto& key : iter->second) {
+        if (key >= options.start_key && key < options.end_key) {
+          datas->push_back(key);
+        }
+      }
+    }
+    auto next = std::make_shared<size_t>(0);
+    auto batch_index = std::make_shared<int>(0);
+
+    EXPECT_CALL(*mock_scanner, AsyncOpen).WillOnce([](StatusCallback cb) { cb(Status::OK()); });
+
+    EXPECT_CALL(*mock_scanner, HasMore).WillRepeatedly([datas, next]() { return *next < datas->size(); });
+
+    EXPECT_CALL(*mock_scanner, AsyncNextBatch)
+        .WillRepeatedly([options, batch_size, hook, datas, next, batch_index](std::vector<KVPair>& kvs,
+                                                                               StatusCallback cb) {
+          for (int i = 0; i < batch_size && *next < datas->size(); ++i) {
+            const auto& key = (*datas)[*next];
+            kvs.push_back({key, options.key_only ? "" : key});
+            (*next)++;
+          }
+
+          int index = (*batch_index)++;
+          if (hook) {
+            hook(options, index, std::move(cb));
+          } else {
+            cb(Status::OK());
+          }
+        });
+
+    scanner = std::move(mock_scanner);
+    return Status::OK();
+  };
+}
+
+TEST_F(SDKRawKVTest, ScanParallelKeepKeyOrder) {
+  FLAGS_scan_region_concurrency = 3;
+  FLAGS_scan_region_prefetch_batch_num = 1;
+  SCOPED_CLEANUP({
+    FLAGS_scan_region_concurrency = 1;
+    FLAGS_scan_region_prefetch_batch_num = 2;
+  });
+
+  std::map<std::string, std::vector<std::string>> fake_datas = {
+      {"a", {"a001", "a002", "a003"}}, {"c", {"c001", "c002", "c003"}}, {"e", {"e001", "e002", "e003"}}};
+
+  // regions are read ahead in parallel, the region behind head hold at most one batch
+  EXPECT_CALL(*region_scanner_factory, NewRegionScanner)
+      .Times(3)
+      .WillRepeatedly(FakeRegionScannerFactory(fake_datas, 1));
+
+  std::vector<KVPair> kvs;
+  Status ret = raw_kv->Scan("a", "z", 0, kvs);
+  EXPECT_TRUE(ret.IsOK());
+
+  std::vector<std::string> expect_keys = {"a001", "a002", "a003", "c001", "c002", "c003", "e001", "e002", "e003"};
+  ASSERT_EQ(kvs.size(), expect_keys.size());
+  for (int i = 0; i < kvs.size(); ++i) {
+    EXPECT_EQ(kvs[i].key, expect_keys[i]);
+    EXPECT_EQ(kvs[i].key, kvs[i].value);
+  }
+
+  kvs.clear();
+  EXPECT_CALL(*region_scanner_factory, NewRegionScanner).WillRepeatedly(FakeRegionScannerFactory(fake_datas, 1));
+
+  int limit = 4;
+  ret = raw_kv->Scan("a", "z", limit, kvs);
+  EXPECT_TRUE(ret.IsOK());
+
+  ASSERT_EQ(kvs.size(), limit);
+  for (int i = 0; i < limit; ++i) {
+    EXPECT_EQ(kvs[i].key, expect_keys[i]);
+  }
+}
+
+TEST_F(SDKRawKVTest, ScanParallelRetryResume) {
+  FLAGS_scan_region_concurrency = 3;
+  FLAGS_scan_region_prefetch_batch_num = 1;
+  FLAGS_raw_kv_delay_ms = 1;
+  SCOPED_CLEANUP({
+    FLAGS_scan_region_concurrency = 1;
+    FLAGS_scan_region_prefetch_batch_num = 2;
+    FLAGS_raw_kv_delay_ms = 500;
+  });
+
+  std::map<std::string, std::vector<std::string>> fake_datas = {
+      {"a", {"a001", "a002"}}, {"c", {"c001", "c002", "c003"}}, {"e", {"e001", "e002"}}};
+
+  // second batch of region c fail once with a retryable error, c001 is merged by then
+  bool failed = false;
+  auto factory = FakeRegionScannerFactory(
+      fake_datas, 1, [&failed](const ScannerOptions& options, int batch_index, StatusCallback cb) {
+        if (!failed && options.region->GetRange().start_key == "c" && batch_index == 1) {
+          failed = true;
+          cb(Status::Incomplete(pb::error::EREGION_VERSION, "region version changed"));
+          return;
+        }
+        cb(Status::OK());
+      });
+
+  std::vector<std::string> scanner_start_keys;
+  EXPECT_CALL(*region_scanner_factory, NewRegionScanner)
+      .WillRepeatedly([&](const ScannerOptions& options, std::shared_ptr<RegionScanner>& scanner) {
+        scanner_start_keys.push_back(options.start_key);
+        return factory(options, scanner);
+      });
+
+  std::vector<KVPair> kvs;
+  Status ret = raw_kv->Scan("a", "z", 0, kvs);
+  EXPECT_TRUE(ret.IsOK()) << ret.ToString();
+  EXPECT_TRUE(failed);
+
+  // retry resume from the key after c001 instead of rescanning from the start
+  std::vector<std::string> expect_start_keys = {"a", "c", "e", std::string("c001") + '\0', "e"};
+  EXPECT_EQ(scanner_start_keys, expect_start_keys);
+
+  std::vector<std::string> expect_keys = {"a001", "a002", "c001", "c002", "c003", "e001", "e002"};
+  ASSERT_EQ(kvs.size(), expect_keys.size());
+  for (int i = 0; i < kvs.size(); ++i) {
+    EXPECT_EQ(kvs[i].key, expect_keys[i]);
+  }
+}
+
+TEST_F(SDKRawKVTest, ScanParallelLimitWaitInflight) {
+  FLAGS_scan_region_concurrency = 3;
+  FLAGS_scan_region_prefetch_batch_num = 1;
+  SCOPED_CLEANUP({
+    FLAGS_scan_region_concurrency = 1;
+    FLAGS_scan_region_prefetch_batch_num = 2;
+  });
+
+  std::map<std::string, std::vector<std::string>> fake_datas = {
+      {"a", {"a001", "a002", "a003"}}, {"c", {"c001", "c002"}}, {"e", {"e001", "e002"}}};
+
+  // batches of region c and e are held until the test fire them
+  std::mutex mutex;
+  std::condition_variable cond;
+  std::vector<StatusCallback> held;
+  std::map<std::string, int> batch_count;
+  EXPECT_CALL(*region_scanner_factory, NewRegionScanner)
+      .Times(3)
+      .WillRepeatedly(
+          FakeRegionScannerFactory(fake_datas, 1, [&](const ScannerOptions& options, int, StatusCallback cb) {
+            const std::string region_start = options.region->GetRange().start_key;
+            {
+              std::lock_guard<std::mutex> guard(mutex);
+              batch_count[region_start]++;
+              if (region_start != "a") {
+                held.push_back(std::move(cb));
+                cond.notify_all();
+                return;
+              }
+            }
+            cb(Status::OK());
+          }));
+
+  std::vector<KVPair> kvs;
+  int limit = 3;
+  auto scan_future = std::async(std::launch::async, [&]() { return raw_kv->Scan("a", "z", limit, kvs); });
+
+  std::vector<StatusCallback> to_fire;
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    ASSERT_TRUE(cond.wait_for(lock, std::chrono::seconds(10), [&]() { return held.size() == 2; }));
+    to_fire.swap(held);
+  }
+
+  // limit is reached by region a, but scan is not done until in flight batches return
+  EXPECT_EQ(std::future_status::timeout, scan_future.wait_for(std::chrono::milliseconds(100)));
+
+  for (auto& cb : to_fire) {
+    cb(Status::OK());
+  }
+
+  Status ret = scan_future.get();
+  EXPECT_TRUE(ret.IsOK());
+  ASSERT_EQ(kvs.size(), limit);
+  EXPECT_EQ(kvs[0].key, "a001");
+  EXPECT_EQ(kvs[1].key, "a002");
+  EXPECT_EQ(kvs[2].key, "a003");
+
+  // no more batch is requested after limit is reached
+  EXPECT_EQ(batch_count["c"], 1);
+  EXPECT_EQ(batch_count["e"], 1);
+  EXPECT_TRUE(held.empty());
+}
+
+TEST_F(SDKRawKVTest, IteratorCrossRegion) {
+  std::map<std::string, std::vector<std::string>> fake_datas = {
+      {"a", {"a001", "a002", "a003"}}, {"c", {}}, {"e", {"e001", "e002"}}};
+
+  // two kvs each batch
+  EXPECT_CALL(*region_scanner_factory, NewRegionScanner)
+      .Times(3)
+      .WillRepeatedly(FakeRegionScannerFactory(fake_datas, 2));
+
+  RawKVIterator* tmp = nullptr;
+  Status ret = raw_kv->NewIterator("a", "z", RawKVIteratorOptions(), &tmp);
+  ASSERT_TRUE(ret.IsOK());
+  std::unique_ptr<RawKVIterator> iter(tmp);
+
+  std::vector<std::string> keys;
+  for (; iter->Valid(); iter->Next()) {
+    EXPECT_EQ(iter->Key(), iter->Value());
+    keys.push_back(iter->Key());
+  }
+  EXPECT_TRUE(iter->GetStatus().IsOK());
+
+  std::vector<std::string> expect_keys = {"a001", "a002", "a003", "e001", "e002"};
+  EXPECT_EQ(keys, expect_keys);
+
+  ret = raw_kv->NewIterator("d", "b", RawKVIteratorOptions(), &tmp);
+  EXPECT_TRUE(ret.IsInvalidArgument());
+}
+
+TEST_F(SDKRawKVTest, IteratorRetryReopen) {
+  FLAGS_raw_kv_delay_ms = 1;
+  SCOPED_CLEANUP({ FLAGS_raw_kv_delay_ms = 500; });
+
+  std::map<std::string, std::vector<std::string>> fake_datas = {{"a", {"a001", "a002", "a003", "a004"}}};
+
+  // second batch of the first scanner fail with epoch changed
+  auto factory =
+      FakeRegionScannerFactory(fake_datas, 2, [](const ScannerOptions& options, int batch_index, StatusCallback cb) {
+        if (options.start_key == "a" && batch_index == 1) {
+          cb(Status::Incomplete(pb::error::EREGION_VERSION, "region version changed"));
+          return;
+        }
+        cb(Status::OK());
+      });
+
+  std::vector<std::string> scanner_start_keys;
+  EXPECT_CALL(*region_scanner_factory, NewRegionScanner)
+      .WillRepeatedly([&](const ScannerOptions& options, std::shared_ptr<RegionScanner>& scanner) {
+        scanner_start_keys.push_back(options.start_key);
+        return factory(options, scanner);
+      });
+
+  RawKVIterator* tmp = nullptr;
+  Status ret = raw_kv->NewIterator("a", "c", RawKVIteratorOptions(), &tmp);
+  ASSERT_TRUE(ret.IsOK());
+  std::unique_ptr<RawKVIterator> iter(tmp);
+
+  std::vector<std::string> keys;
+  for (; iter->Valid(); iter->Next()) {
+    keys.push_back(iter->Key());
+  }
+  EXPECT_TRUE(iter->GetStatus().IsOK());
+
+  // reopen from the key after the last one fetched, nothing is returned twice
+  std::vector<std::string> expect_start_keys = {"a", std::string("a002") + '\0'};
+  EXPECT_EQ(scanner_start_keys, expect_start_keys);
+  std::vector<std::string> expect_keys = {"a001", "a002", "a003", "a004"};
+  EXPECT_EQ(keys, expect_keys);
+}
+
+TEST_F(SDKRawKVTest, IteratorSkipPrefetchLargeBatch) {
+  std::map<std::string, std::vector<std::string>> fake_datas = {{"a", {"a001", "a002", "a003", "a004"}}};
+  std::vector<std::string> expect_keys = {"a001", "a002", "a003", "a004"};
+
+  // each batch is 2 kvs of 16 bytes, prefetch only when the batch use no more than half of buffer_bytes
+  for (int64_t buffer_bytes : {32, 16}) {
+    int batch_count = 0;
+    EXPECT_CALL(*region_scanner_factory, NewRegionScanner)
+        .WillRepeatedly(FakeRegionScannerFactory(fake_datas, 2, [&](const ScannerOptions&, int, StatusCallback cb) {
+          batch_count++;
+          cb(Status::OK());
+        }));
+
+    RawKVIteratorOptions options;
+    options.buffer_bytes = buffer_bytes;
+    RawKVIterator* tmp = nullptr;
+    Status ret = raw_kv->NewIterator("a", "c", options, &tmp);
+    ASSERT_TRUE(ret.IsOK());
+    std::unique_ptr<RawKVIterator> iter(tmp);
+
+    // fake scanner return at once, so a started prefetch is already done
+    EXPECT_EQ(batch_count, buffer_bytes == 32 ? 2 : 1) << "buffer_bytes:" << buffer_bytes;
+
+    std::vector<std::string> keys;
+    for (; iter->Valid(); iter->Next()) {
+      keys.push_back(iter->Key());
+    }
+    EXPECT_TRUE(iter->GetStatus().IsOK());
+    EXPECT_EQ(keys, expect_keys);
+  }
+}
+
+TEST_F(SDKRawKVTest, CountRangeKeyOnly) {
+  std::map<std::string, std::vector<std::string>> fake_datas = {
+      {"a", {"a001", "a002", "a003"}}, {"c", {"c001"}}, {"e", {"e001", "e002"}}};
+
+  auto factory = FakeRegionScannerFactory(fake_datas, 1);
+  EXPECT_CALL(*region_scanner_factory, NewRegionScanner)
+      .Times(3)
+      .WillRepeatedly([&](const ScannerOptions& options, std::shared_ptr<RegionScanner>& scanner) {
+        EXPECT_TRUE(options.key_only);
+        return factory(options, scanner);
+      });
+
+  int64_t count = 0;
+  Status ret = raw_kv->CountRange("a", "z", count);
+  EXPECT_TRUE(ret.IsOK());
+  EXPECT_EQ(count, 6);
+
+  ret = raw_kv->CountRange("d", "b", count);
+  EXPECT_TRUE(ret.IsInvalidArgument());
+}
 }  // namespace sdk
 }  // namespace dingodb
\ No newline at end of file
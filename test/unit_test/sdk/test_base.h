@@ -31,12 +31,14 @@
 #include "sdk/auto_increment_manager.h"
 #include "sdk/client_internal_data.h"
 #include "sdk/meta_cache.h"
+#include "sdk/rawkv/raw_kv_auto_batcher.h"
 #include "sdk/transaction/tso.h"
 #include "sdk/transaction/txn_impl.h"
 #include "sdk/transaction/txn_manager.h"
 #include "sdk/utils/actuator.h"
 #include "sdk/utils/thread_pool_actuator.h"
 #include "sdk/vector/vector_index_cache.h"
+#include "sdk/vector/vector_search_auto_batcher.h"
 #include "test_common.h"
 #include "transaction/mock_txn_lock_resolver.h"
 
@@ -113,6 +115,16 @@ class TestBase : public ::testing::Test {
     ON_CALL(*stub, GetTxnManager).WillByDefault(testing::Return(txn_manager.get()));
     EXPECT_CALL(*stub, GetTxnManager).Times(testing::AnyNumber());
 
+    raw_kv_auto_batcher =
+        std::make_shared<RawKvAutoBatcher>(*stub, FLAGS_auto_batch_window_us, FLAGS_auto_batch_max_size);
+    ON_CALL(*stub, GetRawKvAutoBatcher).WillByDefault(testing::Return(raw_kv_auto_batcher));
+    EXPECT_CALL(*stub, GetRawKvAutoBatcher).Times(testing::AnyNumber());
+
+    vector_search_auto_batcher =
+        std::make_shared<VectorSearchAutoBatcher>(*stub, FLAGS_auto_batch_window_us, FLAGS_auto_batch_max_size);
+    ON_CALL(*stub, GetVectorSearchAutoBatcher).WillByDefault(testing::Return(vector_search_auto_batcher));
+    EXPECT_CALL(*stub, GetVectorSearchAutoBatcher).Times(testing::AnyNumber());
+
     client = new Client();
     client->data_->stub = std::move(tmp);
   }
@@ -162,6 +174,8 @@ class TestBase : public ::testing::Test {
   std::shared_ptr<AutoIncrementerManager> auto_increment_manager;
   std::shared_ptr<TsoProvider> tso_provider;
   std::unique_ptr<TxnManager> txn_manager;
+  std::shared_ptr<RawKvAutoBatcher> raw_kv_auto_batcher;
+  std::shared_ptr<VectorSearchAutoBatcher> vector_search_auto_batcher;
 
   // client own stub
   MockClientStub* stub;
@@ -0,0 +1,107 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "brpc/channel.h"
+#include "gtest/gtest.h"
+#include "sdk/rpc/brpc/brpc_rpc_client.h"
+#include "sdk/utils/net_util.h"
+
+namespace dingodb {
+namespace sdk {
+
+// brpc channel connect lazily, so channels to unused ports are fine here
+class SDKBrpcRpcClientTest : public testing::Test {
+ public:
+  static RpcClientOptions Options(int channel_num) {
+    RpcClientOptions options;
+    options.channel_num_per_endpoint = channel_num;
+    return options;
+  }
+};
+
+TEST_F(SDKBrpcRpcClientTest, ChannelPoolPerEndPoint) {
+  BrpcRpcClient client(Options(3));
+  EndPoint end_point("127.0.0.1", 20001);
+
+  // round robin over the pool of the endpoint
+  std::vector<brpc::Channel*> channels;
+  for (int i = 0; i < 6; i++) {
+    channels.push_back(client.TEST_GetChannel(end_point).get());
+  }
+
+  std::set<brpc::Channel*> distinct(channels.begin(), channels.end());
+  EXPECT_EQ(distinct.size(), 3);
+  for (int i = 0; i < 3; i++) {
+    EXPECT_EQ(channels[i], channels[i + 3]);
+  }
+
+  // other endpoint has its own pool
+  auto other = client.TEST_GetChannel(EndPoint("127.0.0.1", 20002));
+  EXPECT_EQ(distinct.count(other.get()), 0);
+}
+
+TEST_F(SDKBrpcRpcClientTest, SingleChannelPerEndPoint) {
+  BrpcRpcClient client(Options(0));
+  EndPoint end_point("127.0.0.1", 20001);
+
+  auto channel = client.TEST_GetChannel(end_point);
+  EXPECT_NE(channel, nullptr);
+  EXPECT_EQ(channel, client.TEST_GetChannel(end_point));
+}
+
+TEST_F(SDKBrpcRpcClientTest, ConcurrentShardedLookup) {
+  BrpcRpcClient client(Options(1));
+
+  std::vector<EndPoint> end_points;
+  std::set<size_t> shards;
+  for (int i = 0; i < 64; i++) {
+    end_points.emplace_back("127.0.0.1", 20000 + i);
+    shards.insert(BrpcRpcClient::TEST_ShardIndex(end_points.back()));
+  }
+  // endpoints of one host spread over shards
+  EXPECT_GT(shards.size(), 1);
+
+  // racing first lookups of an endpoint end up with one channel
+  const int thread_num = 8;
+  std::vector<std::vector<brpc::Channel*>> got(thread_num, std::vector<brpc::Channel*>(end_points.size()));
+  std::vector<std::thread> threads;
+  threads.reserve(thread_num);
+  for (int t = 0; t < thread_num; t++) {
+    threads.emplace_back([&, t]() {
+      for (size_t i = 0; i < end_points.size(); i++) {
+        got[t][i] = client.TEST_GetChannel(end_points[i]).get();
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  std::set<brpc::Channel*> distinct;
+  for (size_t i = 0; i < end_points.size(); i++) {
+    for (int t = 1; t < thread_num; t++) {
+      EXPECT_EQ(got[t][i], got[0][i]);
+    }
+    distinct.insert(got[0][i]);
+  }
+  EXPECT_EQ(distinct.size(), end_points.size());
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,109 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <future>
+#include <string>
+#include <thread>
+
+#include "dingosdk/coro.h"
+#include "dingosdk/status.h"
+#include "gtest/gtest.h"
+
+namespace dingodb {
+namespace sdk {
+
+namespace {
+
+// minimal eager coroutine which report its end through a promise
+struct Detached {
+  struct promise_type {
+    Detached get_return_object() { return {}; }
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    std::suspend_never final_suspend() noexcept { return {}; }
+    void return_void() {}
+    void unhandled_exception() { std::terminate(); }
+  };
+};
+
+Detached AwaitInline(std::promise<Status>& done) {
+  Status status = co_await coro::Await([](StatusCallback cb) { cb(Status::NotFound("inline")); });
+  done.set_value(status);
+}
+
+Detached AwaitInlineWithOutput(std::promise<coro::Result<std::string>>& done) {
+  auto result = co_await coro::Await<std::string>([](std::string& out, StatusCallback cb) {
+    out = "value";
+    cb(Status::OK());
+  });
+  done.set_value(std::move(result));
+}
+
+// worker complete the call only after the coroutine has suspended and returned to caller
+Detached AwaitOtherThread(std::shared_future<void> go, std::promise<std::thread::id>& done, std::thread& worker,
+                          int64_t& out_value) {
+  auto start = [go, &worker](int64_t& out, StatusCallback cb) {
+    worker = std::thread([go, &out, cb = std::move(cb)]() {
+      go.wait();
+      out = 42;
+      cb(Status::OK());
+    });
+  };
+  auto [status, value] = co_await coro::Await<int64_t>(std::move(start));
+  EXPECT_TRUE(status.ok());
+  out_value = value;
+  done.set_value(std::this_thread::get_id());
+}
+
+}  // namespace
+
+TEST(CoroTest, CompleteBeforeSuspend) {
+  std::promise<Status> done;
+  auto future = done.get_future();
+  AwaitInline(done);
+
+  Status status = future.get();
+  EXPECT_TRUE(status.IsNotFound());
+}
+
+TEST(CoroTest, CompleteBeforeSuspendWithOutput) {
+  std::promise<coro::Result<std::string>> done;
+  auto future = done.get_future();
+  AwaitInlineWithOutput(done);
+
+  auto result = future.get();
+  EXPECT_TRUE(result.status.ok());
+  EXPECT_EQ(result.value, "value");
+}
+
+TEST(CoroTest, ResumeInCompletingThread) {
+  std::promise<std::thread::id> done;
+  auto future = done.get_future();
+  std::promise<void> go;
+  std::thread worker;
+  int64_t value = 0;
+  AwaitOtherThread(go.get_future().share(), done, worker, value);
+  go.set_value();
+
+  std::thread::id resume_thread = future.get();
+  std::thread::id worker_thread = worker.get_id();
+  worker.join();
+  EXPECT_EQ(resume_thread, worker_thread);
+  EXPECT_EQ(value, 42);
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -12,12 +12,19 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
 #include <vector>
 
 #include "gtest/gtest.h"
 #include "mock_coordinator_rpc_controller.h"
+#include "sdk/common/param_config.h"
 #include "sdk/meta_cache.h"
 #include "sdk/rpc/coordinator_rpc.h"
+#include "sdk/utils/scoped_cleanup.h"
 #include "test_base.h"
 #include "test_common.h"
 
@@ -721,5 +728,513 @@ TEST_F(SDKMetaCacheTest, ScanRegionsBetweenContinuousRangeMultipleRegionFromRemo
   }
 }
 
+TEST_F(SDKMetaCacheTest, SnapshotVersion) {
+  uint64_t version = meta_cache->SnapshotVersion();
+
+  auto a2c = RegionA2C();
+  meta_cache->MaybeAddRegion(a2c);
+  EXPECT_GT(meta_cache->SnapshotVersion(), version);
+  version = meta_cache->SnapshotVersion();
+
+  meta_cache->MaybeAddRegions({RegionC2E(), RegionE2G()});
+  EXPECT_EQ(meta_cache->SnapshotVersion(), version + 1);
+  version = meta_cache->SnapshotVersion();
+
+  std::shared_ptr<Region> tmp;
+  Status got = meta_cache->TEST_FastLookUpRegionByKey("d", tmp);
+  EXPECT_TRUE(got.IsOK());
+  EXPECT_EQ(tmp->GetRange().start_key, "c");
+
+  meta_cache->ClearRegion(tmp);
+  EXPECT_GT(meta_cache->SnapshotVersion(), version);
+
+  got = meta_cache->TEST_FastLookUpRegionByKey("d", tmp);
+  EXPECT_TRUE(got.IsNotFound());
+
+  got = meta_cache->TEST_FastLookUpRegionByKey("b", tmp);
+  EXPECT_TRUE(got.IsOK());
+  EXPECT_EQ(tmp->RegionId(), a2c->RegionId());
+
+  meta_cache->ClearCache();
+  got = meta_cache->TEST_FastLookUpRegionByKey("b", tmp);
+  EXPECT_TRUE(got.IsNotFound());
+}
+
+TEST_F(SDKMetaCacheTest, LookupRegionsByKeysFromCache) {
+  auto a2c = RegionA2C();
+  auto c2e = RegionC2E();
+  meta_cache->MaybeAddRegions({a2c, c2e});
+
+  EXPECT_CALL(*coordinator_rpc_controller, SyncCall).Times(0);
+
+  std::vector<std::string_view> keys = {"d", "a", "c", "b"};
+  std::vector<RegionKeyGroup> groups;
+  Status got = meta_cache->LookupRegionsByKeys(keys, groups);
+  EXPECT_TRUE(got.ok());
+  EXPECT_EQ(groups.size(), 2);
+
+  EXPECT_EQ(groups[0].region->RegionId(), a2c->RegionId());
+  EXPECT_EQ(groups[0].key_indexes, std::vector<size_t>({1, 3}));
+
+  EXPECT_EQ(groups[1].region->RegionId(), c2e->RegionId());
+  EXPECT_EQ(groups[1].key_indexes, std::vector<size_t>({2, 0}));
+}
+
+TEST_F(SDKMetaCacheTest, LookupRegionsByKeysFromRemote) {
+  auto a2c = RegionA2C();
+  auto c2e = RegionC2E();
+  auto e2g = RegionE2G();
+  meta_cache->MaybeAddRegion(c2e);
+
+  // "d" hit cache, so "a","b" and "f" are scanned separately instead of one scan over [a, f]
+  EXPECT_CALL(*coordinator_rpc_controller, SyncCall)
+      .WillOnce([&](Rpc& rpc) {
+        auto* t_rpc = dynamic_cast<ScanRegionsRpc*>(&rpc);
+        EXPECT_EQ(t_rpc->Request()->key(), "a");
+        EXPECT_EQ(t_rpc->Request()->range_end(), std::string("b\0", 2));
+        EXPECT_EQ(t_rpc->Request()->limit(), 2);
+        Region2ScanRegionInfo(a2c, t_rpc->MutableResponse()->add_regions());
+        return Status::OK();
+      })
+      .WillOnce([&](Rpc& rpc) {
+        auto* t_rpc = dynamic_cast<ScanRegionsRpc*>(&rpc);
+        EXPECT_EQ(t_rpc->Request()->key(), "f");
+        EXPECT_EQ(t_rpc->Request()->range_end(), std::string("f\0", 2));
+        EXPECT_EQ(t_rpc->Request()->limit(), 1);
+        Region2ScanRegionInfo(e2g, t_rpc->MutableResponse()->add_regions());
+        return Status::OK();
+      });
+
+  std::vector<std::string_view> keys = {"b", "d", "f", "a"};
+  std::vector<RegionKeyGroup> groups;
+  Status got = meta_cache->LookupRegionsByKeys(keys, groups);
+  EXPECT_TRUE(got.ok());
+  EXPECT_EQ(groups.size(), 3);
+
+  EXPECT_EQ(groups[0].region->RegionId(), c2e->RegionId());
+  EXPECT_EQ(groups[0].key_indexes, std::vector<size_t>({1}));
+
+  EXPECT_EQ(groups[1].region->RegionId(), a2c->RegionId());
+  EXPECT_EQ(groups[1].key_indexes, std::vector<size_t>({3, 0}));
+
+  EXPECT_EQ(groups[2].region->RegionId(), e2g->RegionId());
+  EXPECT_EQ(groups[2].key_indexes, std::vector<size_t>({2}));
+
+  std::shared_ptr<Region> tmp;
+  got = meta_cache->TEST_FastLookUpRegionByKey("f", tmp);
+  EXPECT_TRUE(got.IsOK());
+  EXPECT_EQ(tmp->RegionId(), e2g->RegionId());
+}
+
+TEST_F(SDKMetaCacheTest, LookupRegionsByKeysNotFound) {
+  auto a2c = RegionA2C();
+
+  EXPECT_CALL(*coordinator_rpc_controller, SyncCall).WillOnce([&](Rpc& rpc) {
+    auto* t_rpc = dynamic_cast<ScanRegionsRpc*>(&rpc);
+    Region2ScanRegionInfo(a2c, t_rpc->MutableResponse()->add_regions());
+    return Status::OK();
+  });
+
+  std::vector<std::string_view> keys = {"b", "x"};
+  std::vector<RegionKeyGroup> groups;
+  Status got = meta_cache->LookupRegionsByKeys(keys, groups);
+  EXPECT_TRUE(got.IsNotFound());
+}
+
+TEST_F(SDKMetaCacheTest, LookupRegionsByKeysScanTruncatedByLimit) {
+  auto a2c = RegionA2C();
+  auto c2e = RegionC2E();
+  auto e2g = RegionE2G();
+
+  // "a" and "f" need 2 regions, but the first scan stop at c2e which has no key
+  EXPECT_CALL(*coordinator_rpc_controller, SyncCall)
+      .WillOnce([&](Rpc& rpc) {
+        auto* t_rpc = dynamic_cast<ScanRegionsRpc*>(&rpc);
+        EXPECT_EQ(t_rpc->Request()->key(), "a");
+        EXPECT_EQ(t_rpc->Request()->limit(), 2);
+        Region2ScanRegionInfo(a2c, t_rpc->MutableResponse()->add_regions());
+        Region2ScanRegionInfo(c2e, t_rpc->MutableResponse()->add_regions());
+        return Status::OK();
+      })
+      .WillOnce([&](Rpc& rpc) {
+        auto* t_rpc = dynamic_cast<ScanRegionsRpc*>(&rpc);
+        EXPECT_EQ(t_rpc->Request()->key(), "f");
+        EXPECT_EQ(t_rpc->Request()->limit(), 1);
+        Region2ScanRegionInfo(e2g, t_rpc->MutableResponse()->add_regions());
+        return Status::OK();
+      });
+
+  std::vector<std::string_view> keys = {"a", "f"};
+  std::vector<RegionKeyGroup> groups;
+  Status got = meta_cache->LookupRegionsByKeys(keys, groups);
+  EXPECT_TRUE(got.ok());
+  EXPECT_EQ(groups.size(), 2);
+
+  EXPECT_EQ(groups[0].region->RegionId(), a2c->RegionId());
+  EXPECT_EQ(groups[0].key_indexes, std::vector<size_t>({0}));
+
+  EXPECT_EQ(groups[1].region->RegionId(), e2g->RegionId());
+  EXPECT_EQ(groups[1].key_indexes, std::vector<size_t>({1}));
+}
+
+TEST_F(SDKMetaCacheTest, CoalesceConcurrentLookupRegionByKey) {
+  const int kThreadNum = 8;
+  auto a2c = RegionA2C();
+
+  EXPECT_CALL(*coordinator_rpc_controller, SyncCall).WillOnce([&](Rpc& rpc) {
+    // wait until other lookups join this rpc
+    for (int i = 0; i < 1000 && meta_cache->GetStats().coalesced_count < kThreadNum - 1; ++i) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    auto* t_rpc = dynamic_cast<ScanRegionsRpc*>(&rpc);
+    Region2ScanRegionInfo(a2c, t_rpc->MutableResponse()->add_regions());
+    return Status::OK();
+  });
+
+  std::vector<std::thread> threads;
+  std::vector<int64_t> region_ids(kThreadNum, 0);
+  for (int i = 0; i < kThreadNum; ++i) {
+    threads.emplace_back([&, i] {
+      std::shared_ptr<Region> tmp;
+      Status got = meta_cache->LookupRegionByKey(i % 2 == 0 ? "a" : "b", tmp);
+      EXPECT_TRUE(got.IsOK());
+      if (got.IsOK()) {
+        region_ids[i] = tmp->RegionId();
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (auto region_id : region_ids) {
+    EXPECT_EQ(region_id, a2c->RegionId());
+  }
+
+  auto stats = meta_cache->GetStats();
+  EXPECT_EQ(stats.miss_count, kThreadNum);
+  EXPECT_EQ(stats.rpc_count, 1);
+  EXPECT_EQ(stats.coalesced_count, kThreadNum - 1);
+}
+
+TEST_F(SDKMetaCacheTest, SaveAndLoadRegionCacheFile) {
+  auto a2c = RegionA2C();
+  auto c2e = RegionC2E();
+  meta_cache->MaybeAddRegions({a2c, c2e});
+
+  std::string path = ::testing::TempDir() + "sdk_meta_cache_test_region_cache";
+  Status got = meta_cache->SaveToFile(path);
+  EXPECT_TRUE(got.IsOK());
+
+  auto new_meta_cache = std::make_shared<MetaCache>(coordinator_rpc_controller);
+  EXPECT_CALL(*coordinator_rpc_controller, SyncCall).Times(0);
+
+  got = new_meta_cache->LoadFromFile(path);
+  EXPECT_TRUE(got.IsOK());
+
+  std::shared_ptr<Region> tmp;
+  got = new_meta_cache->LookupRegionByKey("b", tmp);
+  EXPECT_TRUE(got.IsOK());
+  EXPECT_EQ(tmp->RegionId(), a2c->RegionId());
+  EXPECT_EQ(tmp->GetEpoch().version, a2c->GetEpoch().version);
+  EXPECT_EQ(tmp->GetRange().end_key, "c");
+
+  EndPoint leader;
+  EXPECT_TRUE(tmp->GetLeader(leader).IsOK());
+
+  got = new_meta_cache->LookupRegionByKey("d", tmp);
+  EXPECT_TRUE(got.IsOK());
+  EXPECT_EQ(tmp->RegionId(), c2e->RegionId());
+
+  std::remove(path.c_str());
+}
+
+TEST_F(SDKMetaCacheTest, ConcurrentSaveRegionCacheFile) {
+  meta_cache->MaybeAddRegions({RegionA2C(), RegionC2E()});
+  auto other_cache = std::make_shared<MetaCache>(coordinator_rpc_controller);
+  other_cache->MaybeAddRegions({RegionE2G()});
+
+  // two clients share one cache file, each save must publish a whole file of its own
+  std::string path = ::testing::TempDir() + "sdk_meta_cache_test_region_cache_concurrent";
+  std::vector<std::thread> threads;
+  for (const auto& cache : {meta_cache, other_cache}) {
+    threads.emplace_back([cache, &path]() {
+      for (int i = 0; i < 50; i++) {
+        EXPECT_TRUE(cache->SaveToFile(path).IsOK());
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  auto new_meta_cache = std::make_shared<MetaCache>(coordinator_rpc_controller);
+  EXPECT_TRUE(new_meta_cache->LoadFromFile(path).IsOK());
+  std::shared_ptr<Region> tmp;
+  bool has_a2c = new_meta_cache->TEST_FastLookUpRegionByKey("b", tmp).IsOK();
+  bool has_c2e = new_meta_cache->TEST_FastLookUpRegionByKey("d", tmp).IsOK();
+  bool has_e2g = new_meta_cache->TEST_FastLookUpRegionByKey("f", tmp).IsOK();
+  EXPECT_EQ(has_a2c, has_c2e);
+  EXPECT_NE(has_a2c, has_e2g);
+
+  std::remove(path.c_str());
+}
+
+TEST_F(SDKMetaCacheTest, SnapshotPublishOnWrite) {
+  auto a2c = RegionA2C();
+  uint64_t version = meta_cache->SnapshotVersion();
+  meta_cache->MaybeAddRegion(a2c);
+  EXPECT_EQ(meta_cache->SnapshotVersion(), version + 1);
+
+  std::shared_ptr<Region> tmp;
+  EXPECT_TRUE(meta_cache->TEST_FastLookUpRegionByKey("b", tmp).IsOK());
+  EXPECT_EQ(tmp->RegionId(), a2c->RegionId());
+
+  // a batch is published once
+  meta_cache->MaybeAddRegions({RegionC2E(), RegionE2G()});
+  EXPECT_EQ(meta_cache->SnapshotVersion(), version + 2);
+  EXPECT_TRUE(meta_cache->TEST_FastLookUpRegionByKey("d", tmp).IsOK());
+  EXPECT_EQ(tmp->GetRange().start_key, "c");
+  EXPECT_TRUE(meta_cache->TEST_FastLookUpRegionByKey("f", tmp).IsOK());
+  EXPECT_EQ(tmp->GetRange().start_key, "e");
+
+  meta_cache->ClearRegion(a2c);
+  EXPECT_EQ(meta_cache->SnapshotVersion(), version + 3);
+  EXPECT_TRUE(meta_cache->TEST_FastLookUpRegionByKey("b", tmp).IsNotFound());
+}
+
+TEST_F(SDKMetaCacheTest, SnapshotConcurrentLookup) {
+  meta_cache->MaybeAddRegion(RegionA2C());
+
+  std::atomic<bool> stop{false};
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 4; i++) {
+    readers.emplace_back([&] {
+      while (!stop.load()) {
+        std::shared_ptr<Region> tmp;
+        EXPECT_TRUE(meta_cache->TEST_FastLookUpRegionByKey("b", tmp).IsOK());
+      }
+    });
+  }
+
+  for (int i = 0; i < 1000; i++) {
+    meta_cache->MaybeAddRegions({RegionC2E(), RegionE2G()});
+    meta_cache->RemoveRegion(RegionC2E()->RegionId());
+  }
+
+  stop.store(true);
+  for (auto& reader : readers) {
+    reader.join();
+  }
+}
+
+TEST_F(SDKMetaCacheTest, SnapshotIncrementalPublish) {
+  auto key = [](int i) {
+    char buf[16];
+    snprintf(buf, sizeof(buf), "k%06d", i);
+    return std::string(buf);
+  };
+  auto gen_region = [&](int i) {
+    pb::common::Range range;
+    range.set_start_key(key(i));
+    range.set_end_key(key(i + 1));
+    pb::common::RegionEpoch epoch;
+    epoch.set_version(1);
+    epoch.set_conf_version(1);
+    return GenRegion(1000 + i, range, epoch, pb::common::RegionType::STORE_REGION);
+  };
+
+  // span many snapshot chunks, insert one by one in reverse order so every publish touch the first chunk
+  const int region_count = RegionSnapshot::kChunkSize * 4 + 3;
+  for (int i = region_count - 1; i >= 0; --i) {
+    meta_cache->MaybeAddRegion(gen_region(i));
+  }
+
+  // remove every third region
+  for (int i = 0; i < region_count; i += 3) {
+    meta_cache->RemoveRegion(1000 + i);
+  }
+
+  for (int i = 0; i < region_count; ++i) {
+    std::shared_ptr<Region> tmp;
+    Status by_key = meta_cache->TEST_FastLookUpRegionByKey(key(i), tmp);
+    if (i % 3 == 0) {
+      EXPECT_TRUE(by_key.IsNotFound()) << key(i);
+      continue;
+    }
+    EXPECT_TRUE(by_key.IsOK()) << key(i);
+    EXPECT_EQ(tmp->RegionId(), 1000 + i);
+
+    Status by_id = meta_cache->LookupRegionByRegionId(1000 + i, tmp);
+    EXPECT_TRUE(by_id.IsOK());
+    EXPECT_EQ(tmp->GetRange().start_key, key(i));
+  }
+
+  std::vector<std::shared_ptr<Region>> regions;
+  Status got = meta_cache->ScanRegionsBetweenContinuousRange(key(1), key(3), regions);
+  EXPECT_TRUE(got.IsOK());
+  EXPECT_EQ(regions.size(), 2);
+}
+
+TEST_F(SDKMetaCacheTest, LoadRegionCacheFileCorruption) {
+  std::string path = ::testing::TempDir() + "sdk_meta_cache_test_region_cache_corruption";
+  FILE* file = fopen(path.c_str(), "w");
+  ASSERT_NE(file, nullptr);
+  fputs("not a region cache file", file);
+  fclose(file);
+
+  uint64_t version = meta_cache->SnapshotVersion();
+  Status got = meta_cache->LoadFromFile(path);
+  EXPECT_TRUE(got.IsCorruption());
+  EXPECT_EQ(meta_cache->SnapshotVersion(), version);
+
+  got = meta_cache->LoadFromFile(path + "_not_exist");
+  EXPECT_TRUE(got.IsIOError());
+
+  // region count in header is far more than the file can hold
+  auto other_cache = std::make_shared<MetaCache>(coordinator_rpc_controller);
+  other_cache->MaybeAddRegion(RegionA2C());
+  ASSERT_TRUE(other_cache->SaveToFile(path).IsOK());
+  file = fopen(path.c_str(), "r+b");
+  ASSERT_NE(file, nullptr);
+  uint64_t region_count = UINT64_MAX / 2;
+  fseek(file, 8, SEEK_SET);
+  fwrite(&region_count, sizeof(region_count), 1, file);
+  fclose(file);
+
+  got = meta_cache->LoadFromFile(path);
+  EXPECT_TRUE(got.IsCorruption());
+  EXPECT_EQ(meta_cache->SnapshotVersion(), version);
+
+  std::remove(path.c_str());
+}
+
+TEST_F(SDKMetaCacheTest, WarmupRangeInPages) {
+  int64_t origin_page_size = FLAGS_meta_cache_warmup_page_size;
+  FLAGS_meta_cache_warmup_page_size = 2;
+
+  auto a2c = RegionA2C();
+  auto c2e = RegionC2E();
+  auto e2g = RegionE2G();
+
+  EXPECT_CALL(*coordinator_rpc_controller, SyncCall)
+      .WillOnce([&](Rpc& rpc) {
+        auto* t_rpc = dynamic_cast<ScanRegionsRpc*>(&rpc);
+        EXPECT_EQ(t_rpc->Request()->key(), "a");
+        EXPECT_EQ(t_rpc->Request()->range_end(), "g");
+        EXPECT_EQ(t_rpc->Request()->limit(), 2);
+        Region2ScanRegionInfo(a2c, t_rpc->MutableResponse()->add_regions());
+        Region2ScanRegionInfo(c2e, t_rpc->MutableResponse()->add_regions());
+        return Status::OK();
+      })
+      .WillOnce([&](Rpc& rpc) {
+        auto* t_rpc = dynamic_cast<ScanRegionsRpc*>(&rpc);
+        EXPECT_EQ(t_rpc->Request()->key(), "e");
+        EXPECT_EQ(t_rpc->Request()->range_end(), "g");
+        Region2ScanRegionInfo(e2g, t_rpc->MutableResponse()->add_regions());
+        return Status::OK();
+      });
+
+  Status got = meta_cache->WarmupRange("a", "g");
+  EXPECT_TRUE(got.IsOK());
+
+  std::vector<std::shared_ptr<Region>> regions;
+  got = meta_cache->ScanRegionsBetweenContinuousRange("a", "g", regions);
+  EXPECT_TRUE(got.IsOK());
+  EXPECT_EQ(regions.size(), 3);
+
+  FLAGS_meta_cache_warmup_page_size = origin_page_size;
+}
+
+TEST_F(SDKMetaCacheTest, RefreshWarmupRanges) {
+  auto a2c = RegionA2C();
+  auto new_a2c = RegionA2C(2, 1);
+
+  EXPECT_CALL(*coordinator_rpc_controller, SyncCall)
+      .WillOnce([&](Rpc& rpc) {
+        auto* t_rpc = dynamic_cast<ScanRegionsRpc*>(&rpc);
+        Region2ScanRegionInfo(a2c, t_rpc->MutableResponse()->add_regions());
+        return Status::OK();
+      })
+      .WillOnce([&](Rpc& rpc) {
+        auto* t_rpc = dynamic_cast<ScanRegionsRpc*>(&rpc);
+        EXPECT_EQ(t_rpc->Request()->key(), "a");
+        EXPECT_EQ(t_rpc->Request()->range_end(), "c");
+        Region2ScanRegionInfo(new_a2c, t_rpc->MutableResponse()->add_regions());
+        return Status::OK();
+      });
+
+  Status got = meta_cache->WarmupRange("a", "c");
+  EXPECT_TRUE(got.IsOK());
+
+  got = meta_cache->RefreshWarmupRanges();
+  EXPECT_TRUE(got.IsOK());
+
+  std::shared_ptr<Region> tmp;
+  got = meta_cache->LookupRegionByKey("b", tmp);
+  EXPECT_TRUE(got.IsOK());
+  EXPECT_EQ(tmp->GetEpoch().version, 2);
+}
+
+TEST_F(SDKMetaCacheTest, PropagateLeaderHint) {
+  auto a2c = RegionA2C();
+  auto c2e = RegionC2E();
+  auto e2g = RegionE2G();
+  meta_cache->MaybeAddRegions({a2c, c2e, e2g});
+
+  meta_cache->PropagateLeaderHint(kAddrOne, kAddrTwo);
+
+  for (const auto& region : {a2c, c2e, e2g}) {
+    EndPoint leader;
+    EXPECT_TRUE(region->GetLeader(leader).IsOK());
+    EXPECT_EQ(leader, kAddrTwo);
+  }
+}
+
+TEST_F(SDKMetaCacheTest, MarkEndPointUnhealthy) {
+  auto a2c = RegionA2C();
+  auto c2e = RegionC2E();
+  meta_cache->MaybeAddRegions({a2c, c2e});
+
+  EXPECT_TRUE(meta_cache->IsEndPointHealthy(kAddrOne));
+  meta_cache->MarkEndPointUnhealthy(kAddrOne);
+  EXPECT_FALSE(meta_cache->IsEndPointHealthy(kAddrOne));
+
+  for (const auto& region : {a2c, c2e}) {
+    for (const auto& replica : region->Replicas()) {
+      EXPECT_EQ(replica.role, kFollower);
+    }
+  }
+
+  meta_cache->MarkEndPointHealthy(kAddrOne);
+  EXPECT_TRUE(meta_cache->IsEndPointHealthy(kAddrOne));
+}
+
+TEST_F(SDKMetaCacheTest, RecordEndPointFailure) {
+  int64_t threshold = FLAGS_store_unhealthy_failure_threshold;
+  FLAGS_store_unhealthy_failure_threshold = 3;
+  SCOPED_CLEANUP({ FLAGS_store_unhealthy_failure_threshold = threshold; });
+
+  auto a2c = RegionA2C();
+  meta_cache->MaybeAddRegions({a2c});
+
+  meta_cache->RecordEndPointFailure(kAddrOne);
+  meta_cache->RecordEndPointFailure(kAddrOne);
+  EXPECT_TRUE(meta_cache->IsEndPointHealthy(kAddrOne));
+
+  // success in between reset the count
+  meta_cache->MarkEndPointHealthy(kAddrOne);
+  meta_cache->RecordEndPointFailure(kAddrOne);
+  meta_cache->RecordEndPointFailure(kAddrOne);
+  EXPECT_TRUE(meta_cache->IsEndPointHealthy(kAddrOne));
+
+  meta_cache->RecordEndPointFailure(kAddrOne);
+  EXPECT_FALSE(meta_cache->IsEndPointHealthy(kAddrOne));
+  for (const auto& replica : a2c->Replicas()) {
+    EXPECT_EQ(replica.role, kFollower);
+  }
+}
+
 }  // namespace sdk
-}  // namespace dingodb
\ No newline at end of file
+}  // namespace dingodb
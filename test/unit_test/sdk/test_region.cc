@@ -95,5 +95,20 @@ TEST_F(SDKRegionTest, TestMark) {
   }
 }
 
+TEST_F(SDKRegionTest, TestPeekLeader) {
+  EXPECT_EQ(region->PeekLeader(), kAddrOne);
+
+  // no leader, peek does not rotate the replica GetLeader picks
+  region->MarkFollower(kAddrOne);
+  EndPoint peek = region->PeekLeader();
+  EXPECT_EQ(region->PeekLeader(), peek);
+
+  EndPoint leader;
+  Status got = region->GetLeader(leader);
+  EXPECT_TRUE(got.IsOK());
+  EXPECT_EQ(leader, peek);
+  EXPECT_NE(region->PeekLeader(), peek);
+}
+
 }  // namespace sdk
 }  // namespace dingodb
\ No newline at end of file
@@ -12,19 +12,34 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <chrono>
+#include <condition_variable>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
+#include "dingosdk/client.h"
 #include "dingosdk/status.h"
 #include "glog/logging.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "mock_store_rpc_controller.h"
 #include "proto/error.pb.h"
+#include "sdk/common/backoff.h"
 #include "sdk/common/common.h"
+#include "sdk/common/deadline.h"
+#include "sdk/common/param_config.h"
+#include "sdk/common/tracer.h"
 #include "sdk/region.h"
+#include "sdk/rpc/concurrency_limiter.h"
+#include "sdk/rpc/hedge_budget.h"
 #include "sdk/rpc/rpc.h"
+#include "sdk/rpc/rpc_metrics.h"
 #include "sdk/rpc/store_rpc.h"
 #include "sdk/rpc/store_rpc_controller.h"
+#include "sdk/utils/scoped_cleanup.h"
 #include "test_base.h"
 #include "test_common.h"
 
@@ -405,6 +420,720 @@ TEST_F(SDKStoreRpcControllerTest, OtherErrorCode) {
   EXPECT_FALSE(region->IsStale());
 }
 
+TEST_F(SDKStoreRpcControllerTest, HedgeReadHoldOwnConcurrencySlot) {
+  std::string origin_policy = FLAGS_store_read_policy;
+  FLAGS_store_read_policy = "nearest";
+  FLAGS_store_enable_hedge_read = true;
+  FLAGS_store_enable_concurrency_limit = true;
+  int64_t origin_min_delay_ms = FLAGS_store_hedge_min_delay_ms;
+  FLAGS_store_hedge_min_delay_ms = 1;
+  SCOPED_CLEANUP({
+    FLAGS_store_read_policy = origin_policy;
+    FLAGS_store_enable_hedge_read = false;
+    FLAGS_store_enable_concurrency_limit = false;
+    FLAGS_store_hedge_min_delay_ms = origin_min_delay_ms;
+  });
+
+  auto& stats = rpc_client->GetEndPointStats();
+  stats.Record(kAddrOne, 100, true);
+  stats.Record(kAddrTwo, 200, true);
+  stats.Record(kAddrThree, 300, true);
+
+  KvGetRpc rpc;
+  std::string key = "d";
+  rpc.MutableRequest()->set_key(key);
+  std::shared_ptr<Region> region;
+  Status got = meta_cache->LookupRegionByKey(key, region);
+  EXPECT_TRUE(got.IsOK());
+
+  StoreRpcController controller(*stub, rpc, region);
+  controller.SetReadOnly(true);
+
+  auto& limiter = rpc_client->GetConcurrencyLimiter();
+  std::function<void()> primary_cb;
+  EXPECT_CALL(*rpc_client, SendRpc).Times(2).WillRepeatedly([&](Rpc& rpc, std::function<void()> cb) {
+    auto* get_rpc = dynamic_cast<KvGetRpc*>(&rpc);
+    CHECK_NOTNULL(get_rpc);
+    if (rpc.GetEndPoint() == kAddrOne) {
+      EXPECT_EQ(limiter.GetStats(kAddrOne).inflight, 1);
+      primary_cb = cb;
+      return;
+    }
+
+    // each clone hold a slot of its own endpoint
+    EXPECT_EQ(limiter.GetStats(kAddrOne).inflight, 1);
+    EXPECT_EQ(limiter.GetStats(kAddrTwo).inflight, 1);
+    rpc.SetElapseTimeUs(1234);
+    get_rpc->MutableResponse()->set_value("hedge");
+    cb();
+  });
+
+  Status call = controller.Call();
+  EXPECT_TRUE(call.IsOK());
+  EXPECT_EQ(rpc.Response()->value(), "hedge");
+  // result and elapse time are both from the winner
+  EXPECT_EQ(rpc.GetElapseTimeUs(), 1234);
+
+  // slot of the hedge is released by its own callback, primary still hold one until done
+  EXPECT_EQ(limiter.GetStats(kAddrTwo).inflight, 0);
+  EXPECT_EQ(limiter.GetStats(kAddrOne).inflight, 1);
+
+  ASSERT_TRUE(primary_cb != nullptr);
+  primary_cb();
+  EXPECT_EQ(limiter.GetStats(kAddrOne).inflight, 0);
+}
+
+TEST_F(SDKStoreRpcControllerTest, ReadNearestReplica) {
+  std::string origin_policy = FLAGS_store_read_policy;
+  FLAGS_store_read_policy = "nearest";
+
+  auto& stats = rpc_client->GetEndPointStats();
+  stats.Record(kAddrOne, 50000, true);
+  stats.Record(kAddrTwo, 1000, true);
+  stats.Record(kAddrThree, 2000, true);
+
+  KvGetRpc rpc;
+  std::string key = "d";
+  rpc.MutableRequest()->set_key(key);
+  std::shared_ptr<Region> region;
+  Status got = meta_cache->LookupRegionByKey(key, region);
+  EXPECT_TRUE(got.IsOK());
+
+  StoreRpcController controller(*stub, rpc, region);
+  controller.SetReadOnly(true);
+
+  EXPECT_CALL(*rpc_client, SendRpc).WillOnce([&](Rpc& rpc, std::function<void()> cb) {
+    EXPECT_EQ(rpc.GetEndPoint(), kAddrTwo);
+    auto* get_rpc = dynamic_cast<KvGetRpc*>(&rpc);
+    CHECK_NOTNULL(get_rpc);
+    get_rpc->MutableResponse()->set_value("pong");
+    cb();
+  });
+
+  Status call = controller.Call();
+  EXPECT_TRUE(call.IsOK());
+  EXPECT_EQ(rpc.Response()->value(), "pong");
+
+  // replica read should not change leader
+  EndPoint leader;
+  EXPECT_TRUE(region->GetLeader(leader).IsOK());
+  EXPECT_EQ(leader, kAddrOne);
+
+  FLAGS_store_read_policy = origin_policy;
+}
+
+TEST_F(SDKStoreRpcControllerTest, ReadReplicaNotLeaderFallbackToLeader) {
+  std::string origin_policy = FLAGS_store_read_policy;
+  FLAGS_store_read_policy = "nearest";
+
+  auto& stats = rpc_client->GetEndPointStats();
+  stats.Record(kAddrOne, 50000, true);
+  stats.Record(kAddrTwo, 1000, true);
+  stats.Record(kAddrThree, 2000, true);
+
+  KvGetRpc rpc;
+  std::string key = "d";
+  rpc.MutableRequest()->set_key(key);
+  std::shared_ptr<Region> region;
+  Status got = meta_cache->LookupRegionByKey(key, region);
+  EXPECT_TRUE(got.IsOK());
+
+  MockStoreRpcController controller(*stub, rpc, region);
+  controller.SetReadOnly(true);
+
+  EXPECT_CALL(*rpc_client, SendRpc)
+      .WillOnce([&](Rpc& rpc, std::function<void()> cb) {
+        EXPECT_EQ(rpc.GetEndPoint(), kAddrTwo);
+        auto* kv_get_rpc = dynamic_cast<KvGetRpc*>(&rpc);
+        CHECK_NOTNULL(kv_get_rpc);
+        auto* response = kv_get_rpc->MutableResponse();
+        response->mutable_error()->set_errcode(pb::error::Errno::ERAFT_NOTLEADER);
+        *response->mutable_error()->mutable_leader_location() = EndPointToLocation(kAddrOne);
+        cb();
+      })
+      .WillOnce([&](Rpc& rpc, std::function<void()> cb) {
+        EXPECT_EQ(rpc.GetEndPoint(), kAddrOne);
+        auto* kv_get_rpc = dynamic_cast<KvGetRpc*>(&rpc);
+        CHECK_NOTNULL(kv_get_rpc);
+        kv_get_rpc->MutableResponse()->set_value("pong");
+        cb();
+      });
+
+  Status call = controller.Call();
+  EXPECT_TRUE(call.IsOK());
+  EXPECT_EQ(rpc.Response()->value(), "pong");
+
+  FLAGS_store_read_policy = origin_policy;
+}
+
+TEST_F(SDKStoreRpcControllerTest, ReadReplicaNotLeaderKeepSiblingLeader) {
+  std::string origin_policy = FLAGS_store_read_policy;
+  FLAGS_store_read_policy = "nearest";
+  SCOPED_CLEANUP({ FLAGS_store_read_policy = origin_policy; });
+
+  auto& stats = rpc_client->GetEndPointStats();
+  stats.Record(kAddrOne, 50000, true);
+  stats.Record(kAddrTwo, 1000, true);
+  stats.Record(kAddrThree, 2000, true);
+
+  // sibling region really led by the follower we are going to read from
+  std::shared_ptr<Region> sibling;
+  Status got = meta_cache->LookupRegionByKey("a", sibling);
+  EXPECT_TRUE(got.IsOK());
+  sibling->MarkLeader(kAddrTwo);
+  EXPECT_TRUE(sibling->IsLeader(kAddrTwo));
+
+  KvGetRpc rpc;
+  std::string key = "d";
+  rpc.MutableRequest()->set_key(key);
+  std::shared_ptr<Region> region;
+  got = meta_cache->LookupRegionByKey(key, region);
+  EXPECT_TRUE(got.IsOK());
+  EXPECT_NE(region->RegionId(), sibling->RegionId());
+
+  MockStoreRpcController controller(*stub, rpc, region);
+  controller.SetReadOnly(true);
+
+  EXPECT_CALL(*rpc_client, SendRpc)
+      .WillOnce([&](Rpc& rpc, std::function<void()> cb) {
+        EXPECT_EQ(rpc.GetEndPoint(), kAddrTwo);
+        auto* kv_get_rpc = dynamic_cast<KvGetRpc*>(&rpc);
+        CHECK_NOTNULL(kv_get_rpc);
+        auto* response = kv_get_rpc->MutableResponse();
+        response->mutable_error()->set_errcode(pb::error::Errno::ERAFT_NOTLEADER);
+        *response->mutable_error()->mutable_leader_location() = EndPointToLocation(kAddrOne);
+        cb();
+      })
+      .WillOnce([&](Rpc& rpc, std::function<void()> cb) {
+        EXPECT_EQ(rpc.GetEndPoint(), kAddrOne);
+        auto* kv_get_rpc = dynamic_cast<KvGetRpc*>(&rpc);
+        CHECK_NOTNULL(kv_get_rpc);
+        kv_get_rpc->MutableResponse()->set_value("pong");
+        cb();
+      });
+
+  Status call = controller.Call();
+  EXPECT_TRUE(call.IsOK());
+  EXPECT_EQ(rpc.Response()->value(), "pong");
+
+  // follower was never leader of region, its leadership elsewhere must not move
+  EXPECT_TRUE(sibling->IsLeader(kAddrTwo));
+}
+
+TEST_F(SDKStoreRpcControllerTest, EndPointStatsEwma) {
+  EndPointStats stats;
+  EXPECT_EQ(stats.GetLatencyUs(kAddrOne), 0);
+
+  stats.Record(kAddrOne, 800, true);
+  EXPECT_EQ(stats.GetLatencyUs(kAddrOne), 800);
+
+  stats.Record(kAddrOne, 1600, true);
+  EXPECT_EQ(stats.GetLatencyUs(kAddrOne), 900);
+
+  // failed rpc is penalized as a multiple of current latency, not as a full timeout
+  stats.Record(kAddrOne, 100, false);
+  EXPECT_EQ(stats.GetLatencyUs(kAddrOne), 900 + (900 * 4 - 900) / 8);
+
+  // endpoint without sample is preferred
+  EXPECT_EQ(stats.PickNearest({kAddrOne, kAddrTwo}), kAddrTwo);
+}
+
+TEST_F(SDKStoreRpcControllerTest, EndPointStatsPickNearestSpread) {
+  EndPointStats stats;
+  stats.Record(kAddrOne, 1000, true);
+  stats.Record(kAddrTwo, 1100, true);
+  stats.Record(kAddrThree, 5000, true);
+
+  // near equal replicas share the load, far one is never picked
+  std::map<EndPoint, int> picked;
+  for (int i = 0; i < 1000; i++) {
+    picked[stats.PickNearest({kAddrOne, kAddrTwo, kAddrThree})]++;
+  }
+  EXPECT_GT(picked[kAddrOne], 0);
+  EXPECT_GT(picked[kAddrTwo], 0);
+  EXPECT_EQ(picked[kAddrThree], 0);
+}
+
+TEST_F(SDKStoreRpcControllerTest, HedgeReadWhenReplicaSlow) {
+  std::string origin_policy = FLAGS_store_read_policy;
+  FLAGS_store_read_policy = "nearest";
+  FLAGS_store_enable_hedge_read = true;
+  int64_t origin_min_delay_ms = FLAGS_store_hedge_min_delay_ms;
+  FLAGS_store_hedge_min_delay_ms = 1;
+
+  auto& stats = rpc_client->GetEndPointStats();
+  stats.Record(kAddrOne, 100, true);
+  stats.Record(kAddrTwo, 200, true);
+  stats.Record(kAddrThree, 300, true);
+
+  KvGetRpc rpc;
+  std::string key = "d";
+  rpc.MutableRequest()->set_key(key);
+  std::shared_ptr<Region> region;
+  Status got = meta_cache->LookupRegionByKey(key, region);
+  EXPECT_TRUE(got.IsOK());
+
+  StoreRpcController controller(*stub, rpc, region);
+  controller.SetReadOnly(true);
+
+  // primary to nearest replica hang, hedge to next nearest replica answer
+  std::function<void()> primary_cb;
+  EXPECT_CALL(*rpc_client, SendRpc).Times(2).WillRepeatedly([&](Rpc& rpc, std::function<void()> cb) {
+    auto* get_rpc = dynamic_cast<KvGetRpc*>(&rpc);
+    CHECK_NOTNULL(get_rpc);
+    EXPECT_EQ(get_rpc->Request()->key(), key);
+    if (rpc.GetEndPoint() == kAddrOne) {
+      primary_cb = cb;
+      return;
+    }
+
+    EXPECT_EQ(rpc.GetEndPoint(), kAddrTwo);
+    get_rpc->MutableResponse()->set_value("hedge");
+    cb();
+  });
+
+  Status call = controller.Call();
+  EXPECT_TRUE(call.IsOK());
+  EXPECT_EQ(rpc.Response()->value(), "hedge");
+  EXPECT_EQ(rpc.GetEndPoint(), kAddrTwo);
+
+  // late primary is ignored
+  ASSERT_TRUE(primary_cb != nullptr);
+  primary_cb();
+
+  auto metrics = rpc_client->GetHedgeBudget().GetMetrics();
+  EXPECT_EQ(metrics.requests, 1);
+  EXPECT_EQ(metrics.hedged, 1);
+  EXPECT_EQ(metrics.hedge_won, 1);
+
+  FLAGS_store_read_policy = origin_policy;
+  FLAGS_store_enable_hedge_read = false;
+  FLAGS_store_hedge_min_delay_ms = origin_min_delay_ms;
+}
+
+TEST_F(SDKStoreRpcControllerTest, HedgeBudgetLimit) {
+  HedgeBudget budget;
+
+  // initial burst
+  for (int i = 0; i < HedgeBudget::kMaxTokens / HedgeBudget::kHedgeCost; i++) {
+    EXPECT_TRUE(budget.TryAcquire());
+  }
+  EXPECT_FALSE(budget.TryAcquire());
+
+  // 5% budget, one hedge per 20 requests
+  for (int i = 0; i < 19; i++) {
+    budget.OnRequest(5);
+  }
+  EXPECT_FALSE(budget.TryAcquire());
+  budget.OnRequest(5);
+  EXPECT_TRUE(budget.TryAcquire());
+
+  auto metrics = budget.GetMetrics();
+  EXPECT_EQ(metrics.requests, 20);
+  EXPECT_EQ(metrics.hedged, 11);
+  EXPECT_EQ(metrics.budget_exhausted, 2);
+}
+
+TEST_F(SDKStoreRpcControllerTest, BackoffFullJitter) {
+  EXPECT_EQ(FullJitterBackoffMs(0, 100, 3), 0);
+  EXPECT_EQ(FullJitterBackoffMs(10, 0, 3), 0);
+
+  for (int attempt = 0; attempt < 10; attempt++) {
+    int64_t ceiling = std::min(int64_t(1000), int64_t(10) << attempt);
+    for (int i = 0; i < 100; i++) {
+      int64_t delay = FullJitterBackoffMs(10, 1000, attempt);
+      EXPECT_GE(delay, 0);
+      EXPECT_LE(delay, ceiling);
+    }
+  }
+}
+
+TEST_F(SDKStoreRpcControllerTest, ConcurrencyLimiterAimd) {
+  int64_t origin_init = FLAGS_store_concurrency_limit_init;
+  int64_t origin_queue_size = FLAGS_store_concurrency_limit_queue_size;
+  FLAGS_store_concurrency_limit_init = 4;
+  FLAGS_store_concurrency_limit_queue_size = 1;
+
+  ConcurrencyLimiter limiter;
+  for (int i = 0; i < 4; i++) {
+    EXPECT_EQ(limiter.Acquire(kAddrOne, kNoDeadline, nullptr), ConcurrencyLimiter::kAdmitted);
+  }
+
+  bool admitted = false;
+  EXPECT_EQ(limiter.Acquire(kAddrOne, kNoDeadline, [&](const Status& status) { admitted = status.ok(); }),
+            ConcurrencyLimiter::kQueued);
+  EXPECT_EQ(limiter.Acquire(kAddrOne, kNoDeadline, nullptr), ConcurrencyLimiter::kRejected);
+
+  auto stats = limiter.GetStats(kAddrOne);
+  EXPECT_EQ(stats.limit, 4);
+  EXPECT_EQ(stats.inflight, 4);
+  EXPECT_EQ(stats.queue_depth, 1);
+
+  // overload halve the limit, queued rpc keep waiting
+  limiter.Release(kAddrOne, true, 0);
+  stats = limiter.GetStats(kAddrOne);
+  EXPECT_EQ(stats.limit, 2);
+  EXPECT_EQ(stats.inflight, 3);
+  EXPECT_FALSE(admitted);
+
+  // success grow limit about one per round trip: 2 -> 2.5 -> 2.9
+  limiter.Release(kAddrOne, false, 1000);
+  EXPECT_FALSE(admitted);
+  limiter.Release(kAddrOne, false, 1000);
+  EXPECT_TRUE(admitted);
+  stats = limiter.GetStats(kAddrOne);
+  EXPECT_EQ(stats.limit, 2);
+  EXPECT_EQ(stats.inflight, 2);
+  EXPECT_EQ(stats.queue_depth, 0);
+
+  // latency far above min latency hold the limit
+  limiter.Release(kAddrOne, false, 10000);
+  EXPECT_EQ(limiter.GetStats(kAddrOne).limit, 2);
+  limiter.Release(kAddrOne, false, 1000);
+  EXPECT_EQ(limiter.GetStats(kAddrOne).limit, 3);
+  EXPECT_EQ(limiter.GetStats(kAddrOne).inflight, 0);
+
+  FLAGS_store_concurrency_limit_init = origin_init;
+  FLAGS_store_concurrency_limit_queue_size = origin_queue_size;
+}
+
+TEST_F(SDKStoreRpcControllerTest, ConcurrencyLimiterDecreaseOncePerRoundTrip) {
+  int64_t origin_init = FLAGS_store_concurrency_limit_init;
+  FLAGS_store_concurrency_limit_init = 16;
+  SCOPED_CLEANUP({ FLAGS_store_concurrency_limit_init = origin_init; });
+
+  ConcurrencyLimiter limiter;
+  for (int i = 0; i < 9; i++) {
+    EXPECT_EQ(limiter.Acquire(kAddrOne, kNoDeadline, nullptr), ConcurrencyLimiter::kAdmitted);
+  }
+
+  // all in-flight rpc answered EREQUEST_FULL, they were sent before the decrease and count as one signal
+  for (int i = 0; i < 8; i++) {
+    limiter.Release(kAddrOne, true, 1000000);
+  }
+  EXPECT_EQ(limiter.GetStats(kAddrOne).limit, 8);
+
+  // rpc sent after the last decrease halve the limit again
+  std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  limiter.Release(kAddrOne, true, 1);
+  EXPECT_EQ(limiter.GetStats(kAddrOne).limit, 4);
+  EXPECT_EQ(limiter.GetStats(kAddrOne).inflight, 0);
+}
+
+TEST_F(SDKStoreRpcControllerTest, ConcurrencyLimiterExpireWaiter) {
+  int64_t origin_init = FLAGS_store_concurrency_limit_init;
+  FLAGS_store_concurrency_limit_init = 1;
+  SCOPED_CLEANUP({ FLAGS_store_concurrency_limit_init = origin_init; });
+
+  ConcurrencyLimiter limiter;
+  EXPECT_EQ(limiter.Acquire(kAddrOne, kNoDeadline, nullptr), ConcurrencyLimiter::kAdmitted);
+
+  Status expired_status;
+  bool live_admitted = false;
+  EXPECT_EQ(limiter.Acquire(kAddrOne, MonotonicMs() + 10, [&](const Status& status) { expired_status = status; }),
+            ConcurrencyLimiter::kQueued);
+  EXPECT_EQ(limiter.Acquire(kAddrOne, MonotonicMs() + 60000,
+                            [&](const Status& status) { live_admitted = status.ok(); }),
+            ConcurrencyLimiter::kQueued);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+  // expired waiter fail with TimedOut and take no slot, the live one get the freed slot
+  limiter.Release(kAddrOne, false, 1000);
+  EXPECT_TRUE(expired_status.IsTimedOut());
+  EXPECT_TRUE(live_admitted);
+
+  auto stats = limiter.GetStats(kAddrOne);
+  EXPECT_EQ(stats.inflight, 1);
+  EXPECT_EQ(stats.queue_depth, 0);
+}
+
+TEST_F(SDKStoreRpcControllerTest, ConcurrencyLimiterExpireWaiterByTimer) {
+  int64_t origin_init = FLAGS_store_concurrency_limit_init;
+  int64_t origin_max_queue_ms = FLAGS_store_concurrency_limit_max_queue_ms;
+  FLAGS_store_concurrency_limit_init = 1;
+  FLAGS_store_concurrency_limit_max_queue_ms = 50;
+  SCOPED_CLEANUP({
+    FLAGS_store_concurrency_limit_init = origin_init;
+    FLAGS_store_concurrency_limit_max_queue_ms = origin_max_queue_ms;
+  });
+
+  ConcurrencyLimiter limiter;
+  EXPECT_EQ(limiter.Acquire(kAddrOne, kNoDeadline, nullptr, actuator), ConcurrencyLimiter::kAdmitted);
+
+  // no acquire or release touch the endpoint, the timer fail the waiters
+  std::mutex mutex;
+  std::condition_variable cond;
+  Status deadline_status;
+  Status no_deadline_status;
+  int done = 0;
+  auto on_admit = [&](Status* out) {
+    return [&, out](const Status& status) {
+      std::unique_lock<std::mutex> lock(mutex);
+      *out = status;
+      done++;
+      cond.notify_all();
+    };
+  };
+
+  int64_t start_ms = MonotonicMs();
+  EXPECT_EQ(limiter.Acquire(kAddrOne, MonotonicMs() + 10, on_admit(&deadline_status), actuator),
+            ConcurrencyLimiter::kQueued);
+  // capped by store_concurrency_limit_max_queue_ms
+  EXPECT_EQ(limiter.Acquire(kAddrOne, kNoDeadline, on_admit(&no_deadline_status), actuator),
+            ConcurrencyLimiter::kQueued);
+
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    EXPECT_TRUE(cond.wait_for(lock, std::chrono::seconds(5), [&] { return done == 2; }));
+  }
+  EXPECT_GE(MonotonicMs() - start_ms, 50);
+  EXPECT_TRUE(deadline_status.IsTimedOut());
+  EXPECT_TRUE(no_deadline_status.IsTimedOut());
+
+  auto stats = limiter.GetStats(kAddrOne);
+  EXPECT_EQ(stats.inflight, 1);
+  EXPECT_EQ(stats.queue_depth, 0);
+}
+
+TEST_F(SDKStoreRpcControllerTest, ConcurrencyLimitRequestFull) {
+  FLAGS_store_enable_concurrency_limit = true;
+
+  KvGetRpc rpc;
+  std::string key = "d";
+  rpc.MutableRequest()->set_key(key);
+  std::shared_ptr<Region> region;
+  Status got = meta_cache->LookupRegionByKey(key, region);
+  EXPECT_TRUE(got.IsOK());
+
+  StoreRpcController controller(*stub, rpc, region);
+
+  EXPECT_CALL(*rpc_client, SendRpc)
+      .WillOnce([&](Rpc& rpc, std::function<void()> cb) {
+        auto* get_rpc = dynamic_cast<KvGetRpc*>(&rpc);
+        CHECK_NOTNULL(get_rpc);
+        auto* error = get_rpc->MutableResponse()->mutable_error();
+        error->set_errcode(pb::error::EREQUEST_FULL);
+        cb();
+      })
+      .WillOnce([&](Rpc& rpc, std::function<void()> cb) {
+        auto* get_rpc = dynamic_cast<KvGetRpc*>(&rpc);
+        CHECK_NOTNULL(get_rpc);
+        get_rpc->MutableResponse()->set_value("pong");
+        cb();
+      });
+
+  Status call = controller.Call();
+  EXPECT_TRUE(call.IsOK());
+
+  // request full halve the limit, every slot is released
+  auto stats = rpc_client->GetConcurrencyLimiter().GetStats(kAddrOne);
+  EXPECT_EQ(stats.limit, FLAGS_store_concurrency_limit_init / 2);
+  EXPECT_EQ(stats.inflight, 0);
+
+  FLAGS_store_enable_concurrency_limit = false;
+}
+
+TEST_F(SDKStoreRpcControllerTest, DeadlineClipTimeoutAndStopRetry) {
+  KvGetRpc rpc;
+  std::string key = "d";
+  rpc.MutableRequest()->set_key(key);
+  std::shared_ptr<Region> region;
+  Status got = meta_cache->LookupRegionByKey(key, region);
+  EXPECT_TRUE(got.IsOK());
+
+  ScopedDeadline deadline(150);
+  StoreRpcController controller(*stub, rpc, region);
+
+  int send_count = 0;
+  EXPECT_CALL(*rpc_client, SendRpc).WillRepeatedly([&](Rpc& rpc, std::function<void()> cb) {
+    send_count++;
+    EXPECT_GT(rpc.GetTimeoutMs(), 0);
+    EXPECT_LE(rpc.GetTimeoutMs(), 150);
+    rpc.SetStatus(Status::NetworkError("connect fail"));
+    cb();
+  });
+
+  int64_t start_ms = MonotonicMs();
+  Status call = controller.Call();
+  EXPECT_TRUE(call.IsTimedOut());
+  EXPECT_LT(send_count, FLAGS_store_rpc_max_retry + 1);
+  // never wait backoff past the deadline
+  EXPECT_LT(MonotonicMs() - start_ms, 150 + FLAGS_store_rpc_retry_delay_ms);
+}
+
+TEST_F(SDKStoreRpcControllerTest, DeadlineExpiredBeforeSend) {
+  KvGetRpc rpc;
+  std::string key = "d";
+  rpc.MutableRequest()->set_key(key);
+  std::shared_ptr<Region> region;
+  Status got = meta_cache->LookupRegionByKey(key, region);
+  EXPECT_TRUE(got.IsOK());
+
+  std::unique_ptr<StoreRpcController> controller;
+  {
+    ScopedDeadline deadline(0);
+    EXPECT_NE(GetCurrentDeadlineMs(), kNoDeadline);
+    controller = std::make_unique<StoreRpcController>(*stub, rpc, region);
+  }
+  EXPECT_EQ(GetCurrentDeadlineMs(), kNoDeadline);
+
+  EXPECT_CALL(*rpc_client, SendRpc).Times(0);
+
+  Status call = controller->Call();
+  EXPECT_TRUE(call.IsTimedOut());
+}
+
+TEST_F(SDKStoreRpcControllerTest, RpcMetricsRecordLatencyAndRetry) {
+  KvGetRpc rpc;
+  std::string key = "d";
+  rpc.MutableRequest()->set_key(key);
+  std::shared_ptr<Region> region;
+  Status got = meta_cache->LookupRegionByKey(key, region);
+  EXPECT_TRUE(got.IsOK());
+
+  StoreRpcController controller(*stub, rpc, region);
+
+  EXPECT_CALL(*rpc_client, SendRpc)
+      .WillOnce([&](Rpc& rpc, std::function<void()> cb) {
+        auto* get_rpc = dynamic_cast<KvGetRpc*>(&rpc);
+        CHECK_NOTNULL(get_rpc);
+        get_rpc->MutableResponse()->mutable_error()->set_errcode(pb::error::Errno::ERAFT_NOTLEADER);
+        cb();
+      })
+      .WillOnce([&](Rpc& rpc, std::function<void()> cb) {
+        auto* get_rpc = dynamic_cast<KvGetRpc*>(&rpc);
+        CHECK_NOTNULL(get_rpc);
+        get_rpc->MutableResponse()->set_value("pong");
+        cb();
+      });
+
+  Status call = controller.Call();
+  EXPECT_TRUE(call.IsOK());
+
+  ClientMetrics metrics;
+  stub->GetMetrics(metrics);
+  EXPECT_EQ(metrics.inflight_rpc, 0);
+  EXPECT_EQ(metrics.retry_counts["ERAFT_NOTLEADER"], 1);
+
+  int64_t rpc_count = 0;
+  for (const auto& rpc_metrics : metrics.rpcs) {
+    EXPECT_EQ(rpc_metrics.method, KvGetRpc::ConstMethod());
+    EXPECT_EQ(rpc_metrics.error_count, 0);
+    rpc_count += rpc_metrics.latency.count;
+  }
+  EXPECT_EQ(rpc_count, 2);
+  EXPECT_GE(metrics.meta_cache_hit, 1);
+}
+
+TEST_F(SDKStoreRpcControllerTest, RpcMetricsEntryPerInstance) {
+  const char* method = KvGetRpc::ConstMethod();
+  RpcMetrics first;
+  RpcMetrics second;
+
+  // same method and endpoint must not share entries across instances
+  for (int i = 0; i < 3; i++) {
+    first.OnRpcStart();
+    first.OnRpcDone(method, kAddrOne, 100, true);
+  }
+  second.OnRpcStart();
+  second.OnRpcDone(method, kAddrOne, 100, false);
+  second.OnRpcStart();
+  second.OnRpcDone(method, kAddrTwo, 100, true);
+
+  ClientMetrics metrics;
+  first.GetMetrics(metrics);
+  ASSERT_EQ(metrics.rpcs.size(), 1);
+  EXPECT_EQ(metrics.rpcs[0].latency.count, 3);
+  EXPECT_EQ(metrics.rpcs[0].error_count, 0);
+
+  second.GetMetrics(metrics);
+  ASSERT_EQ(metrics.rpcs.size(), 2);
+  for (const auto& rpc : metrics.rpcs) {
+    EXPECT_EQ(rpc.latency.count, 1);
+    EXPECT_EQ(rpc.error_count, rpc.end_point == kAddrOne.ToString() ? 1 : 0);
+  }
+}
+
+TEST_F(SDKStoreRpcControllerTest, RpcMetricsConcurrentRecord) {
+  const char* method = KvGetRpc::ConstMethod();
+  RpcMetrics metrics;
+
+  // threads race on creating and publishing the same entries
+  const int kCount = 1000;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([&]() {
+      for (int i = 0; i < kCount; i++) {
+        const auto& end_point = (i % 2 == 0) ? kAddrOne : kAddrTwo;
+        metrics.OnRpcStart();
+        metrics.OnRpcDone(method, end_point, 100, true);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  ClientMetrics client_metrics;
+  metrics.GetMetrics(client_metrics);
+  ASSERT_EQ(client_metrics.rpcs.size(), 2);
+  for (const auto& rpc : client_metrics.rpcs) {
+    EXPECT_EQ(rpc.latency.count, 4 * kCount / 2);
+  }
+  EXPECT_EQ(client_metrics.inflight_rpc, 0);
+}
+
+TEST_F(SDKStoreRpcControllerTest, TraceSlowCallExportSpans) {
+  KvGetRpc rpc;
+  std::string key = "d";
+  rpc.MutableRequest()->set_key(key);
+  std::shared_ptr<Region> region;
+  Status got = meta_cache->LookupRegionByKey(key, region);
+  EXPECT_TRUE(got.IsOK());
+
+  FLAGS_enable_trace = true;
+  FLAGS_trace_slow_threshold_ms = 0;
+  std::vector<TraceSpan> exported;
+  SetTraceSink([&](const std::vector<TraceSpan>& spans) { exported = spans; });
+
+  StoreRpcController controller(*stub, rpc, region);
+
+  EXPECT_CALL(*rpc_client, SendRpc).WillOnce([&](Rpc& rpc, std::function<void()> cb) {
+    auto* get_rpc = dynamic_cast<KvGetRpc*>(&rpc);
+    CHECK_NOTNULL(get_rpc);
+    get_rpc->MutableResponse()->set_value("pong");
+    cb();
+  });
+
+  Status call = controller.Call();
+  EXPECT_TRUE(call.IsOK());
+
+  // slow trace is exported by background thread
+  Tracer::GetInstance().Flush();
+  FLAGS_enable_trace = false;
+  FLAGS_trace_slow_threshold_ms = 100;
+  SetTraceSink(nullptr);
+
+  ASSERT_EQ(exported.size(), 2);
+  // spans are ordered by start time, root and attempt may start in the same microsecond
+  const TraceSpan& root = exported[0].parent_id == 0 ? exported[0] : exported[1];
+  const TraceSpan& attempt = exported[0].parent_id == 0 ? exported[1] : exported[0];
+  EXPECT_EQ(root.name, KvGetRpc::ConstMethod());
+  EXPECT_EQ(root.parent_id, 0);
+  EXPECT_EQ(root.region_id, region->RegionId());
+  EXPECT_TRUE(root.ok);
+
+  EXPECT_EQ(attempt.name, "rpc_attempt");
+  EXPECT_EQ(attempt.trace_id, root.trace_id);
+  EXPECT_EQ(attempt.parent_id, root.span_id);
+  EXPECT_EQ(attempt.log_id, static_cast<int64_t>(rpc.LogId()));
+  EXPECT_EQ(attempt.end_point, kAddrOne.ToString());
+
+  std::string json = TraceSpansToJson(exported);
+  EXPECT_NE(json.find("rpc_attempt"), std::string::npos);
+}
+
 }  // namespace sdk
 
 }  // namespace dingodb
@@ -15,9 +15,14 @@
 #include <gflags/gflags_declare.h>
 #include <unistd.h>
 
+#include <chrono>
 #include <cmath>
 #include <cstdint>
+#include <future>
 #include <memory>
+#include <mutex>
+#include <set>
+#include <vector>
 
 #include "dingosdk/client.h"
 #include "dingosdk/status.h"
@@ -535,6 +540,54 @@ TEST_F(SDKTxnImplTest, PrimaryKeyLockConflict) {
   }
 }
 
+TEST_F(SDKTxnImplTest, AsyncCommitMoreThanActuatorThreads) {
+  // every commit meet lock conflict once and retry on the actuator, blocking commits would starve those retries
+  const int txn_count = FLAGS_txn_actuator_thread_num * 2;
+
+  std::vector<std::shared_ptr<TxnImpl>> txns;
+  txns.reserve(txn_count);
+  for (int i = 0; i < txn_count; i++) {
+    auto txn = NewTransactionImpl(options);
+    txn->Put("key" + std::to_string(i), "value");
+    txns.push_back(txn);
+  }
+
+  auto mock_lock = PrepareLockInfo();
+
+  std::mutex mutex;
+  std::set<int64_t> conflicted_txns;
+  EXPECT_CALL(*rpc_client, SendRpc).WillRepeatedly([&](Rpc& rpc, std::function<void()> cb) {
+    auto* txn_rpc = dynamic_cast<TxnPrewriteRpc*>(&rpc);
+    if (txn_rpc != nullptr) {
+      bool first = false;
+      {
+        std::lock_guard<std::mutex> guard(mutex);
+        first = conflicted_txns.insert(txn_rpc->Request()->start_ts()).second;
+      }
+      if (first) {
+        *txn_rpc->MutableResponse()->add_txn_result()->mutable_locked() = mock_lock;
+      }
+    }
+
+    cb();
+  });
+
+  EXPECT_CALL(*txn_lock_resolver, ResolveLock).Times(testing::AnyNumber());
+
+  std::vector<std::promise<Status>> promises(txn_count);
+  for (int i = 0; i < txn_count; i++) {
+    txns[i]->AsyncPreWriteAndCommit([&promises, i](Status s) { promises[i].set_value(s); });
+  }
+
+  for (int i = 0; i < txn_count; i++) {
+    auto future = promises[i].get_future();
+    ASSERT_EQ(future.wait_for(std::chrono::seconds(10)), std::future_status::ready);
+    EXPECT_TRUE(future.get().ok());
+  }
+
+  EXPECT_EQ(conflicted_txns.size(), static_cast<size_t>(txn_count));
+}
+
 TEST_F(SDKTxnImplTest, PrimaryKeyLockConflictExceed) {
   auto txn = NewTransactionImpl(options);
 
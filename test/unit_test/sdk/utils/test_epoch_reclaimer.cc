@@ -0,0 +1,128 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "sdk/utils/epoch_reclaimer.h"
+
+namespace dingodb {
+namespace sdk {
+
+namespace {
+
+struct Counted {
+  explicit Counted(int64_t v, std::atomic<int64_t>& alive) : value(v), alive_count(alive) { alive_count++; }
+  ~Counted() {
+    value = -1;
+    alive_count--;
+  }
+
+  int64_t value;
+  std::atomic<int64_t>& alive_count;
+};
+
+}  // namespace
+
+TEST(SDKEpochReclaimerTest, ReclaimWithoutReader) {
+  std::atomic<int64_t> alive{0};
+  EpochReclaimer reclaimer;
+  reclaimer.Retire(new Counted(1, alive));
+  reclaimer.Retire(new Counted(2, alive));
+  EXPECT_EQ(reclaimer.RetiredCount(), 0);
+  EXPECT_EQ(alive.load(), 0);
+}
+
+TEST(SDKEpochReclaimerTest, KeepWhilePinned) {
+  std::atomic<int64_t> alive{0};
+  EpochReclaimer reclaimer;
+  {
+    EpochReclaimer::Guard guard;
+    {
+      // nested guard not unpin the outer one
+      EpochReclaimer::Guard nested;
+    }
+    reclaimer.Retire(new Counted(1, alive));
+    EXPECT_EQ(reclaimer.RetiredCount(), 1);
+    EXPECT_EQ(alive.load(), 1);
+  }
+
+  reclaimer.Reclaim();
+  EXPECT_EQ(reclaimer.RetiredCount(), 0);
+  EXPECT_EQ(alive.load(), 0);
+}
+
+TEST(SDKEpochReclaimerTest, PinnedByOtherThread) {
+  std::atomic<int64_t> alive{0};
+  EpochReclaimer reclaimer;
+  std::atomic<bool> pinned{false};
+  std::atomic<bool> release{false};
+  std::thread reader([&]() {
+    EpochReclaimer::Guard guard;
+    pinned = true;
+    while (!release) {
+      std::this_thread::yield();
+    }
+  });
+  while (!pinned) {
+    std::this_thread::yield();
+  }
+
+  reclaimer.Retire(new Counted(1, alive));
+  EXPECT_EQ(alive.load(), 1);
+
+  release = true;
+  reader.join();
+  reclaimer.Reclaim();
+  EXPECT_EQ(alive.load(), 0);
+}
+
+TEST(SDKEpochReclaimerTest, ConcurrentReadAndRetire) {
+  std::atomic<int64_t> alive{0};
+  {
+    EpochReclaimer reclaimer;
+    std::atomic<Counted*> current{new Counted(0, alive)};
+    std::atomic<bool> stop{false};
+
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 4; ++i) {
+      readers.emplace_back([&]() {
+        while (!stop) {
+          EpochReclaimer::Guard guard;
+          const Counted* obj = current.load(std::memory_order_seq_cst);
+          EXPECT_GE(obj->value, 0);
+        }
+      });
+    }
+
+    for (int64_t i = 1; i <= 10000; ++i) {
+      Counted* old = current.exchange(new Counted(i, alive), std::memory_order_seq_cst);
+      reclaimer.Retire(old);
+    }
+
+    stop = true;
+    for (auto& reader : readers) {
+      reader.join();
+    }
+    delete current.load();
+  }
+  EXPECT_EQ(alive.load(), 0);
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,60 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+#include "sdk/utils/latency_histogram.h"
+
+namespace dingodb {
+namespace sdk {
+
+TEST(SDKLatencyHistogramTest, BucketBound) {
+  for (int64_t value : {0, 1, 7, 8, 9, 15, 16, 17, 100, 1000, 123456, 99999999}) {
+    int index = LatencyHistogram::BucketIndex(value);
+    EXPECT_LT(index, LatencyHistogram::kBucketCount);
+    EXPECT_GE(LatencyHistogram::BucketUpperBound(index), value);
+    if (index > 0) {
+      EXPECT_LT(LatencyHistogram::BucketUpperBound(index - 1), value);
+    }
+  }
+
+  EXPECT_EQ(LatencyHistogram::BucketIndex(INT64_MAX), LatencyHistogram::kBucketCount - 1);
+}
+
+TEST(SDKLatencyHistogramTest, Percentile) {
+  LatencyHistogram histogram;
+  EXPECT_EQ(histogram.Snapshot().count, 0);
+
+  for (int64_t i = 1; i <= 1000; ++i) {
+    histogram.Record(i * 10);
+  }
+
+  auto metrics = histogram.Snapshot();
+  EXPECT_EQ(metrics.count, 1000);
+  EXPECT_EQ(metrics.avg_us, 5005);
+  EXPECT_EQ(metrics.max_us, 10000);
+
+  // relative error below 1/8
+  EXPECT_GE(metrics.p50_us, 5000);
+  EXPECT_LE(metrics.p50_us, 5000 * 9 / 8);
+  EXPECT_GE(metrics.p99_us, 9900);
+  EXPECT_LE(metrics.p99_us, 10000);
+  EXPECT_LE(metrics.p90_us, metrics.p99_us);
+  EXPECT_LE(metrics.p99_us, metrics.p999_us);
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,96 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+#include "sdk/common/param_config.h"
+#include "sdk/utils/scan_batch_sizer.h"
+#include "sdk/utils/scoped_cleanup.h"
+
+namespace dingodb {
+namespace sdk {
+
+TEST(SDKScanBatchSizerTest, GrowAtMostDoublePerBatch) {
+  int64_t origin = FLAGS_scan_batch_bytes;
+  SCOPED_CLEANUP({ FLAGS_scan_batch_bytes = origin; });
+  FLAGS_scan_batch_bytes = 1024 * 1024;
+
+  ScanBatchSizer sizer(100);
+  EXPECT_EQ(sizer.BatchSize(), 100);
+
+  // 100 bytes per kv, target is 10485
+  sizer.OnResponse(100, 100 * 100);
+  EXPECT_EQ(sizer.BatchSize(), 200);
+  sizer.OnResponse(200, 200 * 100);
+  EXPECT_EQ(sizer.BatchSize(), 400);
+
+  for (int i = 0; i < 10; ++i) {
+    sizer.OnResponse(sizer.BatchSize(), sizer.BatchSize() * 100);
+  }
+  EXPECT_EQ(sizer.BatchSize(), 1024 * 1024 / 100);
+}
+
+TEST(SDKScanBatchSizerTest, ShrinkAtOnce) {
+  int64_t origin = FLAGS_scan_batch_bytes;
+  SCOPED_CLEANUP({ FLAGS_scan_batch_bytes = origin; });
+  FLAGS_scan_batch_bytes = 1024 * 1024;
+
+  ScanBatchSizer sizer(1000);
+  // 64KB per kv, target is 16
+  sizer.OnResponse(10, 10 * 64 * 1024);
+  EXPECT_EQ(sizer.BatchSize(), 16);
+
+  // kv larger than budget still fetch one
+  sizer.OnResponse(1, 64 * 1024 * 1024);
+  EXPECT_EQ(sizer.BatchSize(), kMinScanBatchSize);
+}
+
+TEST(SDKScanBatchSizerTest, Bound) {
+  int64_t origin = FLAGS_scan_batch_bytes;
+  SCOPED_CLEANUP({ FLAGS_scan_batch_bytes = origin; });
+  FLAGS_scan_batch_bytes = 1024 * 1024 * 1024;
+
+  ScanBatchSizer sizer(kMaxAdaptiveScanBatchSize);
+  sizer.OnResponse(10, 10);
+  EXPECT_EQ(sizer.BatchSize(), kMaxAdaptiveScanBatchSize);
+
+  // empty response learn nothing
+  sizer.OnResponse(0, 0);
+  EXPECT_EQ(sizer.BatchSize(), kMaxAdaptiveScanBatchSize);
+}
+
+TEST(SDKScanBatchSizerTest, Fix) {
+  ScanBatchSizer sizer(100);
+  sizer.Fix(20);
+  sizer.OnResponse(20, 20);
+  EXPECT_EQ(sizer.BatchSize(), 20);
+
+  sizer.Fix(INT64_MAX);
+  EXPECT_EQ(sizer.BatchSize(), kMaxScanBatchSize);
+}
+
+TEST(SDKScanBatchSizerTest, Disable) {
+  int64_t origin = FLAGS_scan_batch_bytes;
+  SCOPED_CLEANUP({ FLAGS_scan_batch_bytes = origin; });
+  FLAGS_scan_batch_bytes = 0;
+
+  ScanBatchSizer sizer(1000);
+  sizer.OnResponse(1000, 1000);
+  EXPECT_EQ(sizer.BatchSize(), 1000);
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,178 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "dingosdk/status.h"
+#include "dingosdk/vector.h"
+#include "gtest/gtest.h"
+#include "sdk/vector/vector_search_auto_batcher.h"
+
+namespace dingodb {
+namespace sdk {
+
+namespace {
+
+struct SearchCall {
+  int64_t index_id;
+  int32_t topk;
+  std::vector<int64_t> target_ids;
+};
+
+std::vector<VectorWithId> MakeTargets(int64_t start_id, int count) {
+  std::vector<VectorWithId> targets;
+  for (int i = 0; i < count; i++) {
+    Vector vector(ValueType::kFloat, 2);
+    vector.float_values = {1.0, 2.0};
+    targets.emplace_back(start_id + i, std::move(vector));
+  }
+  return targets;
+}
+
+SearchParam MakeParam(int32_t topk) {
+  SearchParam param;
+  param.topk = topk;
+  return param;
+}
+
+}  // namespace
+
+class SDKVectorSearchAutoBatcherTest : public ::testing::Test {
+ public:
+  void SetUp() override {}
+
+  void TearDown() override {}
+
+  // echo every target back as its own result, drop the last one when drop_last is set
+  VectorSearchAutoBatcher::SearchFunc RecordSearchFunc(bool drop_last) {
+    return [this, drop_last](int64_t index_id, const SearchParam& search_param,
+                             const std::vector<VectorWithId>& target_vectors, std::vector<SearchResult>& out_result) {
+      SearchCall call{index_id, search_param.topk, {}};
+      for (const auto& target : target_vectors) {
+        call.target_ids.push_back(target.id);
+        out_result.emplace_back(target);
+      }
+      if (drop_last) {
+        out_result.pop_back();
+      }
+
+      std::lock_guard<std::mutex> guard(mutex);
+      calls.push_back(std::move(call));
+      return Status::OK();
+    };
+  }
+
+  std::mutex mutex;
+  std::vector<SearchCall> calls;
+};
+
+TEST_F(SDKVectorSearchAutoBatcherTest, GroupAndSplitResult) {
+  // large window, batch is sent when it is full
+  VectorSearchAutoBatcher batcher(RecordSearchFunc(false), 10 * 1000 * 1000, 4);
+
+  struct Caller {
+    int64_t index_id;
+    SearchParam param;
+    std::vector<VectorWithId> targets;
+    std::vector<SearchResult> result;
+    Status status;
+  };
+
+  std::vector<Caller> callers(4);
+  // caller 0 and 1 are merged, caller 2 has different param, caller 3 has different index
+  callers[0].index_id = 1;
+  callers[0].param = MakeParam(10);
+  callers[0].targets = MakeTargets(100, 2);
+  callers[1].index_id = 1;
+  callers[1].param = MakeParam(10);
+  callers[1].targets = MakeTargets(200, 1);
+  callers[2].index_id = 1;
+  callers[2].param = MakeParam(5);
+  callers[2].targets = MakeTargets(300, 1);
+  callers[3].index_id = 2;
+  callers[3].param = MakeParam(10);
+  callers[3].targets = MakeTargets(400, 3);
+
+  std::vector<std::thread> threads;
+  threads.reserve(callers.size());
+  for (auto& caller : callers) {
+    threads.emplace_back([&]() {
+      caller.status = batcher.Search(caller.index_id, caller.param, caller.targets, caller.result);
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(3, calls.size());
+  std::map<std::pair<int64_t, int32_t>, size_t> call_target_size;
+  for (const auto& call : calls) {
+    call_target_size[{call.index_id, call.topk}] = call.target_ids.size();
+  }
+  EXPECT_EQ(3, (call_target_size[{1, 10}]));
+  EXPECT_EQ(1, (call_target_size[{1, 5}]));
+  EXPECT_EQ(3, (call_target_size[{2, 10}]));
+
+  for (const auto& caller : callers) {
+    EXPECT_TRUE(caller.status.ok()) << caller.status.ToString();
+    ASSERT_EQ(caller.targets.size(), caller.result.size());
+    for (size_t i = 0; i < caller.targets.size(); i++) {
+      EXPECT_EQ(caller.targets[i].id, caller.result[i].id.id);
+    }
+  }
+}
+
+TEST_F(SDKVectorSearchAutoBatcherTest, ResultSizeMismatch) {
+  VectorSearchAutoBatcher batcher(RecordSearchFunc(true), 10 * 1000 * 1000, 2);
+
+  SearchParam param = MakeParam(10);
+  std::vector<std::vector<VectorWithId>> targets{MakeTargets(100, 2), MakeTargets(200, 2)};
+  std::vector<std::vector<SearchResult>> results(targets.size());
+  std::vector<Status> status(targets.size());
+
+  std::vector<std::thread> threads;
+  threads.reserve(targets.size());
+  for (int i = 0; i < targets.size(); i++) {
+    threads.emplace_back([&, i]() { status[i] = batcher.Search(1, param, targets[i], results[i]); });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(1, calls.size());
+  for (int i = 0; i < targets.size(); i++) {
+    EXPECT_TRUE(status[i].IsIncomplete()) << status[i].ToString();
+    EXPECT_TRUE(results[i].empty());
+  }
+}
+
+TEST_F(SDKVectorSearchAutoBatcherTest, EmptyTargets) {
+  VectorSearchAutoBatcher batcher(RecordSearchFunc(false), 10 * 1000 * 1000, 1);
+
+  std::vector<VectorWithId> targets;
+  std::vector<SearchResult> result;
+  Status s = batcher.Search(1, MakeParam(10), targets, result);
+  EXPECT_TRUE(s.IsInvalidArgument());
+  EXPECT_TRUE(calls.empty());
+}
+
+}  // namespace sdk
+}  // namespace dingodb